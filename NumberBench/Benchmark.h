@@ -0,0 +1,300 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+/**
+	A small benchmark harness for the Numbers library.
+
+	A benchmark is a function that performs the operation under test
+	a given number of times. The harness calibrates the number of
+	iterations so that one batch runs for at least a minimum time,
+	warms up, and then times a number of batches (repetitions). The
+	time per operation of every repetition is recorded, and the
+	minimum, median, mean, 99th percentile and maximum are reported.
+
+	Benchmark functions must pass every result they compute to
+	doNotOptimize(), so that the compiler cannot remove the work.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if defined(_WIN32)
+	#define NOMINMAX
+	#include <windows.h>
+	#include <intrin.h>
+#else
+	#include <time.h>
+#endif
+
+namespace luma
+{
+namespace numbers
+{
+namespace bench
+{
+
+/**
+	Prevents the compiler from optimising away the computation
+	of the given value.
+*/
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	const volatile char * p = reinterpret_cast<const volatile char *>(&value);
+	(void) *p;
+	_ReadWriteBarrier();
+#endif
+}
+
+/**
+	Prevents the compiler from assuming anything about memory
+	across this point.
+*/
+inline void clobberMemory()
+{
+#if defined(__GNUC__)
+	asm volatile("" : : : "memory");
+#else
+	_ReadWriteBarrier();
+#endif
+}
+
+/**
+	Monotonic clock with nanosecond resolution (where the
+	platform provides it).
+*/
+class Timer
+{
+public:
+	/**
+		Returns the current time in nanoseconds.
+	*/
+	static double now()
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER frequency;
+		LARGE_INTEGER counter;
+
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&counter);
+
+		return (double) counter.QuadPart * 1e9 / (double) frequency.QuadPart;
+#else
+		timespec time;
+
+		clock_gettime(CLOCK_MONOTONIC, &time);
+
+		return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+#endif
+	}
+};
+
+/**
+	The function type of benchmarks. The function must perform
+	the operation under test the given number of times.
+*/
+typedef void (*BenchmarkFunction)(unsigned int iterations);
+
+/**
+	A named benchmark.
+*/
+struct Benchmark
+{
+	const char * name;
+	BenchmarkFunction function;
+};
+
+/**
+	Settings for running benchmarks.
+*/
+struct Settings
+{
+	/** The number of timed batches per benchmark. */
+	unsigned int repetitions;
+
+	/** The number of untimed batches run before the timed ones. */
+	unsigned int warmupRepetitions;
+
+	/** The minimum duration of one batch, in nanoseconds. */
+	double minBatchTime;
+
+	/** If not 0, the fixed number of iterations per batch. */
+	unsigned int iterations;
+
+	Settings():
+		repetitions(31),
+		warmupRepetitions(3),
+		minBatchTime(1e6),
+		iterations(0)
+	{
+	}
+};
+
+/**
+	The timings of one benchmark, all in nanoseconds per operation.
+*/
+struct Result
+{
+	const char * name;
+	unsigned int iterations;
+	unsigned int repetitions;
+	double min;
+	double median;
+	double mean;
+	double p99;
+	double max;
+};
+
+/**
+	Times a single batch of the given number of iterations, and
+	returns the total time in nanoseconds.
+*/
+inline double timeBatch(BenchmarkFunction function, unsigned int iterations)
+{
+	clobberMemory();
+	double start = Timer::now();
+
+	function(iterations);
+
+	clobberMemory();
+	return Timer::now() - start;
+}
+
+/**
+	Returns the number of iterations for which a batch takes
+	at least the minimum batch time.
+*/
+inline unsigned int calibrate(BenchmarkFunction function, const Settings& settings)
+{
+	if(settings.iterations > 0)
+	{
+		return settings.iterations;
+	}
+
+	unsigned int iterations = 1;
+
+	while(iterations < (1u << 30))
+	{
+		double elapsed = timeBatch(function, iterations);
+
+		if(elapsed >= settings.minBatchTime)
+		{
+			break;
+		}
+
+		//grow towards the target, but at most 10 times per step
+		double factor = elapsed > 0 ? 1.2 * settings.minBatchTime / elapsed : 10.0;
+		factor = factor > 10.0 ? 10.0 : (factor < 2.0 ? 2.0 : factor);
+
+		double next = iterations * factor;
+		iterations = next > (1u << 30) ? (1u << 30) : (unsigned int) next;
+	}
+
+	return iterations;
+}
+
+/**
+	Runs the given benchmark, and returns its timings.
+*/
+inline Result run(const Benchmark& benchmark, const Settings& settings)
+{
+	unsigned int iterations = calibrate(benchmark.function, settings);
+
+	for(unsigned int i = 0; i < settings.warmupRepetitions; i++)
+	{
+		timeBatch(benchmark.function, iterations);
+	}
+
+	std::vector<double> samples(settings.repetitions);
+	double sum = 0;
+
+	for(unsigned int i = 0; i < settings.repetitions; i++)
+	{
+		samples[i] = timeBatch(benchmark.function, iterations) / iterations;
+		sum += samples[i];
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	unsigned int count = settings.repetitions;
+	unsigned int p99Rank = (99 * count + 99) / 100; //nearest rank, rounded up
+
+	Result result;
+
+	result.name = benchmark.name;
+	result.iterations = iterations;
+	result.repetitions = count;
+	result.min = samples[0];
+	result.median = count % 2 == 1 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+	result.mean = sum / count;
+	result.p99 = samples[p99Rank - 1];
+	result.max = samples[count - 1];
+
+	return result;
+}
+
+/**
+	The formats in which results can be written.
+*/
+enum Format
+{
+	FORMAT_TEXT,
+	FORMAT_CSV,
+	FORMAT_JSON
+};
+
+/**
+	Writes the given results in the given format.
+*/
+inline void write(FILE * file, const std::vector<Result>& results, Format format)
+{
+	if(format == FORMAT_CSV)
+	{
+		fprintf(file, "name,iterations,repetitions,min_ns,median_ns,mean_ns,p99_ns,max_ns\n");
+	}
+	else if(format == FORMAT_JSON)
+	{
+		fprintf(file, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+	}
+	else
+	{
+		fprintf(file, "%-44s %12s %10s %10s %10s %10s\n", "benchmark", "iterations", "min", "median", "p99", "max");
+	}
+
+	for(unsigned int i = 0; i < results.size(); i++)
+	{
+		const Result& r = results[i];
+
+		if(format == FORMAT_CSV)
+		{
+			fprintf(file, "%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+				r.name, r.iterations, r.repetitions, r.min, r.median, r.mean, r.p99, r.max);
+		}
+		else if(format == FORMAT_JSON)
+		{
+			fprintf(file, "    {\"name\": \"%s\", \"iterations\": %u, \"repetitions\": %u, "
+				"\"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"p99_ns\": %.3f, \"max_ns\": %.3f}%s\n",
+				r.name, r.iterations, r.repetitions, r.min, r.median, r.mean, r.p99, r.max,
+				i + 1 < results.size() ? "," : "");
+		}
+		else
+		{
+			fprintf(file, "%-44s %12u %10.2f %10.2f %10.2f %10.2f\n",
+				r.name, r.iterations, r.min, r.median, r.p99, r.max);
+		}
+	}
+
+	if(format == FORMAT_JSON)
+	{
+		fprintf(file, "  ]\n}\n");
+	}
+}
+
+}}} //namespace
+
+#endif //_BENCHMARK_H_
@@ -0,0 +1,1330 @@
+/**
+	Benchmarks for the classes in the Numbers library.
+
+	Usage:
+
+	@code
+	NumberBench [--format=text|csv|json] [--output=file] [--filter=text]
+		[--repetitions=n] [--warmup=n] [--iterations=n] [--min-time-ms=t] [--list]
+	@endcode
+
+	All timings are reported in nanoseconds per operation. Compare the
+	CSV or JSON output of two builds to catch performance regressions.
+
+	Objects under test are kept in function-local statics, so that
+	construction is not part of the timings (except for the benchmarks
+	that explicitly measure construction), and so that the objects
+	keep evolving across batches the way they do in a simulation.
+*/
+
+#include "Benchmark.h"
+
+#include "utils.h"
+#include "Clock.h"
+#include "Fixed.h"
+#include "ClampedNumber.h"
+#include "CyclicNumber.h"
+#include "PingPongNumber.h"
+#include "BasicRangedNumber.h"
+#include "NumberWrapper.h"
+#include "BufferedNumber.h"
+#include "BufferedBool.h"
+#include "BufferedBoolArray.h"
+#include "BufferedState.h"
+#include "LazyBufferedState.h"
+#include "TransitionBank.h"
+#include "BufferedStep.h"
+#include "FilteredNumber.h"
+#include "FilteredNumberBank.h"
+#include "KernelFilteredNumber.h"
+#include "ExponentialFilteredNumber.h"
+#include "WindowMinMaxNumber.h"
+#include "WindowMedianNumber.h"
+#include "DifferentiableNumber.h"
+#include "IntegrableNumber.h"
+#include "PIDBufferedNumber.h"
+#include "PIDControllerBank.h"
+#include "PublishedNumber.h"
+#include "ResponseCurve.h"
+#include "PeriodicResponseCurve.h"
+#include "XYResponseCurve.h"
+#include "FastSigmoid.h"
+#include "Snapshot.h"
+#include "UpdateScheduler.h"
+#include "NumberPool.h"
+
+#include <stdlib.h>
+
+using namespace luma::numbers;
+using namespace luma::numbers::bench;
+
+namespace
+{
+
+const unsigned int INPUT_COUNT = 1024;
+const unsigned int INPUT_MASK = INPUT_COUNT - 1;
+
+/**
+	Pseudo-random inputs in [-1, 1). These are not constant, so
+	the compiler cannot fold computations on them.
+*/
+float gInputs[INPUT_COUNT];
+
+/**
+	Pseudo-random elapsed times in [0.5, 1.5).
+*/
+float gElapsedTimes[INPUT_COUNT];
+
+void initInputs()
+{
+	srand(1);
+
+	for(unsigned int i = 0; i < INPUT_COUNT; i++)
+	{
+		gInputs[i] = (rand() % 2000) / 1000.0f - 1.0f;
+		gElapsedTimes[i] = 0.5f + (rand() % 1000) / 1000.0f;
+	}
+}
+
+inline float input(unsigned int i)
+{
+	return gInputs[i & INPUT_MASK];
+}
+
+inline float elapsedTime(unsigned int i)
+{
+	return gElapsedTimes[i & INPUT_MASK];
+}
+
+/**
+	Replays the inputs through process, in batches; timings are per
+	input. With Number = UpdateableNumber<float>, this measures the
+	fallback that calls setValue and getValue for every input with
+	virtual calls.
+*/
+template <class Number>
+void processInputs(Number& n, unsigned int iterations)
+{
+	static float outputs[INPUT_COUNT];
+
+	for(unsigned int i = 0; i < iterations; i += INPUT_COUNT)
+	{
+		unsigned int count = iterations - i < INPUT_COUNT ? iterations - i : INPUT_COUNT;
+
+		n.process(gInputs, gElapsedTimes, outputs, count);
+		doNotOptimize(outputs[0]);
+		clobberMemory();
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	utils
+//
+
+void benchModInt(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		int value = mod((int) (input(i) * 1000), -7, 13);
+		doNotOptimize(value);
+	}
+}
+
+void benchModFloat(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = mod(input(i) * 10.0f, -1.0f, 2.5f);
+		doNotOptimize(value);
+	}
+}
+
+void benchClamp(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = clamp(input(i), -0.5f, 0.5f);
+		doNotOptimize(value);
+	}
+}
+
+void benchReflect(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = reflect(input(i) * 10.0f, -1.0f, 2.5f);
+		doNotOptimize(value);
+	}
+}
+
+void benchLerp(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = lerp(input(i), -0.5f, 0.5f, 0.0f, 10.0f);
+		doNotOptimize(value);
+	}
+}
+
+void benchSigmoid(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = sigmoid(input(i), -0.5f, 0.5f, 0.0f, 10.0f);
+		doNotOptimize(value);
+	}
+}
+
+void benchFastSigmoid(unsigned int iterations)
+{
+	static FastSigmoid<float> f(-0.5f, 0.5f, 0.0f, 10.0f, 0.001f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = f(input(i));
+		doNotOptimize(value);
+	}
+}
+
+void benchFastSigmoidEvaluate(unsigned int iterations)
+{
+	static FastSigmoid<float> f(-0.5f, 0.5f, 0.0f, 10.0f, 0.001f);
+	static float outputs[INPUT_COUNT];
+
+	for(unsigned int i = 0; i < iterations; i += INPUT_COUNT)
+	{
+		unsigned int count = iterations - i < INPUT_COUNT ? iterations - i : INPUT_COUNT;
+
+		f.evaluate(gInputs, outputs, count);
+		doNotOptimize(outputs[0]);
+		clobberMemory();
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	Ranged numbers
+//
+
+void benchClampedNumberConstruct(unsigned int iterations)
+{
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		ClampedNumber<int> n((int) i, 0, 10, 1);
+		doNotOptimize(n);
+	}
+}
+
+void benchClampedNumberAssign(unsigned int iterations)
+{
+	static ClampedNumber<int> n(0, 0, 10, 1);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue((int) i);
+		doNotOptimize(n);
+	}
+}
+
+void benchClampedNumberInc(unsigned int iterations)
+{
+	static ClampedNumber<float> n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc(elapsedTime(i)) : n.dec(elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchClockedClampedNumberInc(unsigned int iterations)
+{
+	static ClampedNumber<float, ConstantClock<30> > n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc(elapsedTime(i)) : n.dec(elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+struct BenchTime {};
+
+void benchRuntimeClockedClampedNumberInc(unsigned int iterations)
+{
+	static ClampedNumber<float, RuntimeClock<BenchTime> > n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc(elapsedTime(i)) : n.dec(elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchFixedClampedNumberInc(unsigned int iterations)
+{
+	static ClampedNumber<Fixed16> n(Fixed16(0), Fixed16(-1), Fixed16(1), Fixed16(0.01f));
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc(elapsedTime(i)) : n.dec(elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchCyclicNumberInc(unsigned int iterations)
+{
+	static CyclicNumber<int> n(0, 0, 10, 1);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc() : n.dec();
+		doNotOptimize(n);
+	}
+}
+
+void benchPingPongNumberInc(unsigned int iterations)
+{
+	static PingPongNumber<int> n(0, 0, 10, 1);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc() : n.dec();
+		doNotOptimize(n);
+	}
+}
+
+void benchBasicClampedInc(unsigned int iterations)
+{
+	static BasicRangedNumber<float, ClampPolicy> n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc(elapsedTime(i)) : n.dec(elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchBasicCyclicInc(unsigned int iterations)
+{
+	static BasicRangedNumber<int, CyclicPolicy> n(0, 0, 10, 1);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc() : n.dec();
+		doNotOptimize(n);
+	}
+}
+
+void benchBasicReflectInc(unsigned int iterations)
+{
+	static BasicRangedNumber<int, ReflectPolicy> n(0, 0, 10, 1);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		input(i) > 0 ? n.inc() : n.dec();
+		int value = n;
+		doNotOptimize(value);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	Updateable numbers
+//
+
+void benchNumberWrapperSetValue(unsigned int iterations)
+{
+	static NumberWrapper<float> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchBufferedNumberSetValue(unsigned int iterations)
+{
+	static BufferedNumber<float> n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchFixedBufferedNumberSetValue(unsigned int iterations)
+{
+	static BufferedNumber<Fixed16> n(Fixed16(0), Fixed16(-1), Fixed16(1), Fixed16(0.01f));
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(Fixed16(input(i)), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchBufferedNumberBasicSetValue(unsigned int iterations)
+{
+	static BufferedNumber<float, BasicRangedNumber<float, ClampPolicy> > n(0.0f, -1.0f, 1.0f, 0.01f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchBufferedBoolSetValue(unsigned int iterations)
+{
+	static BufferedBool b(0.3f, 0.7f, 0.1f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		b.setValue(input(i) > 0, elapsedTime(i));
+		doNotOptimize(b);
+	}
+}
+
+/**
+	Updates 4096 flags per call; the time is per flag. The inputs
+	switch every eight updates, so that flags keep switching.
+*/
+template <class Level>
+void benchBufferedBoolArraySetValues(unsigned int iterations)
+{
+	const unsigned int flagCount = 4096;
+	const unsigned int wordCount = flagCount / 32;
+
+	static BufferedBoolArray<Level> flags(flagCount, 0.3f, 0.7f, 0.1f);
+	static unsigned int inputs[2][wordCount];
+
+	for(unsigned int word = 0; word < wordCount; word++)
+	{
+		unsigned int bits = 0;
+
+		for(unsigned int bit = 0; bit < 32; bit++)
+		{
+			bits |= (unsigned int) (input(word * 32 + bit) > 0) << bit;
+		}
+
+		inputs[0][word] = bits;
+		inputs[1][word] = ~bits;
+	}
+
+	for(unsigned int i = 0, tick = 0; i < iterations; i += flagCount, tick++)
+	{
+		flags.setValues(inputs[(tick >> 3) & 1], elapsedTime(tick));
+		doNotOptimize(flags.getValues()[0]);
+		clobberMemory();
+	}
+}
+
+/**
+	Updates 4096 BufferedBools per call and finds the ones that
+	switched, by comparing every output with the previous one; the
+	time is per number. The inputs switch every eight updates.
+*/
+void benchBufferedBoolPollTransitions(unsigned int iterations)
+{
+	const unsigned int count = 4096;
+
+	static std::vector<BufferedBool> numbers(count, BufferedBool(0.3f, 0.7f, 0.1f));
+	static std::vector<bool> previous(count, false);
+	static unsigned int switched = 0;
+
+	for(unsigned int i = 0, tick = 0; i < iterations; i += count, tick++)
+	{
+		bool flip = ((tick >> 3) & 1) != 0;
+
+		for(unsigned int j = 0; j < count; j++)
+		{
+			numbers[j].setValue((input(j) > 0) != flip, elapsedTime(tick));
+
+			if(numbers[j].getValue() != previous[j])
+			{
+				previous[j] = numbers[j].getValue();
+				switched++;
+			}
+		}
+
+		doNotOptimize(switched);
+	}
+}
+
+/**
+	Like benchBufferedBoolPollTransitions, but the BufferedBools are
+	updated by a TransitionBank, which reports those that switched.
+*/
+void benchTransitionBankSetValues(unsigned int iterations)
+{
+	const unsigned int count = 4096;
+
+	static TransitionBank<BufferedBool> bank(count, BufferedBool(0.3f, 0.7f, 0.1f));
+	static TransitionQueue<bool> transitions(count);
+	static bool inputs[2][count];
+	static unsigned int switched = 0;
+
+	for(unsigned int j = 0; j < count; j++)
+	{
+		inputs[0][j] = input(j) > 0;
+		inputs[1][j] = !inputs[0][j];
+	}
+
+	for(unsigned int i = 0, tick = 0; i < iterations; i += count, tick++)
+	{
+		transitions.clear();
+		bank.setValues(inputs[(tick >> 3) & 1], elapsedTime(tick), transitions);
+		switched += (unsigned int) transitions.getCount();
+		doNotOptimize(switched);
+	}
+}
+
+template <class State, unsigned int n>
+State makeBufferedState()
+{
+	float stateValues[n];
+	float thresholds[n];
+
+	for(unsigned int i = 0; i < n; i++)
+	{
+		stateValues[i] = i == 0 ? 1.0f : 0.0f;
+		thresholds[i] = 0.7f;
+	}
+
+	return State(0, stateValues, thresholds, 0.1f);
+}
+
+template <class State, unsigned int n>
+void benchBufferedStateSetValue(unsigned int iterations)
+{
+	static State state = makeBufferedState<State, n>();
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		state.setValue((unsigned int) ((input(i) + 1.0f) * n * 0.5f) % n, elapsedTime(i));
+		doNotOptimize(state);
+	}
+}
+
+void benchBufferedStepSetStateUp(unsigned int iterations)
+{
+	static float upwardsThresholds[] = {0.3f, 0.6f, 0.9f};
+	static float downwardsThresholds[] = {0.1f, 0.4f, 0.7f};
+	static BufferedStep<4> step(0.0f, 1.0f, upwardsThresholds, downwardsThresholds, 0.05f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		step.setStateUp(input(i) > 0);
+		doNotOptimize(step);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	Filters
+//
+
+template <unsigned int sampleCount>
+float * geometricWeights()
+{
+	static float weights[sampleCount];
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		weights[i] = i == 0 ? 1.0f : weights[i - 1] * 1.01f;
+	}
+
+	return weights;
+}
+
+template <unsigned int sampleCount>
+float * uniformWeights()
+{
+	static float weights[sampleCount];
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		weights[i] = 1.0f;
+	}
+
+	return weights;
+}
+
+template <unsigned int sampleCount>
+void benchFilteredNumberGeneral(unsigned int iterations)
+{
+	static FilteredNumber<float, sampleCount, 2> n(0.0f, geometricWeights<sampleCount>(), WEIGHTS_GENERAL);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+template <unsigned int sampleCount>
+void benchFilteredNumberUniform(unsigned int iterations)
+{
+	static FilteredNumber<float, sampleCount, 2> n(0.0f, uniformWeights<sampleCount>());
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+template <unsigned int sampleCount, class Kernel>
+void benchKernelFilteredNumber(unsigned int iterations)
+{
+	static KernelFilteredNumber<float, sampleCount, 2, Kernel> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchFilteredNumberProcess(unsigned int iterations)
+{
+	static FilteredNumber<float, 16, 2> n(0.0f, geometricWeights<16>(), WEIGHTS_GENERAL);
+
+	processInputs(n, iterations);
+}
+
+void benchFilteredNumberProcessVirtual(unsigned int iterations)
+{
+	static FilteredNumber<float, 16, 2> n(0.0f, geometricWeights<16>(), WEIGHTS_GENERAL);
+	static UpdateableNumber<float> * volatile number = &n;
+
+	processInputs(*number, iterations);
+}
+
+/**
+	One operation is one update of all 1024 filters in the bank.
+*/
+void benchFilteredNumberBank(unsigned int iterations)
+{
+	static FilteredNumberBank<float, 16, 2> bank(INPUT_COUNT, 0.0f, geometricWeights<16>());
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		bank.setValue(gInputs, elapsedTime(i));
+		doNotOptimize(bank.getValues(2)[i & INPUT_MASK]);
+	}
+}
+
+/**
+	Snapshots of a bank of 1024 filters; the buffer keeps its
+	capacity, so that only copying is measured.
+*/
+void benchFilteredNumberBankSerialize(unsigned int iterations)
+{
+	static FilteredNumberBank<float, 16, 2> bank(INPUT_COUNT, 0.0f, geometricWeights<16>());
+	static std::vector<unsigned char> snapshot;
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		snapshot.clear();
+
+		SnapshotWriter writer(snapshot);
+
+		bank.serialize(writer);
+		doNotOptimize(snapshot[i & INPUT_MASK]);
+	}
+}
+
+void benchFilteredNumberBankDeserialize(unsigned int iterations)
+{
+	static FilteredNumberBank<float, 16, 2> bank(INPUT_COUNT, 0.0f, geometricWeights<16>());
+	static std::vector<unsigned char> snapshot;
+
+	if(snapshot.empty())
+	{
+		SnapshotWriter writer(snapshot);
+
+		bank.serialize(writer);
+	}
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+
+		doNotOptimize(bank.deserialize(reader));
+		clobberMemory();
+	}
+}
+
+/**
+	With a fixed elapsed time, alpha is calculated once; with
+	varying elapsed times, every update calculates an exponential.
+*/
+template <bool varyingElapsedTime>
+void benchExponentialFilteredNumber(unsigned int iterations)
+{
+	static ExponentialFilteredNumber<float, 2> n(0.0f, ExponentialFilteredNumber<float, 2>::timeConstantFromSampleCount(16));
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), varyingElapsedTime ? elapsedTime(i) : TIME_UNIT);
+		doNotOptimize(n.getValue(2));
+	}
+}
+
+/**
+	The minimum and maximum of the last sampleCount inputs, found
+	by scanning a ring buffer; this is what WindowMinMaxNumber
+	replaces.
+*/
+template <unsigned int sampleCount>
+void benchWindowMinMaxScan(unsigned int iterations)
+{
+	static float samples[sampleCount];
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		samples[i % sampleCount] = input(i);
+
+		float minimum = samples[0];
+		float maximum = samples[0];
+
+		for(unsigned int j = 1; j < sampleCount; j++)
+		{
+			minimum = min(minimum, samples[j]);
+			maximum = max(maximum, samples[j]);
+		}
+
+		doNotOptimize(minimum);
+		doNotOptimize(maximum);
+	}
+}
+
+template <unsigned int sampleCount>
+void benchWindowMinMaxNumber(unsigned int iterations)
+{
+	static WindowMinMaxNumber<float, sampleCount> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i));
+		doNotOptimize(n.getMinimum());
+		doNotOptimize(n.getMaximum());
+	}
+}
+
+/**
+	The median of the last sampleCount inputs, found by copying a
+	ring buffer and selecting the middle sample with nth_element.
+*/
+template <unsigned int sampleCount>
+void benchWindowMedianSelect(unsigned int iterations)
+{
+	static float samples[sampleCount];
+	float sorted[sampleCount];
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		samples[i % sampleCount] = input(i);
+		memcpy(sorted, samples, sizeof(sorted));
+		std::nth_element(sorted, sorted + sampleCount / 2, sorted + sampleCount);
+		doNotOptimize(sorted[sampleCount / 2]);
+	}
+}
+
+template <unsigned int sampleCount>
+void benchWindowMedianNumber(unsigned int iterations)
+{
+	static WindowMedianNumber<float, sampleCount> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i));
+		doNotOptimize(n.getMedian());
+	}
+}
+
+void benchDifferentiableNumberSetValue(unsigned int iterations)
+{
+	static DifferentiableNumber<float, 3> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchIntegrableNumberSetValue(unsigned int iterations)
+{
+	static IntegrableNumber<float, 16, 3> n(0.0f);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	PID controller
+//
+
+PIDBufferedNumber<float, 2, 2, 16>& pidNumber()
+{
+	static float differentiableFactors[] = {0.1f, 0.01f};
+	static float integrableFactors[] = {0.2f, 0.02f};
+	static PIDBufferedNumber<float, 2, 2, 16> n(0.0f, 0.5f, differentiableFactors, integrableFactors);
+
+	return n;
+}
+
+void benchPIDBufferedNumberSetValue(unsigned int iterations)
+{
+	PIDBufferedNumber<float, 2, 2, 16>& n = pidNumber();
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchPIDBufferedNumberProcess(unsigned int iterations)
+{
+	processInputs(pidNumber(), iterations);
+}
+
+void benchPIDBufferedNumberProcessVirtual(unsigned int iterations)
+{
+	//hides the type, so that the calls cannot be devirtualised
+	static UpdateableNumber<float> * volatile number = &pidNumber();
+
+	processInputs(*number, iterations);
+}
+
+void benchPIDBufferedNumberGetValue(unsigned int iterations)
+{
+	PIDBufferedNumber<float, 2, 2, 16>& n = pidNumber();
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		clobberMemory();
+		float value = n.getValue();
+		doNotOptimize(value);
+	}
+}
+
+void benchPIDControllerBankSetValue(unsigned int iterations)
+{
+	static float differentiableFactors[] = {0.1f, 0.01f};
+	static float integrableFactors[] = {0.2f, 0.02f};
+	static PIDControllerBank<float, 2, 2, 16> bank(INPUT_COUNT, 0.0f, 0.5f, differentiableFactors, integrableFactors);
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		bank.setValue(gInputs, elapsedTime(i));
+		doNotOptimize(bank.getValues()[i & INPUT_MASK]);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	Publishing
+//
+
+PublishedNumber<FilteredNumber<float, 16, 2>, 2>& publishedNumber()
+{
+	static PublishedNumber<FilteredNumber<float, 16, 2>, 2> n(
+		FilteredNumber<float, 16, 2>(0.0f, geometricWeights<16>(), WEIGHTS_GENERAL));
+
+	return n;
+}
+
+void benchPublishedNumberSetValue(unsigned int iterations)
+{
+	PublishedNumber<FilteredNumber<float, 16, 2>, 2>& n = publishedNumber();
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.setValue(input(i), elapsedTime(i));
+		doNotOptimize(n);
+	}
+}
+
+void benchPublishedNumberGetValues(unsigned int iterations)
+{
+	PublishedNumber<FilteredNumber<float, 16, 2>, 2>& n = publishedNumber();
+	float values[3];
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		n.getValues(values);
+		doNotOptimize(values);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	UpdateScheduler
+//
+
+const unsigned int SCHEDULED_COUNT = 16384;
+
+/**
+	A tick of SCHEDULED_COUNT numbers of each of three types,
+	updated through their base class, in the order they were
+	created. This is what UpdateScheduler replaces.
+*/
+void benchVirtualUpdateLoop(unsigned int iterations)
+{
+	static std::vector<UpdateableNumber<float> *> numbers;
+
+	if(numbers.empty())
+	{
+		for(unsigned int i = 0; i < SCHEDULED_COUNT; i++)
+		{
+			numbers.push_back(new BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.1f));
+			numbers.push_back(new FilteredNumber<float, 4, 1>(0.0f, geometricWeights<4>()));
+			numbers.push_back(new DifferentiableNumber<float, 1>(0.0f));
+		}
+	}
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		for(size_t j = 0; j < numbers.size(); j++)
+		{
+			numbers[j]->setValue(input((unsigned int) j + i), elapsedTime(i));
+		}
+
+		doNotOptimize(numbers[i % numbers.size()]->getValue());
+	}
+}
+
+/**
+	The same numbers as benchVirtualUpdateLoop, updated by an
+	UpdateScheduler with the given number of threads.
+*/
+template <unsigned int threadCount>
+void benchUpdateScheduler(unsigned int iterations)
+{
+	static UpdateScheduler scheduler(threadCount);
+	UpdateArena<BufferedNumber<float> >& buffered = scheduler.getArena<BufferedNumber<float> >();
+	UpdateArena<FilteredNumber<float, 4, 1> >& filtered = scheduler.getArena<FilteredNumber<float, 4, 1> >();
+	UpdateArena<DifferentiableNumber<float, 1> >& differentiable = scheduler.getArena<DifferentiableNumber<float, 1> >();
+
+	if(scheduler.getCount() == 0)
+	{
+		for(unsigned int i = 0; i < SCHEDULED_COUNT; i++)
+		{
+			buffered.add(BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.1f));
+			filtered.add(FilteredNumber<float, 4, 1>(0.0f, geometricWeights<4>()));
+			differentiable.add(DifferentiableNumber<float, 1>(0.0f));
+
+			buffered.setInput(i, input(i * 3));
+			filtered.setInput(i, input(i * 3 + 1));
+			differentiable.setInput(i, input(i * 3 + 2));
+		}
+	}
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		scheduler.tick(elapsedTime(i));
+		doNotOptimize(buffered.getValue(i % SCHEDULED_COUNT));
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	NumberPool
+//
+
+const unsigned int POOLED_COUNT = 16384;
+
+typedef FilteredNumber<float, 4, 1> PooledNumber;
+
+/**
+	POOLED_COUNT numbers allocated one by one with new, between
+	allocations of other sizes, as they end up in a long running
+	program. Every operation updates all numbers.
+*/
+void benchHeapNumbersUpdate(unsigned int iterations)
+{
+	static std::vector<PooledNumber *> numbers;
+
+	if(numbers.empty())
+	{
+		std::vector<char *> clutter;
+
+		for(unsigned int i = 0; i < POOLED_COUNT; i++)
+		{
+			clutter.push_back(new char[16 + (i * 37) % 200]);
+			numbers.push_back(new PooledNumber(0.0f, geometricWeights<4>()));
+		}
+
+		//free the clutter, leaving the numbers scattered
+		for(size_t i = 0; i < clutter.size(); i++)
+		{
+			delete[] clutter[i];
+		}
+
+		//visit them in an order unrelated to their addresses
+		for(size_t i = numbers.size() - 1; i > 0; i--)
+		{
+			std::swap(numbers[i], numbers[(i * 7919) % (i + 1)]);
+		}
+	}
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		for(size_t j = 0; j < numbers.size(); j++)
+		{
+			numbers[j]->PooledNumber::setValue(input((unsigned int) j + i), TIME_UNIT);
+		}
+
+		doNotOptimize(numbers[i % numbers.size()]->getValue());
+	}
+}
+
+NumberPool<PooledNumber>& numberPool()
+{
+	static NumberPool<PooledNumber> pool;
+
+	if(pool.getCount() == 0)
+	{
+		for(unsigned int i = 0; i < POOLED_COUNT; i++)
+		{
+			pool.create(PooledNumber(0.0f, geometricWeights<4>()));
+		}
+	}
+
+	return pool;
+}
+
+void benchNumberPoolUpdate(unsigned int iterations)
+{
+	NumberPool<PooledNumber>& pool = numberPool();
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		unsigned int j = 0;
+
+		for(NumberPool<PooledNumber>::Iterator number = pool.begin(); number != pool.end(); ++number)
+		{
+			number->PooledNumber::setValue(input(j++ + i), TIME_UNIT);
+		}
+
+		doNotOptimize(j);
+	}
+}
+
+/**
+	Destroys a number and creates another one.
+*/
+void benchNumberPoolChurn(unsigned int iterations)
+{
+	NumberPool<PooledNumber>& pool = numberPool();
+	static std::vector<NumberHandle> handles;
+
+	if(handles.empty())
+	{
+		for(NumberPool<PooledNumber>::Iterator number = pool.begin(); number != pool.end(); ++number)
+		{
+			handles.push_back(number.getHandle());
+		}
+	}
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		NumberHandle& handle = handles[(i * 7919) % handles.size()];
+
+		pool.destroy(handle);
+		handle = pool.create(PooledNumber(input(i), geometricWeights<4>()));
+		doNotOptimize(handle);
+	}
+}
+
+//---------------------------------------------------------------------------------------
+//	Response curves
+//
+
+template <unsigned int n>
+float * curveSamples()
+{
+	static float samples[n];
+
+	for(unsigned int i = 0; i < n; i++)
+	{
+		samples[i] = (float) (i * i) / (n * n);
+	}
+
+	return samples;
+}
+
+void benchResponseCurve(unsigned int iterations)
+{
+	static ResponseCurve<float, 16> curve(-1.0f, 1.0f, curveSamples<16>());
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = curve(input(i));
+		doNotOptimize(value);
+	}
+}
+
+/**
+	Evaluates the inputs in batches; timings are per input.
+*/
+void benchResponseCurveEvaluate(unsigned int iterations)
+{
+	static ResponseCurve<float, 16> curve(-1.0f, 1.0f, curveSamples<16>());
+	static float outputs[INPUT_COUNT];
+
+	for(unsigned int i = 0; i < iterations; i += INPUT_COUNT)
+	{
+		unsigned int count = iterations - i < INPUT_COUNT ? iterations - i : INPUT_COUNT;
+
+		curve.evaluate(gInputs, outputs, count);
+		doNotOptimize(outputs[0]);
+		clobberMemory();
+	}
+}
+
+void benchPeriodicResponseCurve(unsigned int iterations)
+{
+	static PeriodicResponseCurve<float, 16> curve(-0.5f, 0.5f, curveSamples<16>());
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = curve(input(i));
+		doNotOptimize(value);
+	}
+}
+
+/**
+	Unevenly spaced input samples in [-1, 1].
+*/
+template <unsigned int n>
+float * unevenInputSamples()
+{
+	static float samples[n];
+
+	for(unsigned int i = 0; i < n; i++)
+	{
+		float x = (float) i / (n - 1);
+		samples[i] = 2.0f * x * x * x - 1.0f;
+	}
+
+	return samples;
+}
+
+template <unsigned int n>
+void benchXYResponseCurve(unsigned int iterations)
+{
+	static XYResponseCurve<float, n> curve(unevenInputSamples<n>(), curveSamples<n>());
+
+	for(unsigned int i = 0; i < iterations; i++)
+	{
+		float value = curve(input(i));
+		doNotOptimize(value);
+	}
+}
+
+const Benchmark gBenchmarks[] =
+{
+	{"utils/mod/int", benchModInt},
+	{"utils/mod/float", benchModFloat},
+	{"utils/clamp", benchClamp},
+	{"utils/reflect", benchReflect},
+	{"utils/lerp", benchLerp},
+	{"utils/sigmoid", benchSigmoid},
+	{"FastSigmoid", benchFastSigmoid},
+	{"FastSigmoid/evaluate", benchFastSigmoidEvaluate},
+
+	{"ClampedNumber/construct", benchClampedNumberConstruct},
+	{"ClampedNumber/assign", benchClampedNumberAssign},
+	{"ClampedNumber/inc", benchClampedNumberInc},
+	{"ClampedNumber/clock/inc", benchClockedClampedNumberInc},
+	{"ClampedNumber/runtimeclock/inc", benchRuntimeClockedClampedNumberInc},
+	{"ClampedNumber/fixed/inc", benchFixedClampedNumberInc},
+	{"CyclicNumber/inc", benchCyclicNumberInc},
+	{"PingPongNumber/inc", benchPingPongNumberInc},
+	{"BasicRangedNumber/clamp/inc", benchBasicClampedInc},
+	{"BasicRangedNumber/cyclic/inc", benchBasicCyclicInc},
+	{"BasicRangedNumber/reflect/inc", benchBasicReflectInc},
+
+	{"NumberWrapper/setValue", benchNumberWrapperSetValue},
+	{"BufferedNumber/setValue", benchBufferedNumberSetValue},
+	{"BufferedNumber/fixed/setValue", benchFixedBufferedNumberSetValue},
+	{"BufferedNumber/basic/setValue", benchBufferedNumberBasicSetValue},
+	{"BufferedBool/setValue", benchBufferedBoolSetValue},
+	{"BufferedBoolArray/float/setValues", benchBufferedBoolArraySetValues<float>},
+	{"BufferedBoolArray/uint16/setValues", benchBufferedBoolArraySetValues<unsigned short>},
+	{"BufferedBool/pollTransitions", benchBufferedBoolPollTransitions},
+	{"TransitionBank/BufferedBool/setValues", benchTransitionBankSetValues},
+	{"BufferedState/8/setValue", benchBufferedStateSetValue<BufferedState<8>, 8>},
+	{"BufferedState/64/setValue", benchBufferedStateSetValue<BufferedState<64>, 64>},
+	{"LazyBufferedState/8/setValue", benchBufferedStateSetValue<LazyBufferedState<8>, 8>},
+	{"LazyBufferedState/64/setValue", benchBufferedStateSetValue<LazyBufferedState<64>, 64>},
+	{"BufferedStep/4/setStateUp", benchBufferedStepSetStateUp},
+
+	{"FilteredNumber/16x2/general/setValue", benchFilteredNumberGeneral<16>},
+	{"FilteredNumber/256x2/general/setValue", benchFilteredNumberGeneral<256>},
+	{"FilteredNumber/256x2/uniform/setValue", benchFilteredNumberUniform<256>},
+	{"FilteredNumber/16x2/general/process", benchFilteredNumberProcess},
+	{"FilteredNumber/16x2/general/process/virtual", benchFilteredNumberProcessVirtual},
+	{"KernelFilteredNumber/16x2/gaussian/setValue", benchKernelFilteredNumber<16, GaussianKernel<4> >},
+	{"KernelFilteredNumber/256x2/gaussian/setValue", benchKernelFilteredNumber<256, GaussianKernel<64> >},
+	{"KernelFilteredNumber/256x2/box/setValue", benchKernelFilteredNumber<256, BoxKernel>},
+	{"ExponentialFilteredNumber/2/setValue", benchExponentialFilteredNumber<false>},
+	{"ExponentialFilteredNumber/2/setValue/varying time", benchExponentialFilteredNumber<true>},
+	{"WindowMinMax/64/scan", benchWindowMinMaxScan<64>},
+	{"WindowMinMaxNumber/64/setValue", benchWindowMinMaxNumber<64>},
+	{"WindowMedian/15/nth_element", benchWindowMedianSelect<15>},
+	{"WindowMedianNumber/15/setValue", benchWindowMedianNumber<15>},
+	{"WindowMedian/255/nth_element", benchWindowMedianSelect<255>},
+	{"WindowMedianNumber/255/setValue", benchWindowMedianNumber<255>},
+	{"FilteredNumberBank/16x2/1024/setValue", benchFilteredNumberBank},
+	{"FilteredNumberBank/16x2/1024/serialize", benchFilteredNumberBankSerialize},
+	{"FilteredNumberBank/16x2/1024/deserialize", benchFilteredNumberBankDeserialize},
+	{"DifferentiableNumber/3/setValue", benchDifferentiableNumberSetValue},
+	{"IntegrableNumber/16x3/setValue", benchIntegrableNumberSetValue},
+
+	{"PIDBufferedNumber/2-2-16/setValue", benchPIDBufferedNumberSetValue},
+	{"PIDBufferedNumber/2-2-16/getValue", benchPIDBufferedNumberGetValue},
+	{"PIDBufferedNumber/2-2-16/process", benchPIDBufferedNumberProcess},
+	{"PIDBufferedNumber/2-2-16/process/virtual", benchPIDBufferedNumberProcessVirtual},
+	{"PIDControllerBank/2-2-16/1024/setValue", benchPIDControllerBankSetValue},
+
+	{"PublishedNumber/16x2/setValue", benchPublishedNumberSetValue},
+	{"PublishedNumber/16x2/getValues", benchPublishedNumberGetValues},
+
+	{"UpdateScheduler/3x16384/virtual loop", benchVirtualUpdateLoop},
+	{"UpdateScheduler/3x16384/1 thread", benchUpdateScheduler<1>},
+	{"UpdateScheduler/3x16384/4 threads", benchUpdateScheduler<4>},
+
+	{"NumberPool/16384/heap/update", benchHeapNumbersUpdate},
+	{"NumberPool/16384/update", benchNumberPoolUpdate},
+	{"NumberPool/16384/churn", benchNumberPoolChurn},
+
+	{"ResponseCurve/16", benchResponseCurve},
+	{"ResponseCurve/16/evaluate", benchResponseCurveEvaluate},
+	{"PeriodicResponseCurve/16", benchPeriodicResponseCurve},
+	{"XYResponseCurve/16", benchXYResponseCurve<16>},
+	{"XYResponseCurve/512", benchXYResponseCurve<512>},
+};
+
+const unsigned int BENCHMARK_COUNT = sizeof(gBenchmarks) / sizeof(gBenchmarks[0]);
+
+/**
+	If the argument starts with the given option, returns
+	the text after it. Otherwise returns 0.
+*/
+const char * optionValue(const char * argument, const char * option)
+{
+	size_t length = strlen(option);
+
+	return strncmp(argument, option, length) == 0 ? argument + length : 0;
+}
+
+void printUsage()
+{
+	printf("Usage: NumberBench [--format=text|csv|json] [--output=file] [--filter=text]\n"
+		"                   [--repetitions=n] [--warmup=n] [--iterations=n]\n"
+		"                   [--min-time-ms=t] [--list]\n");
+}
+
+} //namespace
+
+int main(int argc, char * argv[])
+{
+	Settings settings;
+	Format format = FORMAT_TEXT;
+	const char * outputPath = 0;
+	const char * filter = 0;
+	bool list = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const char * value;
+
+		if((value = optionValue(argv[i], "--format=")) != 0)
+		{
+			if(strcmp(value, "csv") == 0)
+				format = FORMAT_CSV;
+			else if(strcmp(value, "json") == 0)
+				format = FORMAT_JSON;
+			else if(strcmp(value, "text") == 0)
+				format = FORMAT_TEXT;
+			else
+			{
+				printUsage();
+				return 1;
+			}
+		}
+		else if((value = optionValue(argv[i], "--output=")) != 0)
+			outputPath = value;
+		else if((value = optionValue(argv[i], "--filter=")) != 0)
+			filter = value;
+		else if((value = optionValue(argv[i], "--repetitions=")) != 0)
+			settings.repetitions = (unsigned int) atoi(value);
+		else if((value = optionValue(argv[i], "--warmup=")) != 0)
+			settings.warmupRepetitions = (unsigned int) atoi(value);
+		else if((value = optionValue(argv[i], "--iterations=")) != 0)
+			settings.iterations = (unsigned int) atoi(value);
+		else if((value = optionValue(argv[i], "--min-time-ms=")) != 0)
+			settings.minBatchTime = atof(value) * 1e6;
+		else if(strcmp(argv[i], "--list") == 0)
+			list = true;
+		else
+		{
+			printUsage();
+			return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	if(settings.repetitions == 0)
+	{
+		settings.repetitions = 1;
+	}
+
+	initInputs();
+
+	std::vector<Result> results;
+
+	for(unsigned int i = 0; i < BENCHMARK_COUNT; i++)
+	{
+		if(filter != 0 && strstr(gBenchmarks[i].name, filter) == 0)
+		{
+			continue;
+		}
+
+		if(list)
+		{
+			printf("%s\n", gBenchmarks[i].name);
+			continue;
+		}
+
+		fprintf(stderr, "%s\n", gBenchmarks[i].name);
+		results.push_back(run(gBenchmarks[i], settings));
+	}
+
+	if(list)
+	{
+		return 0;
+	}
+
+	FILE * file = outputPath != 0 ? fopen(outputPath, "w") : stdout;
+
+	if(file == 0)
+	{
+		fprintf(stderr, "Cannot open %s\n", outputPath);
+		return 1;
+	}
+
+	write(file, results, format);
+
+	if(file != stdout)
+	{
+		fclose(file);
+	}
+
+	return 0;
+}
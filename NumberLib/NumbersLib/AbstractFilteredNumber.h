@@ -2,6 +2,7 @@
 #define _ABSTRACT_FILTERED_NUMBER_H_
 
 #include "UpdateableNumber.h"
+#include "Snapshot.h"
 
 
 namespace luma
@@ -70,6 +71,16 @@ public:
 		The elapsed time is ignored.
 	*/
 	virtual void forceValue(T x, float elapsedTime = 1.0f);
+
+	/**
+		Writes the value to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <class T, unsigned int sampleCount>
@@ -108,6 +119,22 @@ T AbstractFilteredNumber<T, sampleCount, 0>::getValue(unsigned int order) const
 	return mInitialValue;
 }
 
+template <class T, unsigned int sampleCount>
+void AbstractFilteredNumber<T, sampleCount, 0>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mCurrentValue);
+	writer.write(mInitialValue);
+}
+
+template <class T, unsigned int sampleCount>
+bool AbstractFilteredNumber<T, sampleCount, 0>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mCurrentValue);
+	reader.read(mInitialValue);
+
+	return reader.isOk();
+}
+
 
 }} //namespace 
 
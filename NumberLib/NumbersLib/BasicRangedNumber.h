@@ -0,0 +1,414 @@
+#ifndef _BASIC_RANGED_NUMBER_H
+#define _BASIC_RANGED_NUMBER_H
+
+#include "Numbers.h"
+#include "utils.h"
+#include "Clock.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	Out of range policy for BasicRangedNumber that clamps the value
+	between min and max - increment, exactly like ClampedNumber.
+*/
+struct ClampPolicy
+{
+	/**
+		Returns the value stored for the given value.
+	*/
+	template <class T>
+	static T getValidValue(const T& value, const T& min, const T& max, const T& increment)
+	{
+		return clamp(value, min, max - increment);
+	}
+
+	/**
+		Returns the value presented for the given stored value.
+	*/
+	template <class T>
+	static T getPresentedValue(const T& value, const T& /*min*/, const T& /*max*/, const T& /*increment*/)
+	{
+		return value;
+	}
+
+	/**
+		The factor by which the elapsed time is multiplied
+		in inc() and dec().
+	*/
+	static float timeScale()
+	{
+		return DefaultClock::timeScale();
+	}
+};
+
+/**
+	ClampPolicy with the time scale of the given clock (see Clock.h),
+	for example BasicRangedNumber<float, ClockedClampPolicy<ConstantClock<30> > >.
+*/
+template <class Clock>
+struct ClockedClampPolicy : public ClampPolicy
+{
+	static float timeScale()
+	{
+		return Clock::timeScale();
+	}
+};
+
+/**
+	Out of range policy for BasicRangedNumber that wraps the value
+	around in the range [min, max), exactly like CyclicNumber.
+*/
+struct CyclicPolicy
+{
+	/**
+		Returns the value stored for the given value.
+	*/
+	template <class T>
+	static T getValidValue(const T& value, const T& min, const T& max, const T& /*increment*/)
+	{
+		return mod(value, min, max);
+	}
+
+	/**
+		Returns the value presented for the given stored value.
+	*/
+	template <class T>
+	static T getPresentedValue(const T& value, const T& /*min*/, const T& /*max*/, const T& /*increment*/)
+	{
+		return value;
+	}
+
+	/**
+		The factor by which the elapsed time is multiplied
+		in inc() and dec().
+	*/
+	static float timeScale()
+	{
+		return 1.0f;
+	}
+};
+
+/**
+	Out of range policy for BasicRangedNumber that reflects the value
+	between min and max - increment, exactly like PingPongNumber.
+
+	The stored value cycles through a range twice as long as
+	the number's range, so that it also encodes the direction of
+	movement. The presented value is the stored value folded back
+	into the number's range.
+*/
+struct ReflectPolicy
+{
+	/**
+		Returns the value stored for the given value.
+	*/
+	template <class T>
+	static T getValidValue(const T& value, const T& min, const T& max, const T& increment)
+	{
+		return mod(value, min, max + max - min - increment - increment);
+	}
+
+	/**
+		Returns the value presented for the given stored value.
+	*/
+	template <class T>
+	static T getPresentedValue(const T& value, const T& /*min*/, const T& max, const T& increment)
+	{
+		return value >= max ? 2 * (max - increment) - value: value;
+	}
+
+	/**
+		The factor by which the elapsed time is multiplied
+		in inc() and dec().
+	*/
+	static float timeScale()
+	{
+		return 1.0f;
+	}
+};
+
+/**
+	A statically dispatched alternative to RangedNumber and its
+	subclasses.
+
+	The way out of range situations are handled is determined by the
+	OutOfRangePolicy template parameter (ClampPolicy, CyclicPolicy or
+	ReflectPolicy), rather than by virtual functions. Objects of this
+	class therefore carry no virtual table pointer (a
+	BasicRangedNumber<int, ClampPolicy> is the size of four ints),
+	and all calls can be inlined.
+
+	BasicRangedNumber<T, ClampPolicy>, BasicRangedNumber<T, CyclicPolicy>,
+	and BasicRangedNumber<T, ReflectPolicy> behave the same as
+	ClampedNumber<T>, CyclicNumber<T>, and PingPongNumber<T>, and can
+	be used wherever these are used as template arguments, for example:
+
+	@code
+	BufferedNumber<float, BasicRangedNumber<float, ClampPolicy> > speed(0.0f, -10.0f, 10.0f, 0.5f);
+	@endcode
+
+	BasicRangedNumbers cannot be used through a RangedNumber pointer or
+	reference; use the original classes if that is required.
+
+	@param T
+		The underlying number type.
+	@param OutOfRangePolicy
+		A class with static functions getValidValue, getPresentedValue
+		and timeScale, such as ClampPolicy.
+*/
+template <class T, class OutOfRangePolicy>
+class BasicRangedNumber
+{
+private:
+	/** The stored value; see OutOfRangePolicy::getPresentedValue.*/
+	T mValue;
+	T mMin;
+	T mMax;
+	T mIncrement;
+
+public:
+	/**
+		Constructs a new BasicRangedNumber. The value is
+		made valid according to the OutOfRangePolicy.
+	*/
+	BasicRangedNumber(T value, T min, T max, T increment);
+
+	BasicRangedNumber& operator=(const T& value);
+
+	/**
+		Sets the value of this number, and makes it valid
+		according to the OutOfRangePolicy.
+	*/
+	void setValue(const T& value);
+
+	/**
+		Returns the value of this number.
+	*/
+	T getValue() const;
+
+	/**
+		Returns the value of this number.
+	*/
+	operator T() const;
+
+	/**
+		Changes the range and increment of this number.
+	*/
+	void modify(const T& min, const T& max, const T& increment);
+
+	void setIncrement(const T& increment);
+
+	BasicRangedNumber& operator++();
+	BasicRangedNumber operator++(int);
+	BasicRangedNumber& operator--();
+	BasicRangedNumber operator--(int);
+
+	/**
+		Increments this number's value by the given amount.
+	*/
+	BasicRangedNumber& operator+=(const T& increment);
+
+	/**
+		Decrements this number's value by the given amount.
+	*/
+	BasicRangedNumber& operator-=(const T& decrement);
+
+	void inc(float elapsedTime = 1);
+	void dec(float elapsedTime = 1);
+
+	const T& min() const;
+	const T& max() const;
+	const T& increment() const;
+
+	T getValidValue(const T& value) const;
+
+	/**
+		Returns the factor by which inc() and dec() multiply the
+		elapsed time, as given by the OutOfRangePolicy.
+	*/
+	static float timeScale();
+
+	/**
+		Writes the value, range and increment of this number to the
+		snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>::BasicRangedNumber(T value, T min, T max, T increment):
+	mValue(OutOfRangePolicy::getValidValue(value, min, max, increment)),
+	mMin(min),
+	mMax(max),
+	mIncrement(increment)
+{
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>& BasicRangedNumber<T, OutOfRangePolicy>::operator=(const T& value)
+{
+	setValue(value);
+
+	return *this;
+}
+
+template <class T, class OutOfRangePolicy>
+inline void BasicRangedNumber<T, OutOfRangePolicy>::setValue(const T& value)
+{
+	mValue = getValidValue(value);
+}
+
+template <class T, class OutOfRangePolicy>
+inline T BasicRangedNumber<T, OutOfRangePolicy>::getValue() const
+{
+	return OutOfRangePolicy::getPresentedValue(mValue, mMin, mMax, mIncrement);
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>::operator T() const
+{
+	return getValue();
+}
+
+template <class T, class OutOfRangePolicy>
+inline void BasicRangedNumber<T, OutOfRangePolicy>::modify(const T& min, const T& max, const T& increment)
+{
+	T value = getValue();
+
+	mMin = min;
+	mMax = max;
+	mIncrement = increment;
+
+	mValue = getValidValue(value);
+}
+
+template <class T, class OutOfRangePolicy>
+inline void BasicRangedNumber<T, OutOfRangePolicy>::setIncrement(const T& increment)
+{
+	modify(mMin, mMax, increment);
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>& BasicRangedNumber<T, OutOfRangePolicy>::operator++()
+{
+	mValue = getValidValue(mValue + mIncrement);
+
+	return *this;
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy> BasicRangedNumber<T, OutOfRangePolicy>::operator++(int)
+{
+	BasicRangedNumber<T, OutOfRangePolicy> tmp = *this;
+	++*this;
+
+	return tmp;
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>& BasicRangedNumber<T, OutOfRangePolicy>::operator--()
+{
+	mValue = getValidValue(mValue - mIncrement);
+
+	return *this;
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy> BasicRangedNumber<T, OutOfRangePolicy>::operator--(int)
+{
+	BasicRangedNumber<T, OutOfRangePolicy> tmp = *this;
+	--*this;
+
+	return tmp;
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>& BasicRangedNumber<T, OutOfRangePolicy>::operator+=(const T& increment)
+{
+	mValue = getValidValue(mValue + increment);
+
+	return *this;
+}
+
+template <class T, class OutOfRangePolicy>
+inline BasicRangedNumber<T, OutOfRangePolicy>& BasicRangedNumber<T, OutOfRangePolicy>::operator-=(const T& decrement)
+{
+	mValue = getValidValue(mValue - decrement);
+
+	return *this;
+}
+
+template <class T, class OutOfRangePolicy>
+inline void BasicRangedNumber<T, OutOfRangePolicy>::inc(float elapsedTime)
+{
+	mValue = getValidValue(mValue + scaleByTime(mIncrement, elapsedTime, OutOfRangePolicy::timeScale()));
+}
+
+template <class T, class OutOfRangePolicy>
+inline void BasicRangedNumber<T, OutOfRangePolicy>::dec(float elapsedTime)
+{
+	mValue = getValidValue(mValue - scaleByTime(mIncrement, elapsedTime, OutOfRangePolicy::timeScale()));
+}
+
+template <class T, class OutOfRangePolicy>
+inline const T& BasicRangedNumber<T, OutOfRangePolicy>::min() const
+{
+	return mMin;
+}
+
+template <class T, class OutOfRangePolicy>
+inline const T& BasicRangedNumber<T, OutOfRangePolicy>::max() const
+{
+	return mMax;
+}
+
+template <class T, class OutOfRangePolicy>
+inline const T& BasicRangedNumber<T, OutOfRangePolicy>::increment() const
+{
+	return mIncrement;
+}
+
+template <class T, class OutOfRangePolicy>
+inline T BasicRangedNumber<T, OutOfRangePolicy>::getValidValue(const T& value) const
+{
+	return OutOfRangePolicy::getValidValue(value, mMin, mMax, mIncrement);
+}
+
+template <class T, class OutOfRangePolicy>
+inline float BasicRangedNumber<T, OutOfRangePolicy>::timeScale()
+{
+	return OutOfRangePolicy::timeScale();
+}
+
+template <class T, class OutOfRangePolicy>
+void BasicRangedNumber<T, OutOfRangePolicy>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mValue);
+	writer.write(mMin);
+	writer.write(mMax);
+	writer.write(mIncrement);
+}
+
+template <class T, class OutOfRangePolicy>
+bool BasicRangedNumber<T, OutOfRangePolicy>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mValue);
+	reader.read(mMin);
+	reader.read(mMax);
+	reader.read(mIncrement);
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_BASIC_RANGED_NUMBER_H
@@ -15,6 +15,13 @@ BufferedBool::BufferedBool(float bottomThreshold, float topThreshold, float incr
 
 void BufferedBool::setValue(bool value, float ellapsedTime)
 {
+	update(value, ellapsedTime);
+}
+
+bool BufferedBool::update(bool value, float ellapsedTime)
+{
+	bool oldValue = mBoolValue;
+
 	if(value)
 	{
 		mFloatValue.inc(ellapsedTime);
@@ -35,6 +42,8 @@ void BufferedBool::setValue(bool value, float ellapsedTime)
 			mBoolValue = false;
 		}
 	}
+
+	return mBoolValue != oldValue;
 }
 
 bool BufferedBool::getValue() const
@@ -58,4 +67,33 @@ float BufferedBool::getFloatValue() const
 	return mFloatValue.getValue();
 }
 
+void BufferedBool::process(const bool values[], const float elapsedTimes[], bool outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		update(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = BufferedBool::getValue();
+	}
+}
+
+void BufferedBool::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mBottomThreshold);
+	writer.write(mTopThreshold);
+	mFloatValue.serialize(writer);
+	writer.write(mBoolValue);
+	writer.write(mFrameTime);
+}
+
+bool BufferedBool::deserialize(SnapshotReader& reader)
+{
+	reader.read(mBottomThreshold);
+	reader.read(mTopThreshold);
+	mFloatValue.deserialize(reader);
+	reader.read(mBoolValue);
+	reader.read(mFrameTime);
+
+	return reader.isOk();
+}
+
 }} //namespace
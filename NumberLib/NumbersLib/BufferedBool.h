@@ -1,8 +1,9 @@
 #ifndef _BUFFERED_BOOL_
 #define _BUFFERED_BOOL_
 
-#include "ClampedNumber.h"
+#include "BasicRangedNumber.h"
 #include "UpdateableNumber.h"
+#include "Snapshot.h"
 
 namespace luma
 {
@@ -73,7 +74,7 @@ class BufferedBool : public UpdateableNumber<bool>
 private:
 	float mBottomThreshold;
 	float mTopThreshold;
-	ClampedNumber<float> mFloatValue;
+	BasicRangedNumber<float, ClampPolicy> mFloatValue;
 	bool mBoolValue;
 	float mFrameTime;
 
@@ -107,6 +108,13 @@ public:
 	*/
 	void setValue(bool value, float ellapsedTime = 1);
 
+	/**
+		Updates this BufferedBool like setValue, and returns whether the
+		boolean value changed. Unlike setValue, this function is not
+		virtual.
+	*/
+	bool update(bool value, float ellapsedTime = TIME_UNIT);
+
 	/**
 		Forces the next value to be the given value.
 	*/
@@ -124,6 +132,22 @@ public:
 	*/
 	float getFloatValue() const;
 
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const bool values[], const float elapsedTimes[], bool outputs[], size_t count);
+
+	/**
+		Writes the thresholds, the internal float and the boolean
+		value to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 }}//namespace
 
@@ -0,0 +1,649 @@
+#ifndef _BUFFERED_BOOL_ARRAY_H_
+#define _BUFFERED_BOOL_ARRAY_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "utils.h"
+#include "Clock.h"
+#include "Simd.h"
+#include "TransitionQueue.h"
+#include "Snapshot.h"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	Converts between the levels of a BufferedBoolArray and floats
+	between 0 and 1. Float levels are stored as they are.
+*/
+template <class Level>
+struct BufferedBoolLevel
+{
+	static Level fromFloat(float value)
+	{
+		return value;
+	}
+
+	static float toFloat(Level level)
+	{
+		return level;
+	}
+};
+
+/**
+	16-bit levels count in units of 1/65535, rounded to the nearest
+	unit.
+*/
+template <>
+struct BufferedBoolLevel<unsigned short>
+{
+	static unsigned short fromFloat(float value)
+	{
+		return (unsigned short) (clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	static float toFloat(unsigned short level)
+	{
+		return level / 65535.0f;
+	}
+};
+
+/**
+	Updates the levels of 32 lanes of a BufferedBoolArray, and
+	compares them with the thresholds. This is the scalar version,
+	used for types that have no SIMD version.
+
+	@param levels
+		The levels of the 32 lanes.
+	@param inputs
+		The inputs of the lanes, bit i for lane i. The level of a lane
+		is increased by step if its input is set, otherwise decreased
+		by step, and clamped between 0 and maxLevel.
+	@param tops
+		The top thresholds of the lanes.
+	@param bottoms
+		The bottom thresholds of the lanes.
+	@param notBelow
+		Receives a bit for each lane whose level is not below its
+		bottom threshold.
+	@return
+		A bit for each lane whose level is above its top threshold.
+*/
+template <class Level>
+inline unsigned int updateBufferedBoolLanes(Level levels[], unsigned int inputs, Level step, Level maxLevel, const Level tops[], const Level bottoms[], unsigned int& notBelow)
+{
+	unsigned int above = 0;
+
+	notBelow = 0;
+
+	for(unsigned int i = 0; i < 32; i++)
+	{
+		Level level = levels[i];
+
+		if((inputs >> i) & 1)
+		{
+			level = maxLevel - level > step ? (Level) (level + step) : maxLevel;
+		}
+		else
+		{
+			level = level > step ? (Level) (level - step) : (Level) 0;
+		}
+
+		levels[i] = level;
+
+		above |= (unsigned int) (level > tops[i]) << i;
+		notBelow |= (unsigned int) (level >= bottoms[i]) << i;
+	}
+
+	return above;
+}
+
+/**
+	Float lanes are clamped exactly as BufferedBool clamps its level,
+	so that the results are the same.
+*/
+inline unsigned int updateBufferedBoolLanes(float levels[], unsigned int inputs, float step, float maxLevel, const float tops[], const float bottoms[], unsigned int& notBelow)
+{
+	unsigned int above = 0;
+	unsigned int i = 0;
+
+	notBelow = 0;
+
+#if defined(NUMBERS_AVX2)
+	const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+	const __m256 up = _mm256_set1_ps(step);
+	const __m256 down = _mm256_set1_ps(-step);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 last = _mm256_set1_ps(maxLevel);
+
+	for(; i < 32; i += 8)
+	{
+		__m256i lanes = _mm256_set1_epi32((int) (inputs >> i));
+		__m256 mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(lanes, bits), bits));
+		__m256 level = _mm256_add_ps(_mm256_loadu_ps(levels + i), _mm256_blendv_ps(down, up, mask));
+
+		level = _mm256_min_ps(last, _mm256_max_ps(level, zero));
+		_mm256_storeu_ps(levels + i, level);
+
+		above |= (unsigned int) _mm256_movemask_ps(_mm256_cmp_ps(level, _mm256_loadu_ps(tops + i), _CMP_GT_OQ)) << i;
+		notBelow |= (unsigned int) _mm256_movemask_ps(_mm256_cmp_ps(level, _mm256_loadu_ps(bottoms + i), _CMP_GE_OQ)) << i;
+	}
+#elif defined(NUMBERS_SSE2)
+	const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+	const __m128 up = _mm_set1_ps(step);
+	const __m128 down = _mm_set1_ps(-step);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 last = _mm_set1_ps(maxLevel);
+
+	for(; i < 32; i += 4)
+	{
+		__m128i lanes = _mm_set1_epi32((int) (inputs >> i));
+		__m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(lanes, bits), bits));
+		__m128 change = _mm_or_ps(_mm_and_ps(mask, up), _mm_andnot_ps(mask, down));
+		__m128 level = _mm_add_ps(_mm_loadu_ps(levels + i), change);
+
+		level = _mm_min_ps(last, _mm_max_ps(level, zero));
+		_mm_storeu_ps(levels + i, level);
+
+		above |= (unsigned int) _mm_movemask_ps(_mm_cmpgt_ps(level, _mm_loadu_ps(tops + i))) << i;
+		notBelow |= (unsigned int) _mm_movemask_ps(_mm_cmpge_ps(level, _mm_loadu_ps(bottoms + i))) << i;
+	}
+#endif
+
+	for(; i < 32; i++)
+	{
+		float level = levels[i] + ((inputs >> i) & 1 ? step : -step);
+
+		level = clamp(level, 0.0f, maxLevel);
+		levels[i] = level;
+
+		above |= (unsigned int) (level > tops[i]) << i;
+		notBelow |= (unsigned int) (level >= bottoms[i]) << i;
+	}
+
+	return above;
+}
+
+#if defined(NUMBERS_SSE2)
+
+/**
+	16-bit lanes use saturating arithmetic. SSE2 has no unsigned
+	16-bit comparisons, so the sign bits are flipped to compare
+	signed numbers instead.
+*/
+inline unsigned int updateBufferedBoolLanes(unsigned short levels[], unsigned int inputs, unsigned short step, unsigned short maxLevel, const unsigned short tops[], const unsigned short bottoms[], unsigned int& notBelow)
+{
+	unsigned int above = 0;
+
+	notBelow = 0;
+
+#if defined(NUMBERS_AVX2)
+	const __m256i bits = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128,
+		256, 512, 1024, 2048, 4096, 8192, 16384, (short) 0x8000);
+	const __m256i steps = _mm256_set1_epi16((short) step);
+	const __m256i last = _mm256_set1_epi16((short) maxLevel);
+
+	for(unsigned int i = 0; i < 32; i += 16)
+	{
+		__m256i lanes = _mm256_set1_epi16((short) (inputs >> i));
+		__m256i mask = _mm256_cmpeq_epi16(_mm256_and_si256(lanes, bits), bits);
+		__m256i level = _mm256_loadu_si256((const __m256i *) (levels + i));
+		__m256i increased = _mm256_min_epu16(_mm256_adds_epu16(level, steps), last);
+		__m256i decreased = _mm256_subs_epu16(level, steps);
+
+		level = _mm256_blendv_epi8(decreased, increased, mask);
+		_mm256_storeu_si256((__m256i *) (levels + i), level);
+
+		//AVX2 has no unsigned comparisons either, but level <= top exactly when max(level, top) == top
+		__m256i top = _mm256_loadu_si256((const __m256i *) (tops + i));
+		__m256i bottom = _mm256_loadu_si256((const __m256i *) (bottoms + i));
+		__m256i isAbove = _mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_max_epu16(level, top), top), _mm256_set1_epi16(-1));
+		__m256i isNotBelow = _mm256_cmpeq_epi16(_mm256_max_epu16(level, bottom), level);
+
+		//pack the 16-bit masks to bytes, to get one bit per lane
+		__m128i aboveBytes = _mm_packs_epi16(_mm256_castsi256_si128(isAbove), _mm256_extracti128_si256(isAbove, 1));
+		__m128i notBelowBytes = _mm_packs_epi16(_mm256_castsi256_si128(isNotBelow), _mm256_extracti128_si256(isNotBelow, 1));
+
+		above |= (unsigned int) _mm_movemask_epi8(aboveBytes) << i;
+		notBelow |= (unsigned int) _mm_movemask_epi8(notBelowBytes) << i;
+	}
+#else
+	const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+	const __m128i steps = _mm_set1_epi16((short) step);
+	const __m128i last = _mm_set1_epi16((short) maxLevel);
+	const __m128i sign = _mm_set1_epi16((short) 0x8000);
+
+	for(unsigned int i = 0; i < 32; i += 8)
+	{
+		__m128i lanes = _mm_set1_epi16((short) (inputs >> i));
+		__m128i mask = _mm_cmpeq_epi16(_mm_and_si128(lanes, bits), bits);
+		__m128i level = _mm_loadu_si128((const __m128i *) (levels + i));
+		__m128i increased = _mm_adds_epu16(level, steps);
+		__m128i decreased = _mm_subs_epu16(level, steps);
+
+		//min(increased, last), without SSE4.1
+		increased = _mm_sub_epi16(increased, _mm_subs_epu16(increased, last));
+		level = _mm_or_si128(_mm_and_si128(mask, increased), _mm_andnot_si128(mask, decreased));
+		_mm_storeu_si128((__m128i *) (levels + i), level);
+
+		__m128i signedLevel = _mm_xor_si128(level, sign);
+		__m128i top = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (tops + i)), sign);
+		__m128i bottom = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (bottoms + i)), sign);
+		__m128i isAbove = _mm_cmpgt_epi16(signedLevel, top);
+		__m128i isBelow = _mm_cmpgt_epi16(bottom, signedLevel);
+
+		above |= (unsigned int) _mm_movemask_epi8(_mm_packs_epi16(isAbove, isAbove)) << i & (0xFFu << i);
+		notBelow |= (unsigned int) (~_mm_movemask_epi8(_mm_packs_epi16(isBelow, isBelow)) & 0xFF) << i;
+	}
+#endif
+
+	return above;
+}
+
+#endif
+
+/**
+	A large number of BufferedBools (flags), updated together.
+
+	Each flag works exactly like a BufferedBool: its level is increased
+	while its input is true and decreased while it is false, and its
+	output switches to true when the level rises above the top
+	threshold, and to false when it drops below the bottom threshold.
+
+	Where a BufferedBool takes more than 40 bytes, a flag takes one
+	float (or 16-bit) level and two bits. The outputs are kept as a
+	packed bitset (bit i % 32 of word i / 32 for flag i), the inputs are
+	given as one, and the levels of many flags are updated at once with
+	SSE2 or AVX2 instructions (see Simd.h).
+
+	@code
+	BufferedBoolArray<> alarms(sensorCount, 0.3f, 0.7f, 0.1f);
+
+	//every tick
+	alarms.setValues(readings, elapsedTime); //readings is a packed bitset
+
+	for(size_t i = alarms.nextChanged(0); i < alarms.getCount(); i = alarms.nextChanged(i + 1))
+	{
+		alarms.getValue(i) ? raiseAlarm(i) : clearAlarm(i);
+	}
+	@endcode
+
+	All flags share their increment. The thresholds are shared too,
+	until they are set for a single flag with setThresholds.
+
+	@param Level
+		The type of the levels: float (the default), which gives the
+		same results as BufferedBool, or unsigned short, which halves
+		the memory of the levels and doubles the number of flags updated
+		per instruction, but rounds the increment and thresholds to
+		multiples of 1/65535.
+	@param Clock
+		The clock whose time scale multiplies the elapsed time
+		(see Clock.h).
+*/
+template <class Level = float, class Clock = DefaultClock>
+class BufferedBoolArray
+{
+public:
+	/**
+		The type of the words of the packed bitsets.
+	*/
+	typedef unsigned int Word;
+
+	/**
+		The number of flags per word.
+	*/
+	static const unsigned int WORD_BITS = 32;
+
+	/**
+		Constructs a new BufferedBoolArray with count flags that are
+		all false, with the given shared thresholds and increment.
+		See BufferedBool::BufferedBool.
+	*/
+	BufferedBoolArray(size_t count, float bottomThreshold, float topThreshold, float increment = 0.1f);
+
+	/**
+		Returns the number of flags.
+	*/
+	size_t getCount() const;
+
+	/**
+		Returns the number of words in the packed bitsets, that is,
+		the number of flags divided by WORD_BITS, rounded up.
+	*/
+	size_t getWordCount() const;
+
+	/**
+		Updates all flags with the inputs, which must be a packed bitset
+		of getWordCount() words. Flags whose output changes are recorded,
+		see getChanged and nextChanged.
+	*/
+	void setValues(const Word inputs[], float elapsedTime = TIME_UNIT);
+
+	/**
+		Returns the output of flag i.
+	*/
+	bool getValue(size_t i) const;
+
+	/**
+		Returns the outputs of all flags, as a packed bitset of
+		getWordCount() words, or 0 if this array has no flags.
+	*/
+	const Word * getValues() const;
+
+	/**
+		Returns the flags whose output changed in the last call to
+		setValues, as a packed bitset of getWordCount() words, or 0
+		if this array has no flags.
+	*/
+	const Word * getChanged() const;
+
+	/**
+		Returns the index of the first flag at or after i whose output
+		changed in the last call to setValues, or getCount() if there is
+		none.
+	*/
+	size_t nextChanged(size_t i) const;
+
+	/**
+		Appends a transition for every flag whose output changed in
+		the last call to setValues, in order of their indices.
+	*/
+	void appendTransitions(TransitionQueue<bool>& transitions) const;
+
+	/**
+		Forces the output of flag i to the given value, and its
+		level to the extreme that keeps it there. See
+		BufferedBool::forceValue.
+	*/
+	void forceValue(size_t i, bool value);
+
+	/**
+		Gives flag i its own thresholds. The first call allocates
+		thresholds for every flag.
+	*/
+	void setThresholds(size_t i, float bottomThreshold, float topThreshold);
+
+	/**
+		Returns the level of flag i, between 0 and 1. This function
+		is useful for debugging.
+	*/
+	float getLevel(size_t i) const;
+
+	/**
+		Writes the state of all flags to the snapshot. The levels,
+		outputs and thresholds are each written as one block. See
+		Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize. The number of flags
+		must be the same.
+	*/
+	bool deserialize(SnapshotReader& reader);
+
+private:
+	size_t mCount;
+	float mIncrement;
+
+	/** The bits of the last word that belong to flags. */
+	Word mLastWordMask;
+	Level mMaxLevel;
+
+	/** One level per flag, padded to a whole number of words. */
+	std::vector<Level> mLevels;
+
+	std::vector<Word> mValues;
+	std::vector<Word> mChanged;
+
+	/**
+		The shared thresholds, repeated WORD_BITS times, so that all
+		words can be updated by the same function.
+	*/
+	Level mSharedBottoms[WORD_BITS];
+	Level mSharedTops[WORD_BITS];
+
+	/** Per-flag thresholds; empty while all flags share their thresholds. */
+	std::vector<Level> mBottoms;
+	std::vector<Level> mTops;
+
+	/**
+		Returns the index of the lowest set bit of a non-zero word.
+	*/
+	static unsigned int lowestBit(Word word);
+};
+
+template <class Level, class Clock>
+BufferedBoolArray<Level, Clock>::BufferedBoolArray(size_t count, float bottomThreshold, float topThreshold, float increment):
+	mCount(count),
+	mIncrement(increment),
+	mLastWordMask(count % WORD_BITS ? ((Word) 1 << (count % WORD_BITS)) - 1 : ~(Word) 0),
+	mMaxLevel(BufferedBoolLevel<Level>::fromFloat(1.0f - increment)),
+	mLevels((count + WORD_BITS - 1) / WORD_BITS * WORD_BITS, (Level) 0),
+	mValues((count + WORD_BITS - 1) / WORD_BITS, 0),
+	mChanged((count + WORD_BITS - 1) / WORD_BITS, 0)
+{
+	for(unsigned int i = 0; i < WORD_BITS; i++)
+	{
+		mSharedBottoms[i] = BufferedBoolLevel<Level>::fromFloat(bottomThreshold);
+		mSharedTops[i] = BufferedBoolLevel<Level>::fromFloat(topThreshold);
+	}
+}
+
+template <class Level, class Clock>
+size_t BufferedBoolArray<Level, Clock>::getCount() const
+{
+	return mCount;
+}
+
+template <class Level, class Clock>
+size_t BufferedBoolArray<Level, Clock>::getWordCount() const
+{
+	return mValues.size();
+}
+
+template <class Level, class Clock>
+void BufferedBoolArray<Level, Clock>::setValues(const Word inputs[], float elapsedTime)
+{
+	//the same step as BasicRangedNumber::inc
+	Level step = BufferedBoolLevel<Level>::fromFloat(scaleByTime(mIncrement, elapsedTime, Clock::timeScale()));
+	bool perFlag = !mTops.empty();
+	size_t wordCount = mValues.size();
+
+	for(size_t word = 0; word < wordCount; word++)
+	{
+		size_t first = word * WORD_BITS;
+		const Level * tops = perFlag ? &mTops[first] : mSharedTops;
+		const Level * bottoms = perFlag ? &mBottoms[first] : mSharedBottoms;
+		Word input = inputs[word] & (word + 1 < wordCount ? ~(Word) 0 : mLastWordMask);
+		Word notBelow;
+		Word above = updateBufferedBoolLanes(&mLevels[first], input, step, mMaxLevel, tops, bottoms, notBelow);
+		Word value = mValues[word];
+
+		//true inputs can only switch flags on, false inputs only off
+		Word newValue = (input & (value | above)) | (~input & value & notBelow);
+
+		mChanged[word] = value ^ newValue;
+		mValues[word] = newValue;
+	}
+}
+
+template <class Level, class Clock>
+bool BufferedBoolArray<Level, Clock>::getValue(size_t i) const
+{
+	return (mValues[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+template <class Level, class Clock>
+const typename BufferedBoolArray<Level, Clock>::Word * BufferedBoolArray<Level, Clock>::getValues() const
+{
+	return mValues.empty() ? 0 : &mValues[0];
+}
+
+template <class Level, class Clock>
+const typename BufferedBoolArray<Level, Clock>::Word * BufferedBoolArray<Level, Clock>::getChanged() const
+{
+	return mChanged.empty() ? 0 : &mChanged[0];
+}
+
+template <class Level, class Clock>
+size_t BufferedBoolArray<Level, Clock>::nextChanged(size_t i) const
+{
+	size_t wordCount = mChanged.size();
+	size_t word = i / WORD_BITS;
+
+	if(word >= wordCount)
+	{
+		return mCount;
+	}
+
+	//ignore the flags before i in the first word
+	Word changed = mChanged[word] & (~(Word) 0 << (i % WORD_BITS));
+
+	while(changed == 0)
+	{
+		if(++word == wordCount)
+		{
+			return mCount;
+		}
+
+		changed = mChanged[word];
+	}
+
+	//padding flags never change, so this is less than mCount
+	return word * WORD_BITS + lowestBit(changed);
+}
+
+template <class Level, class Clock>
+void BufferedBoolArray<Level, Clock>::appendTransitions(TransitionQueue<bool>& transitions) const
+{
+	for(size_t i = nextChanged(0); i < mCount; i = nextChanged(i + 1))
+	{
+		bool value = getValue(i);
+
+		transitions.push((unsigned int) i, !value, value);
+	}
+}
+
+template <class Level, class Clock>
+void BufferedBoolArray<Level, Clock>::forceValue(size_t i, bool value)
+{
+	Word bit = (Word) 1 << (i % WORD_BITS);
+
+	mLevels[i] = value ? mMaxLevel : (Level) 0;
+	mValues[i / WORD_BITS] = value ? mValues[i / WORD_BITS] | bit : mValues[i / WORD_BITS] & ~bit;
+}
+
+template <class Level, class Clock>
+void BufferedBoolArray<Level, Clock>::setThresholds(size_t i, float bottomThreshold, float topThreshold)
+{
+	if(mTops.empty())
+	{
+		mBottoms.assign(mLevels.size(), mSharedBottoms[0]);
+		mTops.assign(mLevels.size(), mSharedTops[0]);
+	}
+
+	mBottoms[i] = BufferedBoolLevel<Level>::fromFloat(bottomThreshold);
+	mTops[i] = BufferedBoolLevel<Level>::fromFloat(topThreshold);
+}
+
+template <class Level, class Clock>
+float BufferedBoolArray<Level, Clock>::getLevel(size_t i) const
+{
+	return BufferedBoolLevel<Level>::toFloat(mLevels[i]);
+}
+
+template <class Level, class Clock>
+void BufferedBoolArray<Level, Clock>::serialize(SnapshotWriter& writer) const
+{
+	unsigned int perFlag = mTops.empty() ? 0 : 1;
+
+	writer.write((unsigned int) mCount);
+	writer.write((unsigned int) sizeof(Level));
+	writer.write(mIncrement);
+	writer.write(mMaxLevel);
+	writer.write(mLevels);
+	writer.write(mValues);
+	writer.write(mChanged);
+	writer.write(mSharedBottoms, WORD_BITS);
+	writer.write(mSharedTops, WORD_BITS);
+	writer.write(perFlag);
+
+	if(perFlag)
+	{
+		writer.write(mBottoms);
+		writer.write(mTops);
+	}
+}
+
+template <class Level, class Clock>
+bool BufferedBoolArray<Level, Clock>::deserialize(SnapshotReader& reader)
+{
+	unsigned int perFlag = 0;
+
+	reader.expect((unsigned int) mCount);
+	reader.expect((unsigned int) sizeof(Level));
+	reader.read(mIncrement);
+	reader.read(mMaxLevel);
+	reader.read(mLevels);
+	reader.read(mValues);
+	reader.read(mChanged);
+	reader.read(mSharedBottoms, WORD_BITS);
+	reader.read(mSharedTops, WORD_BITS);
+
+	if(!reader.read(perFlag))
+	{
+		return false;
+	}
+
+	if(perFlag)
+	{
+		mBottoms.resize(mLevels.size());
+		mTops.resize(mLevels.size());
+		reader.read(mBottoms);
+		reader.read(mTops);
+	}
+	else
+	{
+		mBottoms.clear();
+		mTops.clear();
+	}
+
+	return reader.isOk();
+}
+
+template <class Level, class Clock>
+unsigned int BufferedBoolArray<Level, Clock>::lowestBit(Word word)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+
+	_BitScanForward(&index, word);
+
+	return (unsigned int) index;
+#elif defined(__GNUC__)
+	return (unsigned int) __builtin_ctz(word);
+#else
+	unsigned int index = 0;
+
+	while(!(word & 1))
+	{
+		word >>= 1;
+		index++;
+	}
+
+	return index;
+#endif
+}
+
+}} //namespace
+
+#endif //_BUFFERED_BOOL_ARRAY_H_
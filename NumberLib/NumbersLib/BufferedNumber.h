@@ -4,6 +4,7 @@
 #include "utils.h"
 #include "ClampedNumber.h"
 #include "UpdateableNumber.h"
+#include "Snapshot.h"
 
 namespace luma
 {
@@ -25,9 +26,15 @@ namespace numbers
 	
 	The code of this documentation can be downloaded from
 	http://www.luma.co.za/labs/2007/09/01/c-special-numbers-library/.
+
+	@param Number
+		The ranged number that holds the value, for example
+		ClampedNumber<T, ConstantClock<30> > to use a clock other
+		than the default (see Clock.h). The elapsed time is
+		multiplied by Number::timeScale().
 */
 
-template <class T, class Number = ClampedNumber<T>>
+template <class T, class Number = ClampedNumber<T> >
 class BufferedNumber : public UpdateableNumber<T>
 {
 private:
@@ -59,6 +66,23 @@ public:
 		function.
 	*/
 	void forceValue(T value);
+
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count);
+
+	/**
+		Writes the ideal and current values (with their ranges) to
+		the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <class T, class Number>
@@ -79,9 +103,11 @@ void BufferedNumber<T, Number>::setValue(T value, float elapsedTime)
 {
 	mIdealValue.setValue(value);
 
-	if (mValue + mValue.increment() * elapsedTime * frameRate < mIdealValue)
+	T step = scaleByTime(mValue.increment(), elapsedTime, Number::timeScale());
+
+	if (mValue + step < mIdealValue)
 		mValue.inc(elapsedTime);	
-	else if(mValue - mValue.increment() * elapsedTime * frameRate > mIdealValue)
+	else if(mValue - step > mIdealValue)
 		mValue.dec(elapsedTime);
 	else
 		mValue.setValue(value);
@@ -94,6 +120,29 @@ void BufferedNumber<T, Number>::forceValue(T value)
 	mValue.setValue(value);
 }
 
+template <class T, class Number>
+void BufferedNumber<T, Number>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		BufferedNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = BufferedNumber::getValue();
+	}
+}
+
+template <class T, class Number>
+void BufferedNumber<T, Number>::serialize(SnapshotWriter& writer) const
+{
+	mIdealValue.serialize(writer);
+	mValue.serialize(writer);
+}
+
+template <class T, class Number>
+bool BufferedNumber<T, Number>::deserialize(SnapshotReader& reader)
+{
+	return mIdealValue.deserialize(reader) && mValue.deserialize(reader);
+}
+
 };}; //namespace
 
 #endif //_BUFFERED_NUMBER_H_
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Numbers.h"
 #include "ClampedNumber.h"
+#include "Snapshot.h"
 
 namespace luma
 {
@@ -22,6 +23,9 @@ namespace numbers
 	Note that this class is not a state machine - rather, it can be used with a state 
 	machine to gain buffered transitions.
 
+	Every update takes O(n) time. LazyBufferedState behaves the same,
+	but its updates take constant time.
+
 	@param n 
 		The number of states.
 
@@ -101,15 +105,46 @@ public:
 	*/
 	void setValue(unsigned int state, float ellapsedTime = 1);
 
+	/**
+		Updates this buffered state like setValue, and returns whether
+		the state returned by getValue() changed. Unlike setValue, this
+		function is not virtual.
+	*/
+	bool update(unsigned int state, float ellapsedTime = TIME_UNIT);
+
 	/**
 		Returns the last triggered state.
 	*/
 	unsigned int getValue() const;
 
+	/**
+		Returns the value of state i, which triggers the state
+		when it rises above the threshold of the state.
+	*/
+	float getStateValue(unsigned int i) const;
+
 	/**
 		Forces the state to the given state. 
 	*/
 	void forceValue(int state);
+
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const unsigned int values[], const float elapsedTimes[], unsigned int outputs[], size_t count);
+
+	/**
+		Writes the state values, thresholds and the triggered state
+		to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize. The snapshot may also
+		have been written by a LazyBufferedState<n>.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <unsigned int n>
@@ -155,6 +190,14 @@ BufferedState<n>::BufferedState(const BufferedState& other):
 template <unsigned int n>
 void BufferedState<n>::setValue(unsigned int state, float ellapsedTime)
 {
+	update(state, ellapsedTime);
+}
+
+template <unsigned int n>
+bool BufferedState<n>::update(unsigned int state, float ellapsedTime)
+{
+	unsigned int oldState = mState;
+
 	mStateValues[state].inc(ellapsedTime);
 
 	if(mStateValues[state] > mThresholds[state])
@@ -167,6 +210,8 @@ void BufferedState<n>::setValue(unsigned int state, float ellapsedTime)
 		
 		mStateValues[i].dec(ellapsedTime);
 	}
+
+	return mState != oldState;
 }
 
 template <unsigned int n>
@@ -175,6 +220,12 @@ unsigned int BufferedState<n>::getValue() const
 	return mState;
 }
 
+template <unsigned int n>
+float BufferedState<n>::getStateValue(unsigned int i) const
+{
+	return mStateValues[i].getValue();
+}
+
 template <unsigned int n>
 void BufferedState<n>::forceValue(int state)
 {
@@ -182,8 +233,62 @@ void BufferedState<n>::forceValue(int state)
 
 	for (int i = 0; i < n; i++)
 	{
-		mStateValues[i] = (i == state ? 1.0f : 0.0f);
+		mStateValues[i].setValue(i == state ? 1.0f : 0.0f);
+	}
+}
+
+template <unsigned int n>
+void BufferedState<n>::process(const unsigned int values[], const float elapsedTimes[], unsigned int outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		update(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = BufferedState::getValue();
+	}
+}
+
+template <unsigned int n>
+void BufferedState<n>::serialize(SnapshotWriter& writer) const
+{
+	float stateValues[n];
+	float increment = mStateValues[0].increment();
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		stateValues[i] = mStateValues[i].getValue();
+	}
+
+	writer.write(n);
+	writer.write(increment);
+	writer.write(stateValues, n);
+	writer.write(mThresholds, n);
+	writer.write(mState);
+}
+
+template <unsigned int n>
+bool BufferedState<n>::deserialize(SnapshotReader& reader)
+{
+	float stateValues[n];
+	float increment = 0;
+
+	reader.expect(n);
+	reader.read(increment);
+	reader.read(stateValues, n);
+	reader.read(mThresholds, n);
+	reader.readIndex(mState, n);
+
+	if(!reader.isOk())
+	{
+		return false;
 	}
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		mStateValues[i].setIncrement(increment);
+		mStateValues[i].setValue(stateValues[i]);
+	}
+
+	return true;
 }
 };};//namespace
 
@@ -2,6 +2,7 @@
 #define _BUFFERED_STEP_H
 
 #include "ClampedNumber.h"
+#include "Snapshot.h"
 namespace luma
 {
 namespace numbers
@@ -36,7 +37,7 @@ private:
 	ClampedNumber<int> mState;
 	ClampedNumber<float> mFloatValue;
 
-	int static indexFromState(int n) { return n > 1 ? n - 1 : 0;};
+	int static indexFromState(int state) { return state > 1 ? state - 1 : 0;};
 
 public:
 	BufferedStep(float mMin, float mMax, float upwardsThresholds[n - 1], float downwardsThresholds[n - 1], float interval);
@@ -45,6 +46,16 @@ public:
 	void forceMin();
 	void forceMax();
 
+	/**
+		Writes the thresholds, the internal float and the state
+		to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <unsigned int n>
@@ -102,5 +113,27 @@ void BufferedStep<n>::forceMax()
 	mState.setValue(n - 1);
 }
 
+template <unsigned int n>
+void BufferedStep<n>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(n);
+	writer.write(mUpwardsThresholds, n - 1);
+	writer.write(mDownwardsThresholds, n - 1);
+	mState.serialize(writer);
+	mFloatValue.serialize(writer);
+}
+
+template <unsigned int n>
+bool BufferedStep<n>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(n);
+	reader.read(mUpwardsThresholds, n - 1);
+	reader.read(mDownwardsThresholds, n - 1);
+	mState.deserialize(reader);
+	mFloatValue.deserialize(reader);
+
+	return reader.isOk();
+}
+
 };}; //namespace
 #endif//_BUFFERED_STEP_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "utils.h"
 #include "RangedNumber.h"
+#include "Clock.h"
 
 namespace luma
 {
@@ -18,12 +19,16 @@ namespace numbers
 		coincides with the ClampedNumber's min or max. For instance, do not
 		use unsigned int if the range is between 0 and some positive number.
 
+	@param Clock
+		The clock whose time scale multiplies the elapsed time
+		in inc() and dec() (see Clock.h).
+
 	@todo Make it possible to use with unsigned int and 0 as bottom limit.
 
 	@author Herman Tulleken (herman.tulleken@gmail.com)
 	@author luma/games (http://www.luma.co.za/)
 */
-template <class T>
+template <class T, class Clock = DefaultClock>
 class ClampedNumber: public RangedNumber<T>
 {
 protected:
@@ -39,7 +44,7 @@ public:
 		Copies all attributes of the other clmaped number to this
 		ClampedNumber.
 	*/
-	ClampedNumber(const ClampedNumber<T>& other);
+	ClampedNumber(const ClampedNumber<T, Clock>& other);
 
 	/**
 		Returns this ClampedNumber's value.
@@ -51,54 +56,60 @@ public:
 		the other value, and clamps it within this ClampedNumber's
 		range. This ClampedNumber's range is not changed.
 	*/
-	ClampedNumber& operator=(const ClampedNumber<T>& other);
+	ClampedNumber& operator=(const ClampedNumber<T, Clock>& other);
 
 	/**
 		Increments this CyclicNumber's value by the
 		given increment, and waps it around.
 	*/
-	ClampedNumber<T>& operator+=(const T& increment);
+	ClampedNumber<T, Clock>& operator+=(const T& increment);
 
 	/**
 		Decrements this CyclicNumber's value by the
 		given increment, and waps it around.
 	*/
-	ClampedNumber<T>& operator-=(const T& decrement);
+	ClampedNumber<T, Clock>& operator-=(const T& decrement);
 
-	virtual ClampedNumber<T>& operator++();
-	virtual ClampedNumber<T> operator++(int);
-	virtual ClampedNumber<T>& operator--();
-	virtual ClampedNumber<T> operator--(int);
+	virtual ClampedNumber<T, Clock>& operator++();
+	virtual ClampedNumber<T, Clock> operator++(int);
+	virtual ClampedNumber<T, Clock>& operator--();
+	virtual ClampedNumber<T, Clock> operator--(int);
 	virtual void dec(float elapsedTime = 1);
 	virtual void inc(float elapsedTime = 1);
+
+	/**
+		Returns the factor by which inc() and dec() multiply
+		the elapsed time.
+	*/
+	static float timeScale();
 };
 
-template <class T>
-ClampedNumber<T>::ClampedNumber(T value, T min, T max,T increment):
+template <class T, class Clock>
+ClampedNumber<T, Clock>::ClampedNumber(T value, T min, T max,T increment):
 	RangedNumber<T>(clamp(value, min, max - increment), min, max, increment)
 {
 }
 
-template <class T>
-ClampedNumber<T>::ClampedNumber(const ClampedNumber<T>& other):
+template <class T, class Clock>
+ClampedNumber<T, Clock>::ClampedNumber(const ClampedNumber<T, Clock>& other):
 	RangedNumber<T>(other)
 {}
 
-/*template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator=(T value)
+/*template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator=(T value)
 {
 	mValue = getValidValue(value);
 	return *this;
 }*/
 
-template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator=(const ClampedNumber<T>& other)
+template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator=(const ClampedNumber<T, Clock>& other)
 {
-	return dynamic_cast<ClampedNumber<T>&>(RangedNumber<T>::operator=(other));
+	return dynamic_cast<ClampedNumber<T, Clock>&>(RangedNumber<T>::operator=(other));
 }
 
-template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator++()
+template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator++()
 {
 	RangedNumber<T>::mValue += RangedNumber<T>::mIncrement;
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::mIncrement);
@@ -106,17 +117,17 @@ ClampedNumber<T>& ClampedNumber<T>::operator++()
 	return *this;
 }
 
-template <class T>
-ClampedNumber<T> ClampedNumber<T>::operator++(int)
+template <class T, class Clock>
+ClampedNumber<T, Clock> ClampedNumber<T, Clock>::operator++(int)
 {
-	ClampedNumber<T> tmp = *this;
+	ClampedNumber<T, Clock> tmp = *this;
 	++*this;
 
 	return tmp;
 }
 
-template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator--()
+template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator--()
 {
 	RangedNumber<T>::mValue -= RangedNumber<T>::mIncrement;
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::mIncrement);
@@ -124,17 +135,17 @@ ClampedNumber<T>& ClampedNumber<T>::operator--()
 	return *this;
 }
 
-template <class T>
-ClampedNumber<T> ClampedNumber<T>::operator--(int)
+template <class T, class Clock>
+ClampedNumber<T, Clock> ClampedNumber<T, Clock>::operator--(int)
 {
-	ClampedNumber<T> tmp = *this;
+	ClampedNumber<T, Clock> tmp = *this;
 	--*this;
 
 	return tmp;
 }
 
-template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator+=(const T& increment)
+template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator+=(const T& increment)
 {
 	RangedNumber<T>::mValue += RangedNumber<T>::increment;
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::increment);
@@ -142,8 +153,8 @@ ClampedNumber<T>& ClampedNumber<T>::operator+=(const T& increment)
 	return *this;
 }
 
-template <class T>
-ClampedNumber<T>& ClampedNumber<T>::operator-=(const T& increment)
+template <class T, class Clock>
+ClampedNumber<T, Clock>& ClampedNumber<T, Clock>::operator-=(const T& increment)
 {
 	RangedNumber<T>::mValue -= RangedNumber<T>::increment;
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::increment);
@@ -151,25 +162,31 @@ ClampedNumber<T>& ClampedNumber<T>::operator-=(const T& increment)
 	return *this;
 }
 
-template <class T>
-T ClampedNumber<T>::getValidValue(const T& value) const
+template <class T, class Clock>
+T ClampedNumber<T, Clock>::getValidValue(const T& value) const
 {
 	return clamp(value, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::mIncrement);
 }
 
-template <class T>
-void ClampedNumber<T>::inc(float ellapsedTime)
+template <class T, class Clock>
+void ClampedNumber<T, Clock>::inc(float ellapsedTime)
 {
-	RangedNumber<T>::mValue += (T)(RangedNumber<T>::mIncrement * ellapsedTime * frameRate);
+	RangedNumber<T>::mValue += scaleByTime(RangedNumber<T>::mIncrement, ellapsedTime, Clock::timeScale());
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::mIncrement);
 }
 
-template <class T>
-void ClampedNumber<T>::dec(float ellapsedTime)
+template <class T, class Clock>
+void ClampedNumber<T, Clock>::dec(float ellapsedTime)
 {
-	RangedNumber<T>::mValue -= (T)(RangedNumber<T>::mIncrement * ellapsedTime * frameRate);
+	RangedNumber<T>::mValue -= scaleByTime(RangedNumber<T>::mIncrement, ellapsedTime, Clock::timeScale());
 	RangedNumber<T>::mValue = clamp(RangedNumber<T>::mValue, RangedNumber<T>::mMin, RangedNumber<T>::mMax - RangedNumber<T>::mIncrement);
 }
 
+template <class T, class Clock>
+float ClampedNumber<T, Clock>::timeScale()
+{
+	return Clock::timeScale();
+}
+
 }}//namespace
 #endif //_CLAMPED_NUMBER_H
@@ -0,0 +1,105 @@
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+#include "Numbers.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	@file
+	Clocks give the factor by which numbers multiply the elapsed
+	time passed to their update functions, in place of the global
+	frameRate.
+
+	A clock is a class with a static function timeScale(), and is
+	passed to a number as a template argument, for example
+
+	@code
+	//physics ticks at 30 Hz, and passes elapsed times in seconds
+	ClampedNumber<float, ConstantClock<30> > speed(0.0f, -10.0f, 10.0f, 0.5f);
+
+	//input ticks at 120 Hz
+	DifferentiableNumber<float, 2, ConstantClock<120> > cursor(0.0f);
+	@endcode
+
+	so that modules that run at different rates can be built
+	together. When the time scale is a compile-time constant (as with
+	DefaultClock and ConstantClock), the multiplication is folded away
+	by the compiler. When it is only known at run time, a RuntimeClock
+	gives every group of numbers its own time scale.
+*/
+
+/**
+	The clock that numbers use if no clock is given: its time scale
+	is frameRate, which is set by defining FRAME_RATE.
+*/
+struct DefaultClock
+{
+	static float timeScale()
+	{
+		return frameRate;
+	}
+};
+
+/**
+	A clock with a time scale of numerator / denominator, which is
+	known at compile time.
+*/
+template <unsigned int numerator, unsigned int denominator = 1>
+struct ConstantClock
+{
+	static float timeScale()
+	{
+		return (float) numerator / (float) denominator;
+	}
+};
+
+/**
+	A clock whose time scale can be changed at run time. All numbers
+	that use the same Group share the time scale, for example
+
+	@code
+	struct PhysicsTime {};
+	typedef RuntimeClock<PhysicsTime> PhysicsClock;
+
+	PhysicsClock::setTimeScale(1.0f / physicsTimeStep);
+	ClampedNumber<float, PhysicsClock> speed(0.0f, -10.0f, 10.0f, 0.5f);
+	@endcode
+
+	The time scale is frameRate until it is set.
+
+	@param Group
+		Any type; it is only used to tell groups apart.
+*/
+template <class Group>
+class RuntimeClock
+{
+private:
+	static float sTimeScale;
+
+public:
+	static float timeScale()
+	{
+		return sTimeScale;
+	}
+
+	/**
+		Sets the time scale of all numbers that use this clock.
+		This should not be called while such numbers are updated
+		by other threads.
+	*/
+	static void setTimeScale(float timeScale)
+	{
+		sTimeScale = timeScale;
+	}
+};
+
+template <class Group>
+float RuntimeClock<Group>::sTimeScale = frameRate;
+
+}} //namespace
+
+#endif //_CLOCK_H_
@@ -79,20 +79,27 @@ public:
 
 	virtual void dec(float elapsedTime = 1);
 	virtual void inc(float elapsedTime = 1);
+
+	/**
+		Returns the factor by which inc() and dec() multiply the
+		elapsed time. This is always 1; unlike ClampedNumber,
+		CyclicNumber does not use a clock.
+	*/
+	static float timeScale();
 };
 
 template <class T>
 CyclicNumber<T>::CyclicNumber(T value, T min, T max, T increment):
-	RangedNumber(mod(value, min, max), min, max, increment)
+	RangedNumber<T>(mod(value, min, max), min, max, increment)
 {
 }
 
 template <class T>
 CyclicNumber<T>& CyclicNumber<T>::operator=(const CyclicNumber<T>& other)
 {
-	this->RangedNumber::operator=(other);
+	this->RangedNumber<T>::operator=(other);
 	/*
-	mValue = mod((T) other, mMin, mMax);
+	this->mValue = mod((T) other, this->mMin, this->mMax);
 	*/
 	return *this;
 }
@@ -100,7 +107,7 @@ CyclicNumber<T>& CyclicNumber<T>::operator=(const CyclicNumber<T>& other)
 template <class T>
 CyclicNumber<T>& CyclicNumber<T>::operator=(const T& value)
 {
-	mValue = mod((T) value, mMin, mMax);
+	this->mValue = mod((T) value, this->mMin, this->mMax);
 
 	return *this;
 }
@@ -142,8 +149,8 @@ CyclicNumber<T> CyclicNumber<T>::operator--(int)
 template <class T>
 CyclicNumber<T>& CyclicNumber<T>::operator+=(const T& increment)
 {
-	mValue += increment;
-	mValue = mod(mValue, mMin, mMax);
+	this->mValue += increment;
+	this->mValue = mod(this->mValue, this->mMin, this->mMax);
 
 	return *this;
 }
@@ -151,8 +158,8 @@ CyclicNumber<T>& CyclicNumber<T>::operator+=(const T& increment)
 template <class T>
 CyclicNumber<T>& CyclicNumber<T>::operator-=(const T& increment)
 {
-	mValue -= increment;
-	mValue = mod(mValue, mMin, mMax);
+	this->mValue -= increment;
+	this->mValue = mod(this->mValue, this->mMin, this->mMax);
 
 	return *this;
 }
@@ -160,21 +167,27 @@ CyclicNumber<T>& CyclicNumber<T>::operator-=(const T& increment)
 template <class T>
 T CyclicNumber<T>::getValidValue(const T& value) const
 {
-	return mod(value, mMin, mMax);
+	return mod(value, this->mMin, this->mMax);
 }
 
 template <class T>
 void CyclicNumber<T>::inc(float ellapsedTime)
 {
-	mValue += (T)(mIncrement * ellapsedTime);
-	mValue = mod(mValue, mMin, mMax);
+	this->mValue += scaleByTime(this->mIncrement, ellapsedTime, timeScale());
+	this->mValue = mod(this->mValue, this->mMin, this->mMax);
 }
 
 template <class T>
 void CyclicNumber<T>::dec(float ellapsedTime)
 {
-	mValue -= (T) (mIncrement * ellapsedTime);
-	mValue = mod(mValue, mMin, mMax);
+	this->mValue -= scaleByTime(this->mIncrement, ellapsedTime, timeScale());
+	this->mValue = mod(this->mValue, this->mMin, this->mMax);
+}
+
+template <class T>
+float CyclicNumber<T>::timeScale()
+{
+	return 1.0f;
 }
 
 }} //namespace
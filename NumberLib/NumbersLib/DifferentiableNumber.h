@@ -1,6 +1,9 @@
 #ifndef _DIFFERENTIABLE_NUMBER_H_
 #define _DIFFERENTIABLE_NUMBER_H_
 
+#include "AbstractFilteredNumber.h"
+#include "Clock.h"
+
 namespace luma
 {
 namespace numbers
@@ -51,22 +54,41 @@ namespace numbers
 	is that it saves a lot of code, and related updates are done in 
 	one place. Of course there is some overhead involved.
 
+	The derivatives of all orders are kept in one array, and are
+	updated in one pass, so that getValue is an array index. The
+	derivatives of order 2 and higher are differences per TIME_UNIT
+	(scaled by the clock) of the derivatives one order lower.
+
+	@param Clock
+		The clock whose time scale multiplies the elapsed time
+		(see Clock.h).
+
 	@see IntegrableNumber
 */
-template <class T, unsigned int maxOrder>
+template <class T, unsigned int maxOrder, class Clock = DefaultClock>
 class DifferentiableNumber : public AbstractFilteredNumber<T, 2, maxOrder>
 {
 private:
+	/** Indices into a row of mDerivatives. */
+	enum
+	{
+		CURRENT = 0,
+		PREVIOUS = 1
+	};
+
 	T mValue;
 	T mPreviousValue;	
 	T mInitialValue; //some sort of 0
 
-	/** 
-		The difference between the current and previous values is
-		maintained as a DifferentiableNumber<n - 1, T>. It will keep
-		track of its own derivatives.
+	/**
+		The current and previous derivative of order k are
+		mDerivatives[k - 1][CURRENT] and mDerivatives[k - 1][PREVIOUS].
+		They lie next to each other, because every update reads one
+		and writes both. The value is kept apart from the derivatives,
+		so that storing it does not wait for the division by the
+		elapsed time.
 	*/
-	DifferentiableNumber<T, maxOrder - 1> mDifference;
+	T mDerivatives[maxOrder][2];
 
 public:
 	/**
@@ -102,126 +124,133 @@ public:
 	*/
 
 	void forceValue(T value);
+
+	/**
+		See UpdateableNumber::process. The outputs are the values
+		of the given order (by default 1), and the number is
+		updated without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		Writes the current and previous values of all orders to the
+		snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
-template <class T, unsigned int maxOrder>
-void DifferentiableNumber<T, maxOrder>::setValue(T value, float elapsedTime)
+template <class T, unsigned int maxOrder, class Clock>
+void DifferentiableNumber<T, maxOrder, Clock>::setValue(T value, float elapsedTime)
 {
 	mPreviousValue = mValue;
 	mValue = value;
 
-	mDifference.setValue((mValue - mPreviousValue) / (elapsedTime * frameRate));
+	//only the first derivative takes the elapsed time into account
+	T difference = (mValue - mPreviousValue) / (elapsedTime * Clock::timeScale());
+
+	for(unsigned int order = 0; order < maxOrder; order++)
+	{
+		T previous = mDerivatives[order][CURRENT];
+
+		mDerivatives[order][PREVIOUS] = previous;
+		mDerivatives[order][CURRENT] = difference;
+
+		difference = (difference - previous) / (1.0f * Clock::timeScale());
+	}
 }
 
-template <class T, unsigned int maxOrder>
-void DifferentiableNumber<T, maxOrder>::forceValue(T value)
+template <class T, unsigned int maxOrder, class Clock>
+void DifferentiableNumber<T, maxOrder, Clock>::forceValue(T value)
 {
 	mPreviousValue = value;
 	mValue = value;
 
-	mDifference.forceValue(mInitialValue);
+	for(unsigned int order = 0; order < maxOrder; order++)
+	{
+		mDerivatives[order][CURRENT] = mInitialValue;
+		mDerivatives[order][PREVIOUS] = mInitialValue;
+	}
 }
 
-template <class T, unsigned int maxOrder>
-DifferentiableNumber<T, maxOrder>::DifferentiableNumber(T initialValue):
-	mInitialValue(initialValue),
-	mValue(initialValue),
-	mPreviousValue(initialValue),
-	mDifference(initialValue)
+template <class T, unsigned int maxOrder, class Clock>
+DifferentiableNumber<T, maxOrder, Clock>::DifferentiableNumber(T initialValue):
+	mInitialValue(initialValue)
 {
+	forceValue(initialValue);
 }
 
-template <class T, unsigned int maxOrder>
-T DifferentiableNumber<T, maxOrder>::getValue(unsigned int order) const
+template <class T, unsigned int maxOrder, class Clock>
+T DifferentiableNumber<T, maxOrder, Clock>::getValue(unsigned int order) const
 {
 	if(order == 0)
 	{
 		return mValue;
 	}
-	else if(order > 0)
+	else if(order <= maxOrder)
 	{
-		if(order <= maxOrder)
-		{
-			return mDifference.getValue(order - 1);
-		}
+		return mDerivatives[order - 1][CURRENT];
 	}
 
 	return mInitialValue;
 }
 
-/**
-	This is the stop class for the recursive template definition of
-	DifferentiableNumber. All the methods work the same as
-	DifferentiableNumber - see the documentation there.
-*/
-template <class T>
-class DifferentiableNumber<T, 1> : public AbstractFilteredNumber<T, 2, 1>
+template <class T, unsigned int maxOrder, class Clock>
+void DifferentiableNumber<T, maxOrder, Clock>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
 {
-private:
-	T mValue;
-	T mPreviousValue;
-	T mDifference;
-	T mInitialValue;
-
-public:
-	
-	/**
-	@see DifferentiableNumber<T, n>::DifferentiableNumber()
-	*/
-	DifferentiableNumber(T initialValue);
-
-	/**
-	@see DifferentiableNumber<T, n>::setValue()
-	*/
-	void setValue(T value, float elapsedTime = 1.0f);
-
-	void forceValue(T value);
-
-	/**
-	@see DifferentiableNumber<T, n>::getValue()
-	*/
-	T getValue(unsigned int order = 1) const;
-};
-
-template <class T>
-void DifferentiableNumber<T, 1>::setValue(T value, float elapsedTime)
-{
-	mPreviousValue = mValue;
-	mValue = value;
-	mDifference = (mValue - mPreviousValue) / (elapsedTime * frameRate);
+	for(size_t i = 0; i < count; i++)
+	{
+		DifferentiableNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = DifferentiableNumber::getValue(order);
+	}
 }
 
-template <class T>
-void DifferentiableNumber<T, 1>::forceValue(T value)
+template <class T, unsigned int maxOrder, class Clock>
+void DifferentiableNumber<T, maxOrder, Clock>::serialize(SnapshotWriter& writer) const
 {
-	mPreviousValue = value;
-	mValue = value;
-	mDifference = mInitialValue;
-}
-
+	//one block per order below maxOrder, headed by the number of
+	//orders from there up; the previous value of the highest
+	//derivative is not used, and not written
+	writer.write(maxOrder);
+	writer.write(mValue);
+	writer.write(mPreviousValue);
+	writer.write(mInitialValue);
+
+	for(unsigned int order = 1; order < maxOrder; order++)
+	{
+		writer.write(maxOrder - order);
+		writer.write(mDerivatives[order - 1][CURRENT]);
+		writer.write(mDerivatives[order - 1][PREVIOUS]);
+		writer.write(mInitialValue);
+	}
 
-template <class T>
-DifferentiableNumber<T, 1>::DifferentiableNumber(T initialValue):
-	mInitialValue(initialValue),
-	mValue(initialValue),
-	mPreviousValue(initialValue),
-	mDifference(initialValue)
-{
+	writer.write(mDerivatives[maxOrder - 1][CURRENT]);
 }
 
-template <class T>
-T DifferentiableNumber<T, 1>::getValue(unsigned int order) const
+template <class T, unsigned int maxOrder, class Clock>
+bool DifferentiableNumber<T, maxOrder, Clock>::deserialize(SnapshotReader& reader)
 {
-	if(order == 0)
-	{
-		return mValue;
-	}
-	else if(order == 1)
+	reader.expect(maxOrder);
+	reader.read(mValue);
+	reader.read(mPreviousValue);
+	reader.read(mInitialValue);
+
+	for(unsigned int order = 1; order < maxOrder; order++)
 	{
-		return mDifference;		
+		reader.expect(maxOrder - order);
+		reader.read(mDerivatives[order - 1][CURRENT]);
+		reader.read(mDerivatives[order - 1][PREVIOUS]);
+		reader.read(mInitialValue);
 	}
-	
-	return mInitialValue;
+
+	reader.read(mDerivatives[maxOrder - 1][CURRENT]);
+	mDerivatives[maxOrder - 1][PREVIOUS] = mDerivatives[maxOrder - 1][CURRENT];
+
+	return reader.isOk();
 }
 
 /**
@@ -229,8 +258,8 @@ T DifferentiableNumber<T, 1>::getValue(unsigned int order) const
 	generally not be used. It is nothing more than a wrapper for the value;
 	the elapsedTime is ignored.
 */
-template <class T>
-class DifferentiableNumber<T, 0> : public AbstractFilteredNumber<T, 2, 0>
+template <class T, class Clock>
+class DifferentiableNumber<T, 0, Clock> : public AbstractFilteredNumber<T, 2, 0>
 {
 private:
 	T mValue;
@@ -240,9 +269,9 @@ public:
 };
 
 
-template <class T>
-DifferentiableNumber<T, 0>::DifferentiableNumber(T initialValue):
-	AbstractFilteredNumber(initialValue)
+template <class T, class Clock>
+DifferentiableNumber<T, 0, Clock>::DifferentiableNumber(T initialValue):
+	AbstractFilteredNumber<T, 2, 0>(initialValue)
 {
 }
 
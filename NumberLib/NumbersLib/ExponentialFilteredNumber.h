@@ -0,0 +1,257 @@
+#ifndef _EXPONENTIAL_FILTERED_NUMBER_H_
+#define _EXPONENTIAL_FILTERED_NUMBER_H_
+
+#include <math.h>
+
+#include "utils.h"
+#include "AbstractFilteredNumber.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A filtered number whose filtered values are exponential moving
+	averages. It keeps one value per order instead of a ring buffer
+	of samples, so it is a small and fast replacement for a
+	FilteredNumber or IntegrableNumber that is used to smooth a value.
+
+	Every update moves the value of order k towards the new value of
+	order k - 1:
+
+	@f[
+	y^{(k)}_n = y^{(k)}_{n - 1} + \alpha_n (y^{(k - 1)}_n - y^{(k)}_{n - 1}),
+	\quad \alpha_n = 1 - e^{-t_n / \tau}
+	@f]
+
+	where t_n is the elapsed time of the update, and tau is the time
+	constant. Because alpha depends on the elapsed time, two updates
+	with the same value and an elapsed time of 0.5 have the same
+	effect on order 1 as one update with an elapsed time of 1.
+
+	The weights of past samples decay exponentially instead of
+	ending after sampleCount samples. timeConstantFromSampleCount
+	gives the time constant for which the average age of the samples
+	is the same as that of a uniform FilteredNumber with a given
+	number of samples.
+
+	@param T
+		The type of the values, typically float or double.
+	@param maxOrder
+		The highest order of filtered values; at least 1.
+*/
+template <class T, unsigned int maxOrder>
+class ExponentialFilteredNumber : public AbstractFilteredNumber<T, 1, maxOrder>
+{
+private:
+	/** The value of every order; order 0 is the last value that was set. */
+	T mValues[maxOrder + 1];
+
+	T mInitialValue;
+	float mTimeConstant;
+
+	/** The elapsed time of the last update, and the alpha calculated for it. */
+	float mLastElapsedTime;
+	float mLastAlpha;
+
+	/**
+		Returns alpha for the given elapsed time. The exponential
+		is only calculated when the elapsed time changes.
+	*/
+	float alpha(float elapsedTime);
+
+public:
+	/**
+		Constructs a new ExponentialFilteredNumber, with all orders
+		at the initial value.
+
+		@param initialValue
+			The value of all orders, and the value returned by
+			getValue for orders above maxOrder (a zero of type T).
+		@param timeConstant
+			The time in which the filtered values move about 63% of
+			the way to a new constant value. With a time constant of
+			0, the values of all orders are the last value.
+	*/
+	ExponentialFilteredNumber(T initialValue, float timeConstant);
+
+	/**
+		Returns the time constant for which the samples have the
+		same average age as those of a FilteredNumber with
+		sampleCount uniform weights, updated every TIME_UNIT;
+		that is, alpha is 2 / (sampleCount + 1).
+	*/
+	static float timeConstantFromSampleCount(unsigned int sampleCount);
+
+	/**
+		Gets the filtered value of the given order. The value of
+		order 0 is the last value that was set.
+	*/
+	T getValue(unsigned int order = 1) const;
+
+	/**
+		Sets the last value, and updates the filtered values of
+		all orders.
+
+		@param value
+			The last sample value.
+		@param elapsedTime
+			The time elapsed since the last sample was set.
+	*/
+	void setValue(T value, float elapsedTime = TIME_UNIT);
+
+	/**
+		Sets the values of all orders to the given value, as if
+		it had been set for a long time.
+	*/
+	void forceValue(T value);
+
+	/**
+		Returns the time constant.
+	*/
+	float getTimeConstant() const;
+
+	/**
+		Sets the time constant. The filtered values are kept.
+	*/
+	void setTimeConstant(float timeConstant);
+
+	/**
+		See UpdateableNumber::process. The outputs are the values
+		of the given order (by default 1), and the number is
+		updated without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		Writes the time constant and the values of all orders to
+		the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int maxOrder>
+ExponentialFilteredNumber<T, maxOrder>::ExponentialFilteredNumber(T initialValue, float timeConstant):
+	mInitialValue(initialValue),
+	mTimeConstant(timeConstant),
+	mLastElapsedTime(0),
+	mLastAlpha(timeConstant > 0 ? 0.0f : 1.0f)
+{
+	forceValue(initialValue);
+}
+
+template <class T, unsigned int maxOrder>
+float ExponentialFilteredNumber<T, maxOrder>::timeConstantFromSampleCount(unsigned int sampleCount)
+{
+	if(sampleCount <= 1)
+	{
+		return 0;
+	}
+
+	return TIME_UNIT / (float) log((sampleCount + 1.0) / (sampleCount - 1.0));
+}
+
+template <class T, unsigned int maxOrder>
+float ExponentialFilteredNumber<T, maxOrder>::alpha(float elapsedTime)
+{
+	if(elapsedTime != mLastElapsedTime)
+	{
+		mLastElapsedTime = elapsedTime;
+		mLastAlpha = mTimeConstant > 0 ? 1.0f - (float) exp(-elapsedTime / mTimeConstant) : 1.0f;
+	}
+
+	return mLastAlpha;
+}
+
+template <class T, unsigned int maxOrder>
+T ExponentialFilteredNumber<T, maxOrder>::getValue(unsigned int order) const
+{
+	if(order <= maxOrder)
+	{
+		return mValues[order];
+	}
+
+	return mInitialValue;
+}
+
+template <class T, unsigned int maxOrder>
+void ExponentialFilteredNumber<T, maxOrder>::setValue(T value, float elapsedTime)
+{
+	float a = alpha(elapsedTime);
+
+	mValues[0] = value;
+
+	for(unsigned int order = 1; order <= maxOrder; order++)
+	{
+		mValues[order] += (mValues[order - 1] - mValues[order]) * a;
+	}
+}
+
+template <class T, unsigned int maxOrder>
+void ExponentialFilteredNumber<T, maxOrder>::forceValue(T value)
+{
+	for(unsigned int order = 0; order <= maxOrder; order++)
+	{
+		mValues[order] = value;
+	}
+}
+
+template <class T, unsigned int maxOrder>
+float ExponentialFilteredNumber<T, maxOrder>::getTimeConstant() const
+{
+	return mTimeConstant;
+}
+
+template <class T, unsigned int maxOrder>
+void ExponentialFilteredNumber<T, maxOrder>::setTimeConstant(float timeConstant)
+{
+	mTimeConstant = timeConstant;
+
+	//recalculate alpha on the next update
+	mLastElapsedTime = 0;
+	mLastAlpha = timeConstant > 0 ? 0.0f : 1.0f;
+}
+
+template <class T, unsigned int maxOrder>
+void ExponentialFilteredNumber<T, maxOrder>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		ExponentialFilteredNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = ExponentialFilteredNumber::getValue(order);
+	}
+}
+
+template <class T, unsigned int maxOrder>
+void ExponentialFilteredNumber<T, maxOrder>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(maxOrder);
+	writer.write(mTimeConstant);
+	writer.write(mInitialValue);
+	writer.write(mValues, maxOrder + 1);
+}
+
+template <class T, unsigned int maxOrder>
+bool ExponentialFilteredNumber<T, maxOrder>::deserialize(SnapshotReader& reader)
+{
+	float timeConstant = 0;
+
+	reader.expect(maxOrder);
+	reader.read(timeConstant);
+	reader.read(mInitialValue);
+	reader.read(mValues, maxOrder + 1);
+
+	setTimeConstant(timeConstant);
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_EXPONENTIAL_FILTERED_NUMBER_H_
@@ -0,0 +1,174 @@
+#ifndef _FAST_SIGMOID_H_
+#define _FAST_SIGMOID_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+#include "utils.h"
+#include "ResponseCurve.h"
+#include "AbstractFunction.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A function object that approximates sigmoid (see utils.h) with
+	a table and linear interpolation, for code that evaluates the
+	same sigmoid many times, such as scoring functions.
+
+	@code
+	FastSigmoid<float> score(-5.0f, 5.0f, 0.0f, 1.0f, 0.0001f);
+
+	float s = score(distance); //within 0.0001 of sigmoid(distance, -5.0f, 5.0f, 0.0f, 1.0f)
+	@endcode
+
+	The table is built by the constructor, with as many samples as
+	are needed to keep the error below the given bound: the sigmoid
+	is tabulated only where it differs from its asymptotes by more
+	than maxError, and the samples are spaced so that the
+	interpolation error (at most h^2 / 8 times the largest second
+	derivative, for samples h apart) stays below maxError. Outside
+	the table, the output is the first or last sample.
+
+	Evaluating the approximation takes a multiplication, a table
+	lookup and an interpolation, instead of exp and a division.
+	The batch function evaluate() is not virtual, and uses SIMD
+	instructions where ResponseCurve::evaluate does.
+
+	@param T
+		The number type of the input and output, float or double.
+*/
+template <class T>
+class FastSigmoid : public AbstractFunction<T>
+{
+public:
+	/**
+		Constructs a new FastSigmoid that approximates
+		sigmoid(input, inputMin, inputMax, outputMin, outputMax).
+
+		@param maxError
+			The largest allowed difference between the output and the
+			exact sigmoid, in output units. Halving the error roughly
+			multiplies the number of samples by 1.4. Rounding errors
+			of T come on top of this bound.
+	*/
+	FastSigmoid(T inputMin, T inputMax, T outputMin, T outputMax, T maxError = (T) 0.0001);
+
+	/**
+		Returns the approximated sigmoid of the input.
+	*/
+	T operator()(const T input) const;
+
+	/**
+		Calculates the outputs for count inputs at once. The outputs
+		are the same as those of operator() (up to rounding), but
+		this function is not virtual and evaluates several inputs at
+		once where possible.
+
+		@param inputs
+			The inputs for which output is sought.
+		@param outputs
+			Receives the outputs. May be the same array as inputs.
+		@param count
+			The number of inputs.
+	*/
+	void evaluate(const T inputs[], T outputs[], size_t count) const;
+
+	/**
+		Returns the number of samples in the table.
+	*/
+	unsigned int getSampleCount() const;
+
+	/**
+		Returns the error bound given to the constructor.
+	*/
+	T getMaxError() const;
+
+private:
+	/**
+		The output samples. The last sample is repeated, as in
+		ResponseCurve.
+	*/
+	std::vector<T> mSamples;
+
+	/** The input at the first sample. */
+	T mTableMin;
+
+	/** The reciprocal of the difference between the inputs at two adjacent samples. */
+	T mScale;
+
+	T mMaxError;
+};
+
+template <class T>
+FastSigmoid<T>::FastSigmoid(T inputMin, T inputMax, T outputMin, T outputMax, T maxError):
+	mMaxError(maxError)
+{
+	//in terms of u = (2 * input - (inputMax + inputMin)) / (inputMax - inputMin),
+	//the sigmoid is outputMin + range / (1 + exp(-u))
+	double range = fabs((double) outputMax - (double) outputMin);
+	double relativeError = range > 0 ? (double) maxError / range : 1.0;
+
+	relativeError = relativeError < 0.5 ? relativeError : 0.5;
+
+	//beyond u = +-uMax, the sigmoid is within relativeError of its asymptotes
+	double uMax = log(1.0 / relativeError);
+
+	//the largest second derivative of 1 / (1 + exp(-u)) is 1 / (6 * sqrt(3))
+	double spacing = sqrt(8.0 * relativeError * 6.0 * sqrt(3.0));
+	unsigned int sampleCount = (unsigned int) ceil(2.0 * uMax / spacing) + 1;
+
+	if(sampleCount < 2)
+	{
+		sampleCount = 2;
+	}
+
+	double center = ((double) inputMax + (double) inputMin) / 2;
+	double halfWidth = ((double) inputMax - (double) inputMin) / 2;
+	double uStep = 2.0 * uMax / (sampleCount - 1);
+
+	mSamples.resize(sampleCount + 1);
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		double u = -uMax + i * uStep;
+
+		mSamples[i] = (T) (outputMin + ((double) outputMax - (double) outputMin) / (1.0 + exp(-u)));
+	}
+
+	mSamples[sampleCount] = mSamples[sampleCount - 1];
+
+	mTableMin = (T) (center - uMax * halfWidth);
+	mScale = (T) (1.0 / (uStep * halfWidth));
+}
+
+template <class T>
+T FastSigmoid<T>::operator()(const T input) const
+{
+	return interpolateSamples(&mSamples[0], (T) (mSamples.size() - 2), mTableMin, mScale, input);
+}
+
+template <class T>
+void FastSigmoid<T>::evaluate(const T inputs[], T outputs[], size_t count) const
+{
+	interpolateSamples(&mSamples[0], (T) (mSamples.size() - 2), mTableMin, mScale, inputs, outputs, count);
+}
+
+template <class T>
+unsigned int FastSigmoid<T>::getSampleCount() const
+{
+	return (unsigned int) mSamples.size() - 1;
+}
+
+template <class T>
+T FastSigmoid<T>::getMaxError() const
+{
+	return mMaxError;
+}
+
+}} //namespace
+
+#endif //_FAST_SIGMOID_H_
@@ -0,0 +1,336 @@
+#ifndef _FILTER_KERNELS_H_
+#define _FILTER_KERNELS_H_
+
+#include <math.h>
+
+#include "utils.h"
+#include "WeightedSum.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	@file
+	Weight kernels for FilteredNumber (see KernelWeights) and
+	KernelFilteredNumber.
+
+	A kernel is a class with
+	-	a static member shape, the WeightShape of its weights; and
+	-	a static function template weight<T, n>(i), that returns the
+		weight of sample i of n samples, where sample 0 is the newest.
+
+	Kernels are only used as template arguments, so their weights are
+	known at compile time. The kernel must also define the weight for
+	i = n, the weight the oldest sample would have one step later.
+*/
+
+/**
+	All weights are 1: a moving average.
+*/
+struct BoxKernel
+{
+	static const WeightShape shape = WEIGHTS_UNIFORM;
+
+	template <class T, unsigned int n>
+	static T weight(unsigned int)
+	{
+		return (T) 1;
+	}
+};
+
+/**
+	Linearly decaying weights: n for the newest sample, down to
+	1 for the oldest.
+*/
+struct TriangleKernel
+{
+	static const WeightShape shape = WEIGHTS_LINEAR;
+
+	template <class T, unsigned int n>
+	static T weight(unsigned int i)
+	{
+		return (T) (n - i);
+	}
+};
+
+/**
+	Exponentially decaying weights, that halve every halfLife samples.
+
+	@param halfLife
+		The number of samples after which the weight is halved.
+		Must be greater than 0.
+*/
+template <unsigned int halfLife>
+struct ExponentialKernel
+{
+	static const WeightShape shape = WEIGHTS_EXPONENTIAL;
+
+	template <class T, unsigned int n>
+	static T weight(unsigned int i)
+	{
+		return (T) pow(0.5, (double) i / halfLife);
+	}
+};
+
+/**
+	The right half of a Gaussian bell, centred on the newest sample.
+	These weights have no special shape, so the sums are recalculated
+	from all samples on every update.
+
+	@param sigma
+		The standard deviation of the bell, in samples.
+		Must be greater than 0.
+*/
+template <unsigned int sigma>
+struct GaussianKernel
+{
+	static const WeightShape shape = WEIGHTS_GENERAL;
+
+	template <class T, unsigned int n>
+	static T weight(unsigned int i)
+	{
+		double x = (double) i / sigma;
+
+		return (T) exp(-0.5 * x * x);
+	}
+};
+
+/**
+	Returns the sum of count samples, starting first samples back from
+	the newest sample, multiplied by the weights of the kernel.
+
+	The recursion unrolls the loop at compile time, so that every
+	weight is a constant. The halves are summed separately (pairwise
+	summation), so that the additions do not form one long chain of
+	dependent instructions.
+
+	This class is used by KernelWeightedSum.
+*/
+template <class Kernel, class T, unsigned int n, unsigned int first, unsigned int count>
+struct KernelDot
+{
+	static T sum(const T samples[], int index)
+	{
+		return KernelDot<Kernel, T, n, first, count / 2>::sum(samples, index)
+			+ KernelDot<Kernel, T, n, first + count / 2, count - count / 2>::sum(samples, index);
+	}
+};
+
+/**
+	Stops the recursion of KernelDot.
+*/
+template <class Kernel, class T, unsigned int n, unsigned int first>
+struct KernelDot<Kernel, T, n, first, 1>
+{
+	static T sum(const T samples[], int index)
+	{
+		return samples[wrapIndex<n>(index - (int) first)] * Kernel::template weight<T, n>(first);
+	}
+};
+
+/**
+	Does what WeightedSum does, for the weights of a kernel.
+
+	The weights and the constants of the constant time updates are
+	compile-time constants, so they need no storage, and only the
+	update for the shape of the kernel is compiled.
+
+	@param n
+		The number of samples in the ring buffer.
+	@param Kernel
+		The kernel that provides the weights, such as BoxKernel.
+*/
+template <class T, unsigned int n, class Kernel>
+class KernelWeightedSum
+{
+private:
+	T mSum;
+
+	/** The sum of all samples, without weights. Used by WEIGHTS_LINEAR. */
+	T mUnweightedSum;
+
+	/**
+		Recalculates the sums from all samples.
+	*/
+	void resum(const T samples[], int index, T zero);
+
+public:
+	/**
+		Constructs a new KernelWeightedSum. The arguments are only
+		there to match WeightedSum, and are ignored.
+	*/
+	KernelWeightedSum(const T weights[] = 0, WeightShape shape = WEIGHTS_DETECT);
+
+	/**
+		See WeightedSum::reset. The weights are ignored.
+	*/
+	T reset(const T samples[], int index, const T weights[], T zero);
+
+	/**
+		See WeightedSum::update. The weights are ignored.
+	*/
+	T update(const T samples[], int index, T oldSample, const T weights[], T zero);
+
+	/**
+		Returns the shape of the kernel.
+	*/
+	WeightShape getShape() const;
+
+	/**
+		See WeightedSum::serialize.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		See WeightedSum::deserialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int n, class Kernel>
+void KernelWeightedSum<T, n, Kernel>::resum(const T samples[], int index, T zero)
+{
+	mSum = zero + KernelDot<Kernel, T, n, 0, n>::sum(samples, index);
+
+	if(Kernel::shape == WEIGHTS_LINEAR)
+	{
+		mUnweightedSum = zero + KernelDot<BoxKernel, T, n, 0, n>::sum(samples, index);
+	}
+}
+
+template <class T, unsigned int n, class Kernel>
+KernelWeightedSum<T, n, Kernel>::KernelWeightedSum(const T[], WeightShape):
+	mSum(0),
+	mUnweightedSum(0)
+{
+}
+
+template <class T, unsigned int n, class Kernel>
+T KernelWeightedSum<T, n, Kernel>::reset(const T samples[], int index, const T[], T zero)
+{
+	resum(samples, index, zero);
+
+	return mSum;
+}
+
+template <class T, unsigned int n, class Kernel>
+T KernelWeightedSum<T, n, Kernel>::update(const T samples[], int index, T oldSample, const T[], T zero)
+{
+	const T first = Kernel::template weight<T, n>(0);
+	const T oldest = Kernel::template weight<T, n>(n);
+	T newSample = samples[index];
+
+	//index 0: resynchronise once per cycle
+	switch(index == 0 ? WEIGHTS_GENERAL : Kernel::shape)
+	{
+	case WEIGHTS_UNIFORM:
+		mSum += first * (newSample - oldSample);
+		break;
+
+	case WEIGHTS_EXPONENTIAL:
+		mSum = mSum * (Kernel::template weight<T, n>(1) / first) + first * newSample - oldest * oldSample;
+		break;
+
+	case WEIGHTS_LINEAR:
+		mSum += first * newSample - (first - Kernel::template weight<T, n>(1)) * mUnweightedSum - oldest * oldSample;
+		mUnweightedSum += newSample - oldSample;
+		break;
+
+	default:
+		resum(samples, index, zero);
+		break;
+	}
+
+	return mSum;
+}
+
+template <class T, unsigned int n, class Kernel>
+WeightShape KernelWeightedSum<T, n, Kernel>::getShape() const
+{
+	return Kernel::shape;
+}
+
+template <class T, unsigned int n, class Kernel>
+void KernelWeightedSum<T, n, Kernel>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mSum);
+	writer.write(mUnweightedSum);
+}
+
+template <class T, unsigned int n, class Kernel>
+bool KernelWeightedSum<T, n, Kernel>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mSum);
+	reader.read(mUnweightedSum);
+
+	return reader.isOk();
+}
+
+/**
+	The weights of a FilteredNumber, given at compile time by a
+	kernel. See ArrayWeights for the members of a source of weights.
+
+	The weights are not stored, and the weighted sums are calculated
+	with a loop that is unrolled at compile time, with constant
+	weights.
+
+	@param n
+		The number of weights.
+	@param Kernel
+		The kernel that provides the weights, such as BoxKernel.
+*/
+template <class T, unsigned int n, class Kernel>
+class KernelWeights
+{
+public:
+	typedef KernelWeightedSum<T, n, Kernel> Sum;
+
+	/**
+		Returns 0; the sums get their weights from the kernel.
+	*/
+	const T * getWeights() const;
+
+	/**
+		Returns the weight of sample i.
+	*/
+	T getWeight(int i) const;
+
+	/**
+		Does nothing; the weights are not stored.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Does nothing; the weights are not stored.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int n, class Kernel>
+const T * KernelWeights<T, n, Kernel>::getWeights() const
+{
+	return 0;
+}
+
+template <class T, unsigned int n, class Kernel>
+T KernelWeights<T, n, Kernel>::getWeight(int i) const
+{
+	return Kernel::template weight<T, n>(i);
+}
+
+template <class T, unsigned int n, class Kernel>
+void KernelWeights<T, n, Kernel>::serialize(SnapshotWriter&) const
+{
+}
+
+template <class T, unsigned int n, class Kernel>
+bool KernelWeights<T, n, Kernel>::deserialize(SnapshotReader& reader)
+{
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_FILTER_KERNELS_H_
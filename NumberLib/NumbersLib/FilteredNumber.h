@@ -1,8 +1,15 @@
 #ifndef _FILTERED_NUMBER_H_
 #define _FILTERED_NUMBER_H_
 
+#include "utils.h"
+#include "WeightedSum.h"
 #include "AbstractFilteredNumber.h"
 
+namespace luma
+{
+namespace numbers
+{
+
 /**
 	A filtered number is a presentation of a 
 	value as a weighted sum of past values. 
@@ -16,18 +23,31 @@
 	@f[
 	y_n = \Psi x_n = \frac{\sum_{i= n - m + 1}^n w_{n - i}x_{n}t_{n}}{\sum_{i = n - m + 1}^nw_{n - i}t_n}
 	@f]
+
+	If the weights are uniform, exponentially decaying, or linearly
+	decaying (see WeightShape), the weighted sums are updated in 
+	constant time instead of being recalculated from all samples.
+	Otherwise, every update takes time proportional to sampleCount.
+
+	@param Weights
+		The source of the weights: ArrayWeights (the default), for
+		weights passed to the constructor, or KernelWeights, for
+		weights given at compile time by a kernel (see
+		FilterKernels.h and KernelFilteredNumber).
 */
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights = ArrayWeights<T, sampleCount> >
 class FilteredNumber : public AbstractFilteredNumber<T, sampleCount, maxOrder>
 {
 private:
 	T mSamples[sampleCount];
-	T mWeights[sampleCount];
+	Weights mWeights;
 	T mTimeSamples[sampleCount];
 	T mInitialValue;
 	T mCurrentValue;
-	FilteredNumber<T, sampleCount, maxOrder - 1>mFilteredValue;
-	CyclicNumber<int> mCurrentIndex;
+	FilteredNumber<T, sampleCount, maxOrder - 1, Weights> mFilteredValue;
+	int mCurrentIndex;
+	typename Weights::Sum mSampleSum;
+	typename Weights::Sum mTimeSum;
 
 public:
 	/**
@@ -37,8 +57,20 @@ public:
 			@param weights
 				The weights with which samples will be multiplied. 
 				The size of the array must be sampleCount.
+			@param shape
+				The shape of the weights. By default, the shape
+				is detected from the weights. Pass WEIGHTS_GENERAL
+				to always recalculate the sums from all samples.
 	*/
-	FilteredNumber(T initialValue, T weights[]);
+	FilteredNumber(T initialValue, T weights[], WeightShape shape = WEIGHTS_DETECT);
+
+	/**
+		Constructs a new filtered number, for a source of
+		weights that needs no arguments, such as KernelWeights.
+			@param initialValue 
+				A zero of type T.
+	*/
+	explicit FilteredNumber(T initialValue);
 
 	/**
 		Gets the filtered value of the given order.
@@ -66,50 +98,93 @@ public:
 		Used for debugging and testing only!
 	*/
 	T getWeight(int i) const;
+
+	/**
+		Returns the shape of the weights that is used
+		to update the weighted sums.
+	*/
+	WeightShape getWeightShape() const;
+
+	/**
+		See UpdateableNumber::process. The outputs are the values
+		of the given order (by default 1), and the number is
+		updated without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		Writes the samples, weights, sums and values of all orders
+		to the snapshot. Every ring buffer is written as one block.
+		See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
-FilteredNumber<T, sampleCount, maxOrder>::FilteredNumber(T initialValue, T weights[]):
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+FilteredNumber<T, sampleCount, maxOrder, Weights>::FilteredNumber(T initialValue, T weights[], WeightShape shape):
+	mWeights(weights),
 	mInitialValue(initialValue),
 	mCurrentValue(initialValue),
-	mFilteredValue(initialValue, weights),
-	mCurrentIndex(0, 0, sampleCount, 1)
+	mFilteredValue(initialValue, weights, shape),
+	mCurrentIndex(0),
+	mSampleSum(weights, shape),
+	mTimeSum(weights, shape)
 {
 
 	for(int i = 0; i < sampleCount; i++)
 	{
 		mSamples[i] = initialValue;
-		mWeights[i] = weights[i];		
 		mTimeSamples[i] = TIME_UNIT;
 	}
+
+	mSampleSum.reset(mSamples, 0, mWeights.getWeights(), mInitialValue);
+	mTimeSum.reset(mTimeSamples, 0, mWeights.getWeights(), 0);
 }
 
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
-void FilteredNumber<T, sampleCount, maxOrder>::setValue(T value, float elapsedTime)
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+FilteredNumber<T, sampleCount, maxOrder, Weights>::FilteredNumber(T initialValue):
+	mInitialValue(initialValue),
+	mCurrentValue(initialValue),
+	mFilteredValue(initialValue),
+	mCurrentIndex(0)
 {
-	mCurrentIndex++;
+	for(int i = 0; i < sampleCount; i++)
+	{
+		mSamples[i] = initialValue;
+		mTimeSamples[i] = TIME_UNIT;
+	}
+
+	mSampleSum.reset(mSamples, 0, mWeights.getWeights(), mInitialValue);
+	mTimeSum.reset(mTimeSamples, 0, mWeights.getWeights(), 0);
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+void FilteredNumber<T, sampleCount, maxOrder, Weights>::setValue(T value, float elapsedTime)
+{
+	mCurrentIndex = wrapIndex<sampleCount>(mCurrentIndex + 1);
 
 	int index = mCurrentIndex;
 	T newValue = value * elapsedTime;
+	T oldValue = mSamples[index];
+	T oldTime = mTimeSamples[index];
 
 	mSamples[index] = newValue;
 	mTimeSamples[index] = elapsedTime;
 	mCurrentValue = value;
 
-	T sum = mInitialValue;
-	float totalTime = 0;
-
-	for(int i = 0; i < sampleCount; i++)
-	{
-		sum += mSamples[(sampleCount + index - i) % sampleCount] * mWeights[i];
-		totalTime += mTimeSamples[(sampleCount + index - i) % sampleCount] * mWeights[i];
-	}
+	T sum = mSampleSum.update(mSamples, index, oldValue, mWeights.getWeights(), mInitialValue);
+	float totalTime = mTimeSum.update(mTimeSamples, index, oldTime, mWeights.getWeights(), 0);
 
 	mFilteredValue.setValue(sum / totalTime, elapsedTime);
 }
 
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
-T FilteredNumber<T, sampleCount, maxOrder>::getValue(unsigned int order) const
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+T FilteredNumber<T, sampleCount, maxOrder, Weights>::getValue(unsigned int order) const
 {
 	if(order == 0)
 	{
@@ -127,16 +202,66 @@ T FilteredNumber<T, sampleCount, maxOrder>::getValue(unsigned int order) const
 
 }
 
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
-T FilteredNumber<T, sampleCount, maxOrder>::getSample(int i) const
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+T FilteredNumber<T, sampleCount, maxOrder, Weights>::getSample(int i) const
 {
 	return mSamples[i];
 }
 
-template <class T, unsigned int sampleCount, unsigned int maxOrder>
-T FilteredNumber<T, sampleCount, maxOrder>::getWeight(int i) const
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+T FilteredNumber<T, sampleCount, maxOrder, Weights>::getWeight(int i) const
 {
-	return mWeights[i];
+	return mWeights.getWeight(i);
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+WeightShape FilteredNumber<T, sampleCount, maxOrder, Weights>::getWeightShape() const
+{
+	return mSampleSum.getShape();
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+void FilteredNumber<T, sampleCount, maxOrder, Weights>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		FilteredNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = FilteredNumber::getValue(order);
+	}
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+void FilteredNumber<T, sampleCount, maxOrder, Weights>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(sampleCount);
+	writer.write(maxOrder);
+	writer.write(mSamples, sampleCount);
+	mWeights.serialize(writer);
+	writer.write(mTimeSamples, sampleCount);
+	writer.write(mInitialValue);
+	writer.write(mCurrentValue);
+	writer.write(mCurrentIndex);
+	mSampleSum.serialize(writer);
+	mTimeSum.serialize(writer);
+	mFilteredValue.serialize(writer);
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Weights>
+bool FilteredNumber<T, sampleCount, maxOrder, Weights>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(sampleCount);
+	reader.expect(maxOrder);
+	reader.read(mSamples, sampleCount);
+	mWeights.deserialize(reader);
+	reader.read(mTimeSamples, sampleCount);
+	reader.read(mInitialValue);
+	reader.read(mCurrentValue);
+	reader.readIndex(mCurrentIndex, sampleCount);
+	mSampleSum.deserialize(reader);
+	mTimeSum.deserialize(reader);
+	mFilteredValue.deserialize(reader);
+
+	return reader.isOk();
 }
 
 /**
@@ -147,24 +272,31 @@ T FilteredNumber<T, sampleCount, maxOrder>::getWeight(int i) const
 	The user of the code needn't know this. 
 	See FilteredNumber<T, sampleCount, maxOrder>.
 */
-template <class T, unsigned int sampleCount>
-class FilteredNumber<T, sampleCount, 1> : public AbstractFilteredNumber<T, sampleCount, 1>
+template <class T, unsigned int sampleCount, class Weights>
+class FilteredNumber<T, sampleCount, 1, Weights> : public AbstractFilteredNumber<T, sampleCount, 1>
 {
 private:
 	T mSamples[sampleCount];
-	T mWeights[sampleCount];
+	Weights mWeights;
 	T mTimeSamples[sampleCount];
 	T mInitialValue;
 	T mCurrentValue;
 	T mFilteredValue;
 
-	CyclicNumber<int> mCurrentIndex;
+	int mCurrentIndex;
+	typename Weights::Sum mSampleSum;
+	typename Weights::Sum mTimeSum;
 
 public:
 	/**
 		See FilteredNumber<T, sampleCount, maxOrder>::FilteredNumber.
 	*/
-	FilteredNumber(T initialValue, T weights[]);
+	FilteredNumber(T initialValue, T weights[], WeightShape shape = WEIGHTS_DETECT);
+
+	/**
+		See FilteredNumber<T, sampleCount, maxOrder>::FilteredNumber.
+	*/
+	explicit FilteredNumber(T initialValue);
 
 	/**
 		See FilteredNumber<T, sampleCount, maxOrder>::getValue.
@@ -185,50 +317,88 @@ public:
 		See FilteredNumber<T, sampleCount, maxOrder>::getWeight.
 	*/
 	T getWeight(int i) const;
+
+	/**
+		See FilteredNumber<T, sampleCount, maxOrder>::getWeightShape.
+	*/
+	WeightShape getWeightShape() const;
+
+	/**
+		See FilteredNumber<T, sampleCount, maxOrder>::process.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		See FilteredNumber<T, sampleCount, maxOrder>::serialize.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		See FilteredNumber<T, sampleCount, maxOrder>::deserialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
-template <class T, unsigned int sampleCount>
-FilteredNumber<T, sampleCount, 1>::FilteredNumber(T initialValue, T weights[]):
+template <class T, unsigned int sampleCount, class Weights>
+FilteredNumber<T, sampleCount, 1, Weights>::FilteredNumber(T initialValue, T weights[], WeightShape shape):
+	mWeights(weights),
+	mInitialValue(initialValue),
+	mCurrentValue(initialValue),
+	mFilteredValue(initialValue),
+	mCurrentIndex(0),
+	mSampleSum(weights, shape),
+	mTimeSum(weights, shape)
+{
+	for(int i = 0; i < sampleCount; i++)
+	{
+		mSamples[i] = initialValue;
+		mTimeSamples[i] = TIME_UNIT;
+	}
+
+	mSampleSum.reset(mSamples, 0, mWeights.getWeights(), mInitialValue);
+	mTimeSum.reset(mTimeSamples, 0, mWeights.getWeights(), 0);
+}
+
+template <class T, unsigned int sampleCount, class Weights>
+FilteredNumber<T, sampleCount, 1, Weights>::FilteredNumber(T initialValue):
 	mInitialValue(initialValue),
 	mCurrentValue(initialValue),
 	mFilteredValue(initialValue),
-	mCurrentIndex(0, 0, sampleCount, 1)
+	mCurrentIndex(0)
 {
 	for(int i = 0; i < sampleCount; i++)
 	{
 		mSamples[i] = initialValue;
-		mWeights[i] = weights[i];
 		mTimeSamples[i] = TIME_UNIT;
 	}
+
+	mSampleSum.reset(mSamples, 0, mWeights.getWeights(), mInitialValue);
+	mTimeSum.reset(mTimeSamples, 0, mWeights.getWeights(), 0);
 }
 
-template <class T, unsigned int sampleCount>
-void FilteredNumber<T, sampleCount, 1>::setValue(T value, float elapsedTime)
+template <class T, unsigned int sampleCount, class Weights>
+void FilteredNumber<T, sampleCount, 1, Weights>::setValue(T value, float elapsedTime)
 {
-	mCurrentIndex++;
+	mCurrentIndex = wrapIndex<sampleCount>(mCurrentIndex + 1);
 
 	int index = mCurrentIndex;
 	T newValue = value * elapsedTime;
+	T oldValue = mSamples[index];
+	T oldTime = mTimeSamples[index];
 
 	mSamples[index] = newValue;
 	mTimeSamples[index] = elapsedTime;
 
 	mCurrentValue = value;
 
-	T sum = mInitialValue;
-	float totalTime = 0;
-
-	for(int i = 0; i < sampleCount; i++)
-	{
-		sum += mSamples[(sampleCount + index - i) % sampleCount] * mWeights[i];
-		totalTime += mTimeSamples[(sampleCount + index - i) % sampleCount] * mWeights[i];
-	}
+	T sum = mSampleSum.update(mSamples, index, oldValue, mWeights.getWeights(), mInitialValue);
+	float totalTime = mTimeSum.update(mTimeSamples, index, oldTime, mWeights.getWeights(), 0);
 
 	mFilteredValue = sum / totalTime;
 }
 
-template <class T, unsigned int sampleCount>
-T FilteredNumber<T, sampleCount, 1>::getValue(unsigned int order) const
+template <class T, unsigned int sampleCount, class Weights>
+T FilteredNumber<T, sampleCount, 1, Weights>::getValue(unsigned int order) const
 {
 	if(order == 0)
 	{
@@ -242,16 +412,66 @@ T FilteredNumber<T, sampleCount, 1>::getValue(unsigned int order) const
 	return mInitialValue;
 }
 
-template <class T, unsigned int sampleCount>
-T FilteredNumber<T, sampleCount, 1>::getSample(int i) const
+template <class T, unsigned int sampleCount, class Weights>
+T FilteredNumber<T, sampleCount, 1, Weights>::getSample(int i) const
 {
 	return mSamples[i];
 }
 
-template <class T, unsigned int sampleCount>
-T FilteredNumber<T, sampleCount, 1>::getWeight(int i) const
+template <class T, unsigned int sampleCount, class Weights>
+T FilteredNumber<T, sampleCount, 1, Weights>::getWeight(int i) const
+{
+	return mWeights.getWeight(i);
+}
+
+template <class T, unsigned int sampleCount, class Weights>
+WeightShape FilteredNumber<T, sampleCount, 1, Weights>::getWeightShape() const
 {
-	return mWeights[i];
+	return mSampleSum.getShape();
+}
+
+template <class T, unsigned int sampleCount, class Weights>
+void FilteredNumber<T, sampleCount, 1, Weights>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		FilteredNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = FilteredNumber::getValue(order);
+	}
+}
+
+template <class T, unsigned int sampleCount, class Weights>
+void FilteredNumber<T, sampleCount, 1, Weights>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(sampleCount);
+	writer.write(1u);
+	writer.write(mSamples, sampleCount);
+	mWeights.serialize(writer);
+	writer.write(mTimeSamples, sampleCount);
+	writer.write(mInitialValue);
+	writer.write(mCurrentValue);
+	writer.write(mCurrentIndex);
+	mSampleSum.serialize(writer);
+	mTimeSum.serialize(writer);
+	writer.write(mFilteredValue);
+}
+
+template <class T, unsigned int sampleCount, class Weights>
+bool FilteredNumber<T, sampleCount, 1, Weights>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(sampleCount);
+	reader.expect(1);
+	reader.read(mSamples, sampleCount);
+	mWeights.deserialize(reader);
+	reader.read(mTimeSamples, sampleCount);
+	reader.read(mInitialValue);
+	reader.read(mCurrentValue);
+	reader.readIndex(mCurrentIndex, sampleCount);
+	mSampleSum.deserialize(reader);
+	mTimeSum.deserialize(reader);
+	reader.read(mFilteredValue);
+
+	return reader.isOk();
 }
 
 /**
@@ -259,21 +479,23 @@ T FilteredNumber<T, sampleCount, 1>::getWeight(int i) const
 	and is merely a wrapper for the last sample passed to 
 	setValue.
 */
-template <class T, unsigned int sampleCount>
-class FilteredNumber<T, sampleCount, 0>: public AbstractFilteredNumber<T, sampleCount, 0>
+template <class T, unsigned int sampleCount, class Weights>
+class FilteredNumber<T, sampleCount, 0, Weights>: public AbstractFilteredNumber<T, sampleCount, 0>
 {
 public:
 	/**
 		See FilteredNumber<T, sampleCount, maxOrder>::FilteredNumber.
 	*/
-	FilteredNumber(T initialValue, T weights[] = 0);
+	FilteredNumber(T initialValue, T weights[] = 0, WeightShape shape = WEIGHTS_DETECT);
 };
 
-template <class T, unsigned int sampleCount>
-FilteredNumber<T, sampleCount, 0>::FilteredNumber(T initialValue, T weights[]):
-	AbstractFilteredNumber(initialValue)
+template <class T, unsigned int sampleCount, class Weights>
+FilteredNumber<T, sampleCount, 0, Weights>::FilteredNumber(T initialValue, T weights[], WeightShape):
+	AbstractFilteredNumber<T, sampleCount, 0>(initialValue)
 {	
 }
 
+}} //namespace
+
 
 #endif //_FILTERED_NUMBER_H_
\ No newline at end of file
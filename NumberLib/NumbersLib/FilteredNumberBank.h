@@ -0,0 +1,310 @@
+#ifndef _FILTERED_NUMBER_BANK_H_
+#define _FILTERED_NUMBER_BANK_H_
+
+#include <vector>
+
+#include "Numbers.h"
+#include "utils.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A FilteredNumberBank holds a large number of filters that
+	behave exactly like FilteredNumber<T, sampleCount, maxOrder>,
+	and updates all of them with a single call.
+
+	All filters in a bank share the same weights, and are updated
+	at the same time with the same elapsed time (typically once
+	per tick). This makes it possible to store the time samples and
+	the ring buffer index only once for the whole bank, and to
+	calculate the weighted time sum only once per update.
+
+	Samples and outputs are stored as a structure of arrays: for
+	every order and every slot in the ring buffer, the values of
+	all filters lie next to each other in memory. The inner loops
+	of setValue run over filters, so that the compiler can
+	vectorise them.
+
+	@code
+	float weights[] = {1, 2, 4, 8};
+	FilteredNumberBank<float, 4, 2> bank(entityCount, 0.0f, weights);
+
+	//every tick
+	bank.setValue(speeds, elapsedTime);
+	const float * smoothedSpeeds = bank.getValues(1);
+	@endcode
+
+	The value bank.getValue(i, order) is the same as the value
+	getValue(order) of a FilteredNumber that received the same
+	sequence of samples as filter i.
+
+	@param T
+		The type that underlies the filters. Typically float.
+	@param sampleCount
+		The number of samples every filter stores (per order).
+	@param maxOrder
+		The highest order that is maintained for every filter.
+
+	@see FilteredNumber
+*/
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+class FilteredNumberBank
+{
+private:
+	/**
+		The number of filters processed together by the inner
+		loops of setValue. This keeps the running sums in the
+		cache while the ring buffer is traversed.
+	*/
+	static const unsigned int BLOCK_SIZE = 256;
+
+	unsigned int mFilterCount;
+	T mInitialValue;
+	T mWeights[sampleCount];
+	T mTimeSamples[sampleCount];
+	int mCurrentIndex;
+
+	/**
+		Samples (multiplied by their elapsed time) of orders
+		0 to maxOrder - 1. The sample of filter i in slot s of
+		order k is at ((k * sampleCount) + s) * mFilterCount + i.
+	*/
+	std::vector<T> mSamples;
+
+	/**
+		Values of orders 0 to maxOrder. The value of filter i
+		of order k is at k * mFilterCount + i.
+	*/
+	std::vector<T> mValues;
+
+	/**
+		Calculates the filtered values of the given order from
+		the samples stored for the order below it.
+	*/
+	void filter(unsigned int order, int index, float totalTime);
+
+public:
+	/**
+		Constructs a new FilteredNumberBank.
+
+		@param filterCount
+			The number of filters in this bank.
+		@param initialValue
+			A zero of type T.
+		@param weights
+			The weights with which samples will be multiplied.
+			The size of the array must be sampleCount.
+	*/
+	FilteredNumberBank(unsigned int filterCount, T initialValue, T weights[]);
+
+	/**
+		Sets the last sample of every filter in this bank.
+
+		@param values
+			The last sample values, one for every filter. The size
+			of the array must be getFilterCount().
+		@param elapsedTime
+			The time elapsed since the last samples were set.
+	*/
+	void setValue(const T values[], float elapsedTime = TIME_UNIT);
+
+	/**
+		Gets the filtered value of the given order for the
+		given filter.
+	*/
+	T getValue(unsigned int filter, unsigned int order = 1) const;
+
+	/**
+		Returns the filtered values of the given order for all
+		filters, or 0 if the order is larger than maxOrder. The
+		returned array is valid until this bank is destroyed.
+	*/
+	const T * getValues(unsigned int order = 1) const;
+
+	/**
+		Returns the number of filters in this bank.
+	*/
+	unsigned int getFilterCount() const;
+
+	/**
+		Used for debugging and testing only!
+	*/
+	T getWeight(int i) const;
+
+	/**
+		Writes the state of all filters to the snapshot. The samples
+		and the values of all filters are each written as one block,
+		so that a bank of any size is written with a few copies. See
+		Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize. The number of filters
+		must be the same.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+FilteredNumberBank<T, sampleCount, maxOrder>::FilteredNumberBank(unsigned int filterCount, T initialValue, T weights[]):
+	mFilterCount(filterCount),
+	mInitialValue(initialValue),
+	mCurrentIndex(0),
+	mSamples(maxOrder * sampleCount * filterCount, initialValue),
+	mValues((maxOrder + 1) * filterCount, initialValue)
+{
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		mWeights[i] = weights[i];
+		mTimeSamples[i] = TIME_UNIT;
+	}
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+void FilteredNumberBank<T, sampleCount, maxOrder>::setValue(const T values[], float elapsedTime)
+{
+	mCurrentIndex = wrapIndex<sampleCount>(mCurrentIndex + 1);
+
+	int index = mCurrentIndex;
+
+	mTimeSamples[index] = elapsedTime;
+
+	//All filters (and all orders) share the time samples,
+	//so the weighted time is the same for all of them.
+	float totalTime = 0;
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		int slot = wrapIndex<sampleCount>(index - (int) i);
+
+		totalTime += mTimeSamples[slot] * mWeights[i];
+	}
+
+	T * currentValues = &mValues[0];
+
+	for(unsigned int j = 0; j < mFilterCount; j++)
+	{
+		currentValues[j] = values[j];
+	}
+
+	for(unsigned int order = 1; order <= maxOrder; order++)
+	{
+		const T * input = &mValues[(order - 1) * mFilterCount];
+		T * samples = &mSamples[((order - 1) * sampleCount + index) * mFilterCount];
+
+		for(unsigned int j = 0; j < mFilterCount; j++)
+		{
+			samples[j] = input[j] * elapsedTime;
+		}
+
+		filter(order, index, totalTime);
+	}
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+void FilteredNumberBank<T, sampleCount, maxOrder>::filter(unsigned int order, int index, float totalTime)
+{
+	const T * samples = &mSamples[(order - 1) * sampleCount * mFilterCount];
+	T * output = &mValues[order * mFilterCount];
+
+	for(unsigned int blockStart = 0; blockStart < mFilterCount; blockStart += BLOCK_SIZE)
+	{
+		unsigned int blockEnd = min(blockStart + BLOCK_SIZE, mFilterCount);
+
+		for(unsigned int j = blockStart; j < blockEnd; j++)
+		{
+			output[j] = mInitialValue;
+		}
+
+		for(unsigned int i = 0; i < sampleCount; i++)
+		{
+			int slot = wrapIndex<sampleCount>(index - (int) i);
+
+			const T * slotSamples = samples + slot * mFilterCount;
+			const T weight = mWeights[i];
+
+			for(unsigned int j = blockStart; j < blockEnd; j++)
+			{
+				output[j] += slotSamples[j] * weight;
+			}
+		}
+
+		for(unsigned int j = blockStart; j < blockEnd; j++)
+		{
+			output[j] = output[j] / totalTime;
+		}
+	}
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+T FilteredNumberBank<T, sampleCount, maxOrder>::getValue(unsigned int filter, unsigned int order) const
+{
+	if(order <= maxOrder)
+	{
+		return mValues[order * mFilterCount + filter];
+	}
+
+	return mInitialValue;
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+const T * FilteredNumberBank<T, sampleCount, maxOrder>::getValues(unsigned int order) const
+{
+	if(order <= maxOrder && mFilterCount > 0)
+	{
+		return &mValues[order * mFilterCount];
+	}
+
+	return 0;
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+unsigned int FilteredNumberBank<T, sampleCount, maxOrder>::getFilterCount() const
+{
+	return mFilterCount;
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+T FilteredNumberBank<T, sampleCount, maxOrder>::getWeight(int i) const
+{
+	return mWeights[i];
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+void FilteredNumberBank<T, sampleCount, maxOrder>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(sampleCount);
+	writer.write(maxOrder);
+	writer.write(mFilterCount);
+	writer.write(mInitialValue);
+	writer.write(mWeights, sampleCount);
+	writer.write(mTimeSamples, sampleCount);
+	writer.write(mCurrentIndex);
+	writer.write(mSamples);
+	writer.write(mValues);
+}
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+bool FilteredNumberBank<T, sampleCount, maxOrder>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(sampleCount);
+	reader.expect(maxOrder);
+	reader.expect(mFilterCount);
+	reader.read(mInitialValue);
+	reader.read(mWeights, sampleCount);
+	reader.read(mTimeSamples, sampleCount);
+	reader.readIndex(mCurrentIndex, sampleCount);
+	reader.read(mSamples);
+	reader.read(mValues);
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_FILTERED_NUMBER_BANK_H_
@@ -0,0 +1,258 @@
+#ifndef _FIXED_H_
+#define _FIXED_H_
+
+#include "utils.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A signed fixed point number in Qm.n format: a 32-bit integer that
+	counts units of 2^-fractionBits, so that m = 32 - fractionBits bits
+	(including the sign) are left for the integer part.
+
+	Fixed can be used as the type of ClampedNumber, CyclicNumber,
+	PingPongNumber and BufferedNumber, for simulations that must give
+	bit-identical results on all machines (for example, lockstep
+	networked games):
+
+	@code
+	ClampedNumber<Fixed16> position(Fixed16(0), Fixed16(-10), Fixed16(10), Fixed16(0.25f));
+
+	position.inc(elapsedTime);
+	@endcode
+
+	All arithmetic is done on integers. Results only depend on the
+	operands, and not on the compiler, its settings or the FPU. The
+	only floating point operation is the rounding of floats to fixed
+	point (see the float constructor), which is exact as long as the
+	value fits; the elapsed times passed to inc and dec are converted
+	this way (see scaleByTime).
+
+	Products are rounded down, quotients are rounded towards 0, and
+	results that do not fit overflow as int does.
+
+	@param fractionBits
+		The number of bits after the binary point, between 1 and 30.
+*/
+template <unsigned int fractionBits>
+class Fixed
+{
+private:
+	int mRaw;
+
+public:
+	/**
+		The raw value of 1.
+	*/
+	static const int ONE = 1 << fractionBits;
+
+	/**
+		Constructs a new Fixed with value 0.
+	*/
+	Fixed();
+
+	/**
+		Constructs a new Fixed with the given integer value. This
+		constructor is implicit, so that integer constants (such as
+		the 2 in 2 * x) can be used in expressions with Fixed.
+	*/
+	Fixed(int value);
+
+	/**
+		Constructs a new Fixed with the given value rounded to the
+		nearest multiple of 2^-fractionBits (halves are rounded away
+		from 0).
+	*/
+	explicit Fixed(float value);
+
+	/**
+		See Fixed(float).
+	*/
+	explicit Fixed(double value);
+
+	/**
+		Returns the Fixed whose raw value is the given integer,
+		that is, with value raw * 2^-fractionBits.
+	*/
+	static Fixed fromRaw(int raw);
+
+	/**
+		Returns the raw integer value of this Fixed, that is,
+		its value * 2^fractionBits.
+	*/
+	int getRaw() const;
+
+	/**
+		Returns the value of this Fixed as a float. The float is
+		rounded if the value has more than 24 significant bits.
+	*/
+	float toFloat() const;
+
+	/**
+		Returns the value of this Fixed as a double. This is always exact.
+	*/
+	double toDouble() const;
+
+	/**
+		Returns the integer part of the value of this Fixed,
+		rounded down.
+	*/
+	int toInt() const;
+
+	Fixed operator-() const;
+
+	Fixed& operator+=(const Fixed& other);
+	Fixed& operator-=(const Fixed& other);
+	Fixed& operator*=(const Fixed& other);
+	Fixed& operator/=(const Fixed& other);
+
+	friend Fixed operator+(Fixed a, const Fixed& b) { return a += b; }
+	friend Fixed operator-(Fixed a, const Fixed& b) { return a -= b; }
+	friend Fixed operator*(Fixed a, const Fixed& b) { return a *= b; }
+	friend Fixed operator/(Fixed a, const Fixed& b) { return a /= b; }
+
+	friend bool operator==(const Fixed& a, const Fixed& b) { return a.mRaw == b.mRaw; }
+	friend bool operator!=(const Fixed& a, const Fixed& b) { return a.mRaw != b.mRaw; }
+	friend bool operator<(const Fixed& a, const Fixed& b) { return a.mRaw < b.mRaw; }
+	friend bool operator<=(const Fixed& a, const Fixed& b) { return a.mRaw <= b.mRaw; }
+	friend bool operator>(const Fixed& a, const Fixed& b) { return a.mRaw > b.mRaw; }
+	friend bool operator>=(const Fixed& a, const Fixed& b) { return a.mRaw >= b.mRaw; }
+};
+
+/**
+	Q16.16: 16 integer bits (including the sign), and 16 fraction bits.
+	Values lie between -32768 and 32768, in steps of 1/65536.
+*/
+typedef Fixed<16> Fixed16;
+
+/**
+	Returns dividend / divisor rounded towards 0, as a whole Fixed
+	number. The raw values are divided directly, so no precision is
+	lost. See truncatedQuotient in utils.h; mod uses this overload for
+	Fixed numbers.
+*/
+template <unsigned int fractionBits>
+inline Fixed<fractionBits> truncatedQuotient(const Fixed<fractionBits>& dividend, const Fixed<fractionBits>& divisor)
+{
+	return Fixed<fractionBits>(dividend.getRaw() / divisor.getRaw());
+}
+
+/**
+	See scaleByTime in utils.h. The elapsed time and time scale are
+	rounded to fixed point, and the value is scaled with integer
+	multiplications, so that the result is the same on every machine.
+*/
+template <unsigned int fractionBits>
+inline Fixed<fractionBits> scaleByTime(const Fixed<fractionBits>& value, float elapsedTime, float timeScale)
+{
+	return value * Fixed<fractionBits>(elapsedTime) * Fixed<fractionBits>(timeScale);
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>::Fixed():
+	mRaw(0)
+{
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>::Fixed(int value):
+	mRaw(value * ONE)
+{
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>::Fixed(float value)
+{
+	//float to double and the multiplication by a power of two are exact
+	double scaled = (double) value * ONE;
+
+	mRaw = (int) (scaled >= 0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>::Fixed(double value)
+{
+	double scaled = value * ONE;
+
+	mRaw = (int) (scaled >= 0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits> Fixed<fractionBits>::fromRaw(int raw)
+{
+	Fixed<fractionBits> fixed;
+
+	fixed.mRaw = raw;
+
+	return fixed;
+}
+
+template <unsigned int fractionBits>
+int Fixed<fractionBits>::getRaw() const
+{
+	return mRaw;
+}
+
+template <unsigned int fractionBits>
+float Fixed<fractionBits>::toFloat() const
+{
+	return (float) toDouble();
+}
+
+template <unsigned int fractionBits>
+double Fixed<fractionBits>::toDouble() const
+{
+	return (double) mRaw / ONE;
+}
+
+template <unsigned int fractionBits>
+int Fixed<fractionBits>::toInt() const
+{
+	//arithmetic shift: rounds down, also for negative numbers
+	return mRaw >> fractionBits;
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits> Fixed<fractionBits>::operator-() const
+{
+	return fromRaw(-mRaw);
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>& Fixed<fractionBits>::operator+=(const Fixed& other)
+{
+	mRaw += other.mRaw;
+
+	return *this;
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>& Fixed<fractionBits>::operator-=(const Fixed& other)
+{
+	mRaw -= other.mRaw;
+
+	return *this;
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>& Fixed<fractionBits>::operator*=(const Fixed& other)
+{
+	mRaw = (int) (((long long) mRaw * other.mRaw) >> fractionBits);
+
+	return *this;
+}
+
+template <unsigned int fractionBits>
+Fixed<fractionBits>& Fixed<fractionBits>::operator/=(const Fixed& other)
+{
+	mRaw = (int) ((long long) mRaw * ONE / other.mRaw);
+
+	return *this;
+}
+
+}} //namespace
+
+#endif //_FIXED_H_
@@ -1,7 +1,7 @@
 #ifndef _INTEGRABLE_NUMBER_H_
 #define _INTEGRABLE_NUMBER_H_
 
-#include "CyclicNumber.h"
+#include "utils.h"
 #include "AbstractFilteredNumber.h"
 
 namespace luma
@@ -18,6 +18,12 @@ namespace numbers
 	
 	This class complements the DifferentiableNumber class.
 
+	All orders are updated in one pass, with a single ring buffer index.
+	The samples of the different orders that are replaced in one update
+	lie next to each other in memory, and only the highest order keeps
+	time samples (the lower orders always integrate over TIME_UNIT per
+	sample after the first).
+
 	@param T
 		The type that underlies this IntegrableNumber. Typically float.
 	@param m
@@ -29,16 +35,30 @@ template <class T, unsigned int sampleCount, unsigned int maxOrder>
 class IntegrableNumber: public AbstractFilteredNumber<T, sampleCount, maxOrder>
 {
 private:
-	T mSamples[sampleCount];	
-	float mTimeSamples[sampleCount];
+	/**
+		The samples of all orders. The sample of order k (that is,
+		the integral of order k, multiplied by its elapsed time) in
+		slot i is mSamples[i][k], so that one update touches only
+		one row.
+	*/
+	T mSamples[sampleCount][maxOrder];
+
+	/**
+		The time samples of the highest order. The lower orders
+		never update their time samples, which stay TIME_UNIT.
+	*/
+	T mTimeSamples[sampleCount];
+
+	/** The integrals of orders 1 to maxOrder. */
+	T mSums[maxOrder];
+
+	/** The total time over which every order is integrated. */
+	float mTotalTimes[maxOrder];
 
-	CyclicNumber<int> mCurrentIndex;	
+	int mCurrentIndex;
 	T mCurrentValue;
 	T mInitialValue;
 
-	IntegrableNumber<T, sampleCount, maxOrder - 1> mSum;
-	float mTotalTime;
-
 public:
 	/**
 		@param initialValue 
@@ -81,62 +101,115 @@ public:
 		production code. 
 	*/
 	T getSample(int i) const;
+
+	/**
+		See UpdateableNumber::process. The outputs are the values
+		of the given order (by default 1), and the number is
+		updated without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		Writes the samples, integrals and values to the snapshot.
+		The ring buffer of all orders is written as one block. See
+		Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <class T, unsigned int sampleCount, unsigned int maxOrder>
 IntegrableNumber<T, sampleCount, maxOrder>::IntegrableNumber(T initialValue):
-	mInitialValue(initialValue),
+	mCurrentIndex(0),
 	mCurrentValue(initialValue),
-	mCurrentIndex(0, 0, sampleCount, 1),
-	mSum(initialValue),
-	mTotalTime(sampleCount * TIME_UNIT)
+	mInitialValue(initialValue)
 {
-	for(int i = 0; i < sampleCount; i++)
+	for(unsigned int i = 0; i < sampleCount; i++)
 	{
-		mSamples[i] = initialValue;
+		for(unsigned int order = 0; order < maxOrder; order++)
+		{
+			mSamples[i][order] = initialValue;
+		}
+
 		mTimeSamples[i] = TIME_UNIT;
 	}
+
+	for(unsigned int order = 0; order < maxOrder; order++)
+	{
+		mSums[order] = initialValue;
+		mTotalTimes[order] = sampleCount * TIME_UNIT;
+	}
 }
 
 template <class T, unsigned int sampleCount, unsigned int maxOrder>
 void IntegrableNumber<T, sampleCount, maxOrder>::setValue(T x, float elapsedTime)
 {
-	T sum = mSum.getValue(0);
-
-	mCurrentIndex++;
+	mCurrentIndex = wrapIndex<sampleCount>(mCurrentIndex + 1);
 
 	int index = mCurrentIndex;
-	T newValue = x * elapsedTime;
+	T * samples = mSamples[index];
+	T input = x;
+	float time = elapsedTime;
+
+	//Only the first order takes the elapsed time into account
+	//(higher orders integrate over a time of 1 per sample), and
+	//only the last order updates its time samples.
+	for(unsigned int order = 0; order < maxOrder; order++)
+	{
+		if(order == maxOrder - 1)
+		{
+			mTotalTimes[order] += time - mTimeSamples[index];
+			mTimeSamples[index] = time;
+		}
+		else
+		{
+			mTotalTimes[order] += time - TIME_UNIT;
+		}
 
-	mTotalTime += elapsedTime - mTimeSamples[index];
-	sum += (newValue - mSamples[index]) / mTotalTime;	
+		T newValue = input * time;
 
-	mSum.setValue(sum);	
+		mSums[order] += (newValue - samples[order]) / mTotalTimes[order];
+		samples[order] = newValue;
 
-	mSamples[index] = newValue;
-	mCurrentValue = x;
+		input = mSums[order];
+		time = 1.0f;
+	}
 
+	mCurrentValue = x;
 }
 
 template <class T, unsigned int sampleCount, unsigned int maxOrder>
 void IntegrableNumber<T, sampleCount, maxOrder>::forceValue(T x, float elapsedTime)
 {
-	
-	T newValue = x * elapsedTime;	// we do not have to multiply by the framerate
-									// because we divide by the total time later
+	T input = x;
+
+	for(unsigned int order = 0; order < maxOrder; order++)
+	{
+		T newValue = input * elapsedTime;	// we do not have to multiply by the framerate
+											// because we divide by the total time later
+		T sum = mInitialValue;
 
-	T sum = mInitialValue;
+		for(unsigned int i = 0; i < sampleCount; i++)
+		{
+			mSamples[i][order] = newValue;
+			sum += newValue;
+		}
 
-	for(int i = 0; i < sampleCount; i++)
+		mTotalTimes[order] = sampleCount * elapsedTime;
+		mSums[order] = sum / mTotalTimes[order];
+
+		input = mSums[order];
+	}
+
+	for(unsigned int i = 0; i < sampleCount; i++)
 	{
-		mSamples[i] = newValue;
-		sum += newValue;
+		mTimeSamples[i] = elapsedTime;
 	}
 
-	mTotalTime = sampleCount * elapsedTime;
-	
-	mSum.forceValue(sum / mTotalTime, elapsedTime);
-	
 	mCurrentValue = x;
 }
 
@@ -147,137 +220,58 @@ T IntegrableNumber<T, sampleCount, maxOrder>::getValue(unsigned int order) const
 	{
 		return mCurrentValue;
 	}
-	else if(order > 0)
+	else if(order <= maxOrder)
 	{
-		if(order <= maxOrder)
-		{
-			return mSum.getValue(order - 1);
-		}
+		return mSums[order - 1];
 	}
 
 	return mInitialValue;
-
 }
 
 template <class T, unsigned int sampleCount, unsigned int maxOrder>
 T IntegrableNumber<T, sampleCount, maxOrder>::getSample(int i) const
 {
-	return mSamples[i % sampleCount];
+	return mSamples[i % sampleCount][0];
 }
 
-/**
-	This is the stop class for the recursive template definition of
-	IntegrableNumber. All the methods work the same as
-	IntegrableNumber - see the documentation there.
-*/
-template <class T, unsigned int sampleCount>
-class IntegrableNumber<T, sampleCount, 1>: public AbstractFilteredNumber<T, sampleCount, 1>
-{
-private:
-	T mSamples[sampleCount];	
-	T mTimeSamples[sampleCount];	
-	CyclicNumber<int> mCurrentIndex;	
-	T mCurrentValue;
-	T mInitialValue;
-	T mSum;
-	float mTotalTime;
-
-public:
-	/**
-		@see IntegrableNumber<T, sampleCount, n>::IntegrableNumber()
-	*/
-	IntegrableNumber(T initialValue);
-
-	/**
-		@see IntegrableNumber<T, sampleCount, n>::setValue()
-	*/
-	void setValue(T x, float elapsedTime = 1.0f);
-
-	/**
-		@see IntegrableNumber<T, sampleCount, n>::getValue()
-	*/
-	T getValue(unsigned int order) const;
-
-	T getSample(int i) const;
-
-	void forceValue(T x, float elapsedTime = 1.0f);
-};
-
-template <class T, unsigned int sampleCount>
-IntegrableNumber<T, sampleCount, 1>::IntegrableNumber(T initialValue):
-	mInitialValue(initialValue),
-	mCurrentValue(initialValue),
-	mCurrentIndex(0, 0, sampleCount, 1),
-	mSum(initialValue),
-	mTotalTime(sampleCount * TIME_UNIT)
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+void IntegrableNumber<T, sampleCount, maxOrder>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
 {
-	for(int i = 0; i < sampleCount; i++)
+	for(size_t i = 0; i < count; i++)
 	{
-		mSamples[i] = initialValue;
-		mTimeSamples[i] = TIME_UNIT;
+		IntegrableNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = IntegrableNumber::getValue(order);
 	}
 }
 
-template <class T, unsigned int sampleCount>
-void IntegrableNumber<T, sampleCount, 1>::setValue(T x, float elapsedTime)
-{
-	mCurrentIndex++;
-
-	int index = mCurrentIndex;
-
-	T newValue = x * elapsedTime;
-
-	mTotalTime += elapsedTime - mTimeSamples[index];
-	mSum += (newValue - mSamples[index]) / mTotalTime;
-	
-
-	mSamples[index] = newValue;
-	mTimeSamples[index] = elapsedTime;
-
-	mCurrentValue = x;
-}
-
-template <class T, unsigned int sampleCount>
-void IntegrableNumber<T, sampleCount, 1>::forceValue(T x, float elapsedTime)
-{
-	T newValue = x * elapsedTime;
-
-	mSum = mInitialValue; //zero
-
-	for(int i = 0; i < sampleCount; i++)
-	{
-		mSamples[i] = newValue;
-		mTimeSamples[i] = elapsedTime;
-
-		mSum += newValue;		
-	}	
-
-	mTotalTime = sampleCount * elapsedTime;
-	mSum /= mTotalTime;
-
-
-	mCurrentValue = x;
-}
-
-template <class T, unsigned int sampleCount>
-T IntegrableNumber<T, sampleCount, 1>::getValue(unsigned int order) const
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+void IntegrableNumber<T, sampleCount, maxOrder>::serialize(SnapshotWriter& writer) const
 {
-	if(order == 0)
-	{
-		return mCurrentValue;
-	}
-	else if(order == 1)
-	{
-		return mSum;
-	}
-
-	return mInitialValue;
+	writer.write(sampleCount);
+	writer.write(maxOrder);
+	writer.write(&mSamples[0][0], sampleCount * maxOrder);
+	writer.write(mTimeSamples, sampleCount);
+	writer.write(mSums, maxOrder);
+	writer.write(mTotalTimes, maxOrder);
+	writer.write(mCurrentIndex);
+	writer.write(mCurrentValue);
+	writer.write(mInitialValue);
 }
 
-template <class T, unsigned int sampleCount>
-T IntegrableNumber<T, sampleCount, 1>::getSample(int i) const
+template <class T, unsigned int sampleCount, unsigned int maxOrder>
+bool IntegrableNumber<T, sampleCount, maxOrder>::deserialize(SnapshotReader& reader)
 {
-	return mSamples[i % sampleCount];
+	reader.expect(sampleCount);
+	reader.expect(maxOrder);
+	reader.read(&mSamples[0][0], sampleCount * maxOrder);
+	reader.read(mTimeSamples, sampleCount);
+	reader.read(mSums, maxOrder);
+	reader.read(mTotalTimes, maxOrder);
+	reader.readIndex(mCurrentIndex, sampleCount);
+	reader.read(mCurrentValue);
+	reader.read(mInitialValue);
+
+	return reader.isOk();
 }
 
 /**
@@ -294,7 +288,7 @@ public:
 
 template <class T, unsigned int sampleCount>
 IntegrableNumber<T, sampleCount, 0>::IntegrableNumber(T initialValue):
-	AbstractFilteredNumber(initialValue)
+	AbstractFilteredNumber<T, sampleCount, 0>(initialValue)
 {
 }
 
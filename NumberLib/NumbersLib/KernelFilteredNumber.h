@@ -0,0 +1,59 @@
+#ifndef _KERNEL_FILTERED_NUMBER_H_
+#define _KERNEL_FILTERED_NUMBER_H_
+
+#include "utils.h"
+#include "FilterKernels.h"
+#include "FilteredNumber.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A FilteredNumber whose weights are given at compile time by a
+	kernel (see FilterKernels.h), instead of by an array passed to
+	the constructor. This is a FilteredNumber with KernelWeights,
+	with a shorter name.
+
+	The weights are not stored in every instance, and the weighted
+	sums are calculated with a loop that is unrolled at compile time,
+	with constant weights. As with FilteredNumber, the sums of
+	kernels with a special WeightShape are updated in constant time.
+
+	@code
+	KernelFilteredNumber<float, 16, 2, GaussianKernel<4> > position(0.0f);
+
+	position.setValue(x, elapsedTime);
+	float smoothPosition = position.getValue(1);
+	@endcode
+
+	@param Kernel
+		The kernel that provides the weights: BoxKernel,
+		TriangleKernel, ExponentialKernel, GaussianKernel, or a
+		class with the same members.
+
+	@see FilteredNumber
+*/
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Kernel>
+class KernelFilteredNumber : public FilteredNumber<T, sampleCount, maxOrder, KernelWeights<T, sampleCount, Kernel> >
+{
+public:
+	/**
+		Constructs a new filtered number.
+
+		@param initialValue
+			A zero of type T.
+	*/
+	KernelFilteredNumber(T initialValue);
+};
+
+template <class T, unsigned int sampleCount, unsigned int maxOrder, class Kernel>
+KernelFilteredNumber<T, sampleCount, maxOrder, Kernel>::KernelFilteredNumber(T initialValue):
+	FilteredNumber<T, sampleCount, maxOrder, KernelWeights<T, sampleCount, Kernel> >(initialValue)
+{
+}
+
+}} //namespace
+
+#endif //_KERNEL_FILTERED_NUMBER_H_
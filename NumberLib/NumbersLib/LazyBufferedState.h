@@ -0,0 +1,266 @@
+#ifndef _LAZY_BUFFERED_STATE_H_
+#define _LAZY_BUFFERED_STATE_H_
+
+#include "Numbers.h"
+#include "utils.h"
+#include "Clock.h"
+#include "UpdateableNumber.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A BufferedState whose updates take constant time, regardless
+	of the number of states.
+
+	BufferedState::setValue increments the value of one state and
+	decrements the values of all the others. This class instead adds
+	the decrement to a single decay that all states share, and
+	stores for every state its value and the decay at the time the
+	value was stored. The value of a state is calculated (and
+	clamped to 0) only when it is needed, which is when the state
+	is set.
+
+	The states behave like those of a BufferedState with the same
+	arguments: the values of the states and the triggered states are
+	the same, up to rounding. (Subtracting the sum of several
+	decrements can round differently than subtracting them one by
+	one. When the increments and elapsed times are multiples of
+	powers of two, as in 0.125f, there is no rounding, and the
+	results are exactly the same.)
+
+	The decay is kept in double precision. Before it grows so large
+	that the rounding of the values would suffer, the values of all
+	states are stored and the decay starts from 0 again; this costs
+	O(n) time once every REBASE_DECAY / increment updates.
+
+	Elapsed times should not be negative.
+
+	@param n
+		The number of states.
+
+	@see BufferedState
+*/
+template <unsigned int n>
+class LazyBufferedState : public UpdateableNumber<unsigned int>
+{
+public:
+	/**
+		The decay at which the values of all states are stored, and
+		the decay starts from 0 again.
+	*/
+	static const int REBASE_DECAY = 1 << 16;
+
+private:
+	/** The value of every state when it was last stored. */
+	float mStateValues[n];
+
+	/** The decay when the value of every state was last stored. */
+	double mStateDecays[n];
+
+	float mThresholds[n];
+
+	/** The sum of the decrements of all updates so far. */
+	double mDecay;
+
+	float mIncrement;
+
+	/** The largest value of a state (1 - increment, as in BufferedState). */
+	float mMaxValue;
+
+	unsigned int mState;
+
+	/**
+		Stores the values of all states, and sets the decay to 0.
+	*/
+	void rebase();
+
+public:
+	/**
+		Initialises a new LazyBufferedState. The arguments are the
+		same as those of BufferedState::BufferedState.
+	*/
+	LazyBufferedState(unsigned int initialState, float stateValues[], float thresholds[], float increment);
+
+	/**
+		See BufferedState::setValue.
+	*/
+	void setValue(unsigned int state, float ellapsedTime = 1);
+
+	/**
+		Updates this buffered state like setValue, and returns whether
+		the state returned by getValue() changed. Unlike setValue, this
+		function is not virtual.
+	*/
+	bool update(unsigned int state, float ellapsedTime = TIME_UNIT);
+
+	/**
+		Returns the last triggered state.
+	*/
+	unsigned int getValue() const;
+
+	/**
+		Returns the value of state i, which triggers the state
+		when it rises above the threshold of the state.
+	*/
+	float getStateValue(unsigned int i) const;
+
+	/**
+		Forces the state to the given state.
+	*/
+	void forceValue(int state);
+
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const unsigned int values[], const float elapsedTimes[], unsigned int outputs[], size_t count);
+
+	/**
+		Writes the state values, thresholds and the triggered state
+		to the snapshot, in the same format as BufferedState<n>. See
+		Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize, or by
+		BufferedState<n>::serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <unsigned int n>
+LazyBufferedState<n>::LazyBufferedState(unsigned int initialState, float stateValues[], float thresholds[], float increment):
+	mDecay(0),
+	mIncrement(increment),
+	mMaxValue(1.0f - increment),
+	mState(initialState)
+{
+	for (unsigned int i = 0; i < n; i++)
+	{
+		mStateValues[i] = clamp(stateValues[i], 0.0f, mMaxValue);
+		mStateDecays[i] = 0;
+		mThresholds[i] = thresholds[i];
+	}
+}
+
+template <unsigned int n>
+void LazyBufferedState<n>::rebase()
+{
+	for (unsigned int i = 0; i < n; i++)
+	{
+		mStateValues[i] = getStateValue(i);
+		mStateDecays[i] = 0;
+	}
+
+	mDecay = 0;
+}
+
+template <unsigned int n>
+void LazyBufferedState<n>::setValue(unsigned int state, float ellapsedTime)
+{
+	update(state, ellapsedTime);
+}
+
+template <unsigned int n>
+bool LazyBufferedState<n>::update(unsigned int state, float ellapsedTime)
+{
+	unsigned int oldState = mState;
+	float step = scaleByTime(mIncrement, ellapsedTime, DefaultClock::timeScale());
+	float value = clamp(getStateValue(state) + step, 0.0f, mMaxValue);
+
+	//all other states are decremented by step
+	mDecay += step;
+
+	mStateValues[state] = value;
+	mStateDecays[state] = mDecay;
+
+	if(value > mThresholds[state])
+		mState = state;
+
+	if(mDecay >= REBASE_DECAY)
+		rebase();
+
+	return mState != oldState;
+}
+
+template <unsigned int n>
+unsigned int LazyBufferedState<n>::getValue() const
+{
+	return mState;
+}
+
+template <unsigned int n>
+float LazyBufferedState<n>::getStateValue(unsigned int i) const
+{
+	float value = mStateValues[i] - (float) (mDecay - mStateDecays[i]);
+
+	return value > 0.0f ? value : 0.0f;
+}
+
+template <unsigned int n>
+void LazyBufferedState<n>::forceValue(int state)
+{
+	mState = state;
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		mStateValues[i] = ((int) i == state ? mMaxValue : 0.0f);
+		mStateDecays[i] = mDecay;
+	}
+}
+
+template <unsigned int n>
+void LazyBufferedState<n>::process(const unsigned int values[], const float elapsedTimes[], unsigned int outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		update(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = mState;
+	}
+}
+
+template <unsigned int n>
+void LazyBufferedState<n>::serialize(SnapshotWriter& writer) const
+{
+	float stateValues[n];
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		stateValues[i] = getStateValue(i);
+	}
+
+	writer.write(n);
+	writer.write(mIncrement);
+	writer.write(stateValues, n);
+	writer.write(mThresholds, n);
+	writer.write(mState);
+}
+
+template <unsigned int n>
+bool LazyBufferedState<n>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(n);
+	reader.read(mIncrement);
+	reader.read(mStateValues, n);
+	reader.read(mThresholds, n);
+	reader.readIndex(mState, n);
+
+	mMaxValue = 1.0f - mIncrement;
+	mDecay = 0;
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		mStateDecays[i] = 0;
+	}
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_LAZY_BUFFERED_STATE_H_
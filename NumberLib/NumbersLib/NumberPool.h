@@ -0,0 +1,413 @@
+#ifndef _NUMBER_POOL_H_
+#define _NUMBER_POOL_H_
+
+#include <stddef.h>
+#include <new>
+#include <vector>
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	Identifies a number in a NumberPool. A handle stays valid until
+	its number is destroyed; after that, the pool recognises it as
+	stale, even when the memory of the number has been reused.
+
+	A default constructed handle is never valid.
+*/
+struct NumberHandle
+{
+	/** The index of the memory of the number in its pool. */
+	unsigned int slot;
+
+	/** The generation of the slot when the number was created. */
+	unsigned int generation;
+
+	NumberHandle():
+		slot(0),
+		generation(0)
+	{
+	}
+
+	NumberHandle(unsigned int slot, unsigned int generation):
+		slot(slot),
+		generation(generation)
+	{
+	}
+};
+
+/**
+	Holds large numbers of numbers of one type, such as
+	FilteredNumber<float, 16, 2>, in slabs of slabSize numbers.
+
+	@code
+	NumberPool<FilteredNumber<float, 16, 2> > pool;
+
+	NumberHandle handle = pool.create(FilteredNumber<float, 16, 2>(0.0f, weights));
+
+	pool.get(handle)->setValue(speed);
+
+	for(NumberPool<FilteredNumber<float, 16, 2> >::Iterator i = pool.begin(); i != pool.end(); ++i)
+	{
+		i->setValue(getInput(i.getHandle()));
+	}
+
+	pool.destroy(handle);
+	@endcode
+
+	The numbers of a slab lie next to each other, and every slab
+	starts on a cache line, so iterating over the pool walks memory
+	in order. Numbers never move: handles and pointers to numbers
+	stay valid until the number is destroyed.
+
+	Creating and destroying a number takes constant time. The memory
+	of destroyed numbers is reused (the most recently freed first)
+	before a new slab is allocated, so the memory of the pool never
+	grows beyond the most numbers it has held at once. Slabs are only
+	released by the destructor.
+
+	@param Number
+		The type of the numbers. It must be copy constructible, and
+		its alignment must not exceed CACHE_LINE_SIZE.
+	@param slabSize
+		The number of numbers in a slab. A power of two makes finding
+		the slab of a number cheaper.
+*/
+template <class Number, unsigned int slabSize = 256>
+class NumberPool
+{
+public:
+	/**
+		The alignment of the slabs in bytes.
+	*/
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	/**
+		Visits the numbers of a pool in the order of their memory,
+		skipping destroyed numbers.
+	*/
+	class Iterator
+	{
+	private:
+		NumberPool * mPool;
+		unsigned int mSlot;
+
+		void skipFree();
+
+	public:
+		Iterator(NumberPool * pool, unsigned int slot);
+
+		Number& operator*() const;
+		Number * operator->() const;
+		Iterator& operator++();
+		bool operator==(const Iterator& other) const;
+		bool operator!=(const Iterator& other) const;
+
+		/**
+			Returns the handle of the current number.
+		*/
+		NumberHandle getHandle() const;
+	};
+
+private:
+	struct Slab
+	{
+		/** The allocated memory, which includes room for alignment. */
+		unsigned char * memory;
+
+		/** The first number, aligned to a cache line. */
+		Number * numbers;
+	};
+
+	std::vector<Slab> mSlabs;
+
+	/** Odd while the number in the slot exists, even when the slot is free. */
+	std::vector<unsigned int> mGenerations;
+
+	/** Free slots; the last is reused first. */
+	std::vector<unsigned int> mFreeSlots;
+
+	size_t mCount;
+
+	NumberPool(const NumberPool&);
+	NumberPool& operator=(const NumberPool&);
+
+	Number * slotAddress(unsigned int slot) const;
+	void addSlab();
+
+public:
+	/**
+		Constructs a new, empty NumberPool. No memory is allocated
+		until the first number is created.
+	*/
+	NumberPool();
+
+	/**
+		Destroys all numbers, and releases all slabs.
+	*/
+	~NumberPool();
+
+	/**
+		Creates a copy of the given number in the pool.
+
+		@return
+			The handle of the new number.
+	*/
+	NumberHandle create(const Number& prototype);
+
+	/**
+		Destroys the number with the given handle, and makes its
+		memory available for new numbers.
+
+		@return
+			false if the handle is not valid, in which case nothing
+			is destroyed.
+	*/
+	bool destroy(NumberHandle handle);
+
+	/**
+		Destroys all numbers. The slabs are kept for new numbers,
+		and all existing handles become invalid.
+	*/
+	void clear();
+
+	/**
+		Returns whether the handle identifies a number that has not
+		been destroyed.
+	*/
+	bool isValid(NumberHandle handle) const;
+
+	/**
+		Returns the number with the given handle, or 0 if the handle
+		is not valid.
+	*/
+	Number * get(NumberHandle handle);
+
+	/**
+		Returns the number with the given handle, or 0 if the handle
+		is not valid.
+	*/
+	const Number * get(NumberHandle handle) const;
+
+	/**
+		Returns the number of numbers in the pool.
+	*/
+	size_t getCount() const;
+
+	/**
+		Returns the number of numbers the pool can hold before it
+		allocates another slab.
+	*/
+	size_t getCapacity() const;
+
+	/**
+		Returns an iterator to the first number.
+	*/
+	Iterator begin();
+
+	/**
+		Returns the iterator past the last number.
+	*/
+	Iterator end();
+};
+
+template <class Number, unsigned int slabSize>
+NumberPool<Number, slabSize>::Iterator::Iterator(NumberPool * pool, unsigned int slot):
+	mPool(pool),
+	mSlot(slot)
+{
+	skipFree();
+}
+
+template <class Number, unsigned int slabSize>
+void NumberPool<Number, slabSize>::Iterator::skipFree()
+{
+	unsigned int slotCount = (unsigned int) mPool->mGenerations.size();
+
+	while(mSlot < slotCount && (mPool->mGenerations[mSlot] & 1) == 0)
+	{
+		mSlot++;
+	}
+}
+
+template <class Number, unsigned int slabSize>
+Number& NumberPool<Number, slabSize>::Iterator::operator*() const
+{
+	return *mPool->slotAddress(mSlot);
+}
+
+template <class Number, unsigned int slabSize>
+Number * NumberPool<Number, slabSize>::Iterator::operator->() const
+{
+	return mPool->slotAddress(mSlot);
+}
+
+template <class Number, unsigned int slabSize>
+typename NumberPool<Number, slabSize>::Iterator& NumberPool<Number, slabSize>::Iterator::operator++()
+{
+	mSlot++;
+	skipFree();
+
+	return *this;
+}
+
+template <class Number, unsigned int slabSize>
+bool NumberPool<Number, slabSize>::Iterator::operator==(const Iterator& other) const
+{
+	return mSlot == other.mSlot;
+}
+
+template <class Number, unsigned int slabSize>
+bool NumberPool<Number, slabSize>::Iterator::operator!=(const Iterator& other) const
+{
+	return mSlot != other.mSlot;
+}
+
+template <class Number, unsigned int slabSize>
+NumberHandle NumberPool<Number, slabSize>::Iterator::getHandle() const
+{
+	return NumberHandle(mSlot, mPool->mGenerations[mSlot]);
+}
+
+template <class Number, unsigned int slabSize>
+NumberPool<Number, slabSize>::NumberPool():
+	mCount(0)
+{
+}
+
+template <class Number, unsigned int slabSize>
+NumberPool<Number, slabSize>::~NumberPool()
+{
+	clear();
+
+	for(size_t i = 0; i < mSlabs.size(); i++)
+	{
+		delete[] mSlabs[i].memory;
+	}
+}
+
+template <class Number, unsigned int slabSize>
+Number * NumberPool<Number, slabSize>::slotAddress(unsigned int slot) const
+{
+	return mSlabs[slot / slabSize].numbers + slot % slabSize;
+}
+
+template <class Number, unsigned int slabSize>
+void NumberPool<Number, slabSize>::addSlab()
+{
+	Slab slab;
+
+	slab.memory = new unsigned char[slabSize * sizeof(Number) + CACHE_LINE_SIZE - 1];
+
+	size_t misalignment = (size_t) slab.memory % CACHE_LINE_SIZE;
+
+	slab.numbers = reinterpret_cast<Number *>(slab.memory + (misalignment ? CACHE_LINE_SIZE - misalignment : 0));
+	mSlabs.push_back(slab);
+
+	unsigned int firstSlot = (unsigned int) mGenerations.size();
+
+	mGenerations.resize(firstSlot + slabSize, 0);
+	mFreeSlots.reserve(mGenerations.size());
+
+	//in reverse, so that the first slot of the slab is used first
+	for(unsigned int slot = firstSlot + slabSize; slot > firstSlot; slot--)
+	{
+		mFreeSlots.push_back(slot - 1);
+	}
+}
+
+template <class Number, unsigned int slabSize>
+NumberHandle NumberPool<Number, slabSize>::create(const Number& prototype)
+{
+	if(mFreeSlots.empty())
+	{
+		addSlab();
+	}
+
+	unsigned int slot = mFreeSlots.back();
+
+	new (slotAddress(slot)) Number(prototype);
+
+	mFreeSlots.pop_back();
+	mGenerations[slot]++;
+	mCount++;
+
+	return NumberHandle(slot, mGenerations[slot]);
+}
+
+template <class Number, unsigned int slabSize>
+bool NumberPool<Number, slabSize>::destroy(NumberHandle handle)
+{
+	if(!isValid(handle))
+	{
+		return false;
+	}
+
+	slotAddress(handle.slot)->~Number();
+
+	mGenerations[handle.slot]++;
+	mFreeSlots.push_back(handle.slot); //never reallocates, see addSlab
+	mCount--;
+
+	return true;
+}
+
+template <class Number, unsigned int slabSize>
+void NumberPool<Number, slabSize>::clear()
+{
+	for(unsigned int slot = 0; slot < mGenerations.size(); slot++)
+	{
+		if(mGenerations[slot] & 1)
+		{
+			destroy(NumberHandle(slot, mGenerations[slot]));
+		}
+	}
+}
+
+template <class Number, unsigned int slabSize>
+bool NumberPool<Number, slabSize>::isValid(NumberHandle handle) const
+{
+	return handle.slot < mGenerations.size() && (handle.generation & 1) && mGenerations[handle.slot] == handle.generation;
+}
+
+template <class Number, unsigned int slabSize>
+Number * NumberPool<Number, slabSize>::get(NumberHandle handle)
+{
+	return isValid(handle) ? slotAddress(handle.slot) : 0;
+}
+
+template <class Number, unsigned int slabSize>
+const Number * NumberPool<Number, slabSize>::get(NumberHandle handle) const
+{
+	return isValid(handle) ? slotAddress(handle.slot) : 0;
+}
+
+template <class Number, unsigned int slabSize>
+size_t NumberPool<Number, slabSize>::getCount() const
+{
+	return mCount;
+}
+
+template <class Number, unsigned int slabSize>
+size_t NumberPool<Number, slabSize>::getCapacity() const
+{
+	return mGenerations.size();
+}
+
+template <class Number, unsigned int slabSize>
+typename NumberPool<Number, slabSize>::Iterator NumberPool<Number, slabSize>::begin()
+{
+	return Iterator(this, 0);
+}
+
+template <class Number, unsigned int slabSize>
+typename NumberPool<Number, slabSize>::Iterator NumberPool<Number, slabSize>::end()
+{
+	return Iterator(this, (unsigned int) mGenerations.size());
+}
+
+}} //namespace
+
+#endif //_NUMBER_POOL_H_
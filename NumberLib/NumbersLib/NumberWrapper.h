@@ -2,6 +2,7 @@
 #define _NUMBER_WRAPPER_H_
 
 #include "UpdateableNumber.h"
+#include "Snapshot.h"
 
 namespace luma{
 namespace numbers {
@@ -50,6 +51,22 @@ public:
 	*/
 	T getValue() const;
 
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count);
+
+	/**
+		Writes the value to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the value written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+
 private:
 	T mValue;
 };
@@ -78,8 +95,30 @@ T NumberWrapper<T>::getValue() const
 	return mValue;
 }
 
+template <class T>
+void NumberWrapper<T>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		NumberWrapper::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = NumberWrapper::getValue();
+	}
+}
+
+template <class T>
+void NumberWrapper<T>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mValue);
+}
+
+template <class T>
+bool NumberWrapper<T>::deserialize(SnapshotReader& reader)
+{
+	return reader.read(mValue);
+}
+
 }}
 
 
 
-#endif _NUMBER_WRAPPER_H_
\ No newline at end of file
+#endif //_NUMBER_WRAPPER_H_
\ No newline at end of file
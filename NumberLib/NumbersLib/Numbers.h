@@ -81,6 +81,11 @@
 	you will simply use a different increments and thresholds than somebody who defined
 	FRAME_RATE differently.
 
+	@par
+	FRAME_RATE applies to a whole build. Numbers that are updated at
+	different rates can each be given a clock instead (see Clock.h),
+	for example ClampedNumber<float, ConstantClock<30> >.
+
 	@par Changes Version 1.1:
 	-	Made it possible to use all classes in environments 
 		where the frame rate is not fixed.
@@ -117,6 +122,75 @@
 	@par Chnages 1.6
 	-	Added XYResponseCurve
 	-	Added an integrate function in utils.
+
+	@par Changes 1.7
+	-	Added FilteredNumberBank, for updating many filters at once.
+	-	FilteredNumber updates its sums in constant time for uniform,
+		exponential and linear weights (see WeightShape).
+	-	Put FilteredNumber in the luma::numbers namespace.
+	-	Added BasicRangedNumber, a RangedNumber without virtual functions,
+		with ClampPolicy, CyclicPolicy and ReflectPolicy. BufferedBool now uses it.
+	-	Added NumberBench, a benchmark executable with text, CSV and JSON output.
+		It replaces TestClampedNumberPerformance.
+	-	Added a CMake build (CMakeLists.txt) with optional LTO, -march=native and
+		profile guided optimisation, and fixed the headers so that they compile with GCC.
+	-	Added ResponseCurve::evaluate, which evaluates arrays of inputs with SSE2 or
+		AVX2 instructions (see Simd.h).
+	-	XYResponseCurve finds input samples through a table of buckets, in constant
+		expected time.
+	-	Added PIDControllerBank, for updating many PID controllers at once.
+	-	Added wrap and wrapIndex. mod needs no division for values at most one range
+		outside the range, and no longer overflows an int for large ranges. Ring
+		buffer indices use wrapIndex.
+	-	Added KernelFilteredNumber, a FilteredNumber with compile-time weights
+		(BoxKernel, TriangleKernel, ExponentialKernel and GaussianKernel).
+		FilteredNumber takes the source of its weights as an optional template
+		argument: ArrayWeights (the default) or KernelWeights.
+	-	IntegrableNumber updates all orders in one pass over a single ring buffer
+		index, and only the highest order keeps time samples.
+	-	Added UpdateableNumber::process, which updates a number with an array of
+		values. Concrete classes implement it without virtual calls.
+	-	Added PublishedNumber, which publishes the values of a number updated by
+		one thread to other threads under a sequence lock. It requires C++11.
+	-	Added Fixed, a Qm.n fixed point type (Fixed16 is Q16.16) that can be used
+		with ClampedNumber, CyclicNumber, PingPongNumber and BufferedNumber for
+		deterministic results. Increments are scaled by time with scaleByTime,
+		which uses integer arithmetic for Fixed.
+	-	Added clocks (Clock.h), which ClampedNumber, BasicRangedNumber,
+		BufferedNumber, DifferentiableNumber, PIDBufferedNumber and
+		PIDControllerBank use instead of frameRate to scale elapsed times.
+		BufferedNumber now uses the time scale of its Number.
+	-	Added FastSigmoid, which approximates sigmoid with a table whose size
+		is chosen for a given maximum error, and can evaluate many inputs at
+		once.
+	-	Added BufferedBoolArray, which updates many BufferedBools at once from a
+		packed bitset of inputs, keeps their outputs as a packed bitset, and
+		records which outputs changed.
+	-	BufferedBool and BufferedState have update(), which works like setValue
+		and returns whether the output changed. Added TransitionBank, which
+		updates many such numbers and appends the ones that switched to a
+		TransitionQueue; BufferedBoolArray::appendTransitions does the same.
+	-	Added LazyBufferedState, a BufferedState whose updates take constant time.
+	-	Fixed BufferedState::forceValue, which changed the increments of the
+		states instead of only their values.
+	-	Added Snapshot.h, a versioned binary format for checkpointing
+		numbers. Numbers with state have serialize and deserialize
+		functions; filters and banks write their buffers as whole
+		blocks, and a snapshot can be read from mapped memory.
+	-	Added UpdateScheduler, which groups numbers of mixed types into
+		arenas by type, and updates them on several threads. It requires C++11.
+	-	Added NumberPool, which holds many numbers of one type in cache line
+		aligned slabs, with stable handles and constant time creation and
+		destruction.
+	-	Added ExponentialFilteredNumber, a filtered number that keeps one
+		exponential moving average per order instead of a ring buffer.
+	-	Added WindowMinMaxNumber and WindowMedianNumber, which keep the
+		minimum and maximum (with monotonic deques) and the median (with two
+		heaps) of the last sampleCount values.
+	-	PIDBufferedNumber calculates its output when the value is set, so
+		getValue returns a stored value. DifferentiableNumber keeps its
+		derivatives in one array instead of a chain of numbers; snapshots
+		are unchanged.
 */
 
 /**
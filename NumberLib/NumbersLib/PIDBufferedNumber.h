@@ -27,16 +27,22 @@ namespace numbers
 		The number of integrals that will be used.
 	@param im
 		The number of samples over hwich the integration will be.
+	@param Clock
+		The clock whose time scale multiplies the elapsed time of
+		the derivatives (see Clock.h).
 */
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock = DefaultClock>
 class PIDBufferedNumber : public UpdateableNumber<T>
 {
 private:
 	/** The current value*/
 	T mValue;
 
+	/** The weighted sum returned by getValue, calculated when the value is set. */
+	T mOutput;
+
 	/** The differentiable presentation of the value */
-	DifferentiableNumber<T, dn> mDifferentiableValue;
+	DifferentiableNumber<T, dn, Clock> mDifferentiableValue;
 
 	/** The itegrable presentation of the value*/
 	IntegrableNumber<T, im, in> mIntegrableValue;
@@ -50,6 +56,9 @@ private:
 	/** Factors by which integrals are multiplied.*/
 	T mIntegrableValueFactors[in];	
 
+	/** Calculates mOutput from the current value, derivatives and integrals. */
+	void updateOutput();
+
 public:
 
 	/** Constructs a new PIDBufferedNumber. 
@@ -86,11 +95,31 @@ public:
 		Returns a weighted sum of the current value, 
 		its derivatives, and its integrals. The weights 
 		are the factors passed in to the constructor.
+
+		The sum is calculated when the value is set, so
+		calling this is cheap.
 	*/
 	T getValue() const;
 
+	/**
+		See UpdateableNumber::process. The number is updated
+		without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count);
+
 	T getSample(int i) const;
 
+	/**
+		Writes the value, the factors, and the state of the
+		derivatives and integrals to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+
 	/**
 	Forces this controller to the given value. This means
 	all samples are forced to this value.
@@ -98,8 +127,8 @@ public:
 
 };
 
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
-PIDBufferedNumber<T, dn, in, im>::PIDBufferedNumber(
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+PIDBufferedNumber<T, dn, in, im, Clock>::PIDBufferedNumber(
 	T initialValue, 
 	T valueFactor,
 	T differentiableValueFactors[dn],
@@ -118,26 +147,32 @@ PIDBufferedNumber<T, dn, in, im>::PIDBufferedNumber(
 	{
 		mIntegrableValueFactors[i] = integrableValueFactors[i];
 	}
+
+	updateOutput();
 }
 
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
-void PIDBufferedNumber<T, dn, in, im>::setValue(T x, float elapsedTime)
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDBufferedNumber<T, dn, in, im, Clock>::setValue(T x, float elapsedTime)
 {
 	mValue = x;
 	mDifferentiableValue.setValue(x, elapsedTime);
 	mIntegrableValue.setValue(x, elapsedTime);
+
+	updateOutput();
 }
 
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
-void PIDBufferedNumber<T, dn, in, im>::forceValue(T x, float elapsedTime)
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDBufferedNumber<T, dn, in, im, Clock>::forceValue(T x, float elapsedTime)
 {
 	mValue = x;
 	mDifferentiableValue.forceValue(x);
 	mIntegrableValue.forceValue(x, elapsedTime);
+
+	updateOutput();
 }
 
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
-T PIDBufferedNumber<T, dn, in, im>::getValue() const
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDBufferedNumber<T, dn, in, im, Clock>::updateOutput()
 {
 	T sum = mValue * mValueFactor;
 
@@ -151,15 +186,60 @@ T PIDBufferedNumber<T, dn, in, im>::getValue() const
 		sum += mIntegrableValueFactors[i] * mIntegrableValue.getValue(i + 1);
 	}
 	
-	return sum;
+	mOutput = sum;
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+T PIDBufferedNumber<T, dn, in, im, Clock>::getValue() const
+{
+	return mOutput;
 }
 
-template<class T, unsigned int dn, unsigned int in, unsigned int im>
-T PIDBufferedNumber<T, dn, in, im>::getSample(int i) const
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDBufferedNumber<T, dn, in, im, Clock>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		PIDBufferedNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = PIDBufferedNumber::getValue();
+	}
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+T PIDBufferedNumber<T, dn, in, im, Clock>::getSample(int i) const
 {
 	return mIntegrableValue.getSample(i);
 }
 
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDBufferedNumber<T, dn, in, im, Clock>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mValue);
+	writer.write(mValueFactor);
+	writer.write(mDifferentiableValueFactors, dn);
+	writer.write(mIntegrableValueFactors, in);
+	mDifferentiableValue.serialize(writer);
+	mIntegrableValue.serialize(writer);
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+bool PIDBufferedNumber<T, dn, in, im, Clock>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mValue);
+	reader.read(mValueFactor);
+	reader.read(mDifferentiableValueFactors, dn);
+	reader.read(mIntegrableValueFactors, in);
+
+	if(!mDifferentiableValue.deserialize(reader) || !mIntegrableValue.deserialize(reader))
+	{
+		return false;
+	}
+
+	updateOutput();
+
+	return true;
+}
+
 }}
 
 #endif //_PID_BUFFERED_NUMBER_H
\ No newline at end of file
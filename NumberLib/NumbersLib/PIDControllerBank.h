@@ -0,0 +1,490 @@
+#ifndef _PID_CONTROLLER_BANK_H_
+#define _PID_CONTROLLER_BANK_H_
+
+#include <vector>
+
+#include "Numbers.h"
+#include "utils.h"
+#include "Clock.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A PIDControllerBank holds a large number of PID controllers that
+	behave exactly like PIDBufferedNumber<T, dn, in, im>, and updates
+	all of them with a single call.
+
+	All controllers in a bank share the same factors, and are updated
+	at the same time with the same elapsed time (typically once per
+	tick). The elapsed times only influence the divisors of the
+	derivatives and integrals, so these are calculated once for the
+	whole bank, and the ring buffer index is stored only once.
+
+	The state of the controllers is stored as a structure of arrays:
+	for every derivative, every integral and every slot in the ring
+	buffers, the values of all controllers lie next to each other in
+	memory. The inner loops of setValue run over controllers, so that
+	the compiler can vectorise them. There are no virtual calls.
+
+	@code
+	float dFactors[] = {0.5f, 0.1f};
+	float iFactors[] = {0.2f};
+	PIDControllerBank<float, 2, 1, 16> bank(entityCount, 0.0f, 1.0f, dFactors, iFactors);
+
+	//every tick
+	bank.setValue(errors, elapsedTime);
+	const float * corrections = bank.getValues();
+	@endcode
+
+	The value bank.getValue(i) is exactly the same as the value
+	getValue() of a PIDBufferedNumber that received the same sequence
+	of values as controller i. (Unless the compiler contracts
+	multiplications and additions into fused multiply-adds, which it
+	may do differently for the two classes.)
+
+	@param T
+		The variable type of the controllers, typically float.
+	@param dn
+		The number of derivatives that will be used.
+	@param in
+		The number of integrals that will be used.
+	@param im
+		The number of samples over which the integration will be.
+	@param Clock
+		The clock whose time scale multiplies the elapsed time of
+		the derivatives (see Clock.h).
+
+	@see PIDBufferedNumber
+*/
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock = DefaultClock>
+class PIDControllerBank
+{
+private:
+	unsigned int mControllerCount;
+	T mInitialValue;
+
+	/** Factor by which the current value is multiplied.*/
+	T mValueFactor;
+
+	/** Factors by which differentials are multiplied.*/
+	T mDifferentiableValueFactors[dn > 0 ? dn : 1];
+
+	/** Factors by which integrals are multiplied.*/
+	T mIntegrableValueFactors[in > 0 ? in : 1];
+
+	/**
+		The current value (order 0) and the derivatives of orders 1 to dn.
+		The derivative of controller i of order k is at k * mControllerCount + i.
+	*/
+	std::vector<T> mDerivatives;
+
+	/**
+		The previous values of orders 0 to dn - 1, laid out like
+		mDerivatives.
+	*/
+	std::vector<T> mPreviousDerivatives;
+
+	/**
+		The integrals of orders 1 to in. The integral of controller i
+		of order k is at (k - 1) * mControllerCount + i.
+	*/
+	std::vector<T> mIntegrals;
+
+	/**
+		Samples (multiplied by their elapsed time) of the values
+		that are integrated, orders 0 to in - 1. The sample of
+		controller i in slot s of order k is at
+		((k * im) + s) * mControllerCount + i.
+	*/
+	std::vector<T> mSamples;
+
+	/**
+		The total time over which every order is integrated.
+	*/
+	float mTotalTimes[in > 0 ? in : 1];
+
+	/**
+		The time samples of the highest order integral. (Like
+		IntegrableNumber, the lower orders never update their
+		time samples, which stay TIME_UNIT.)
+	*/
+	T mTimeSamples[im];
+
+	int mCurrentIndex;
+
+	/**
+		Outputs of all the controllers.
+	*/
+	std::vector<T> mOutputs;
+
+	/**
+		Calculates the outputs of all controllers from the current
+		values, derivatives and integrals.
+	*/
+	void updateOutputs();
+
+public:
+	/**
+		Constructs a new PIDControllerBank.
+
+		@param controllerCount
+			The number of controllers in this bank.
+		@param initialValue
+			Zero of type T. The values, all differentials and
+			all integrals are initialised with this value.
+		@param valueFactor
+			The factor by which the current value is multiplied.
+		@param differentiableValueFactors
+			Factors by which derivatives are multiplied.
+		@param integrableValueFactors
+			Factors by which integrals are multiplied.
+	*/
+	PIDControllerBank(unsigned int controllerCount, T initialValue, T valueFactor,
+		T differentiableValueFactors[dn], T integrableValueFactors[in]);
+
+	/**
+		Sets the current value of every controller in this bank,
+		and calculates the outputs.
+
+		@param values
+			The current values, one for every controller. The size
+			of the array must be getControllerCount().
+		@param elapsedTime
+			The time elapsed since the last values were set.
+	*/
+	void setValue(const T values[], float elapsedTime = TIME_UNIT);
+
+	/**
+		Forces every controller in this bank to the given value,
+		and calculates the outputs.
+
+		@see PIDBufferedNumber::forceValue
+	*/
+	void forceValue(const T values[], float elapsedTime = TIME_UNIT);
+
+	/**
+		Returns the output of the given controller: a weighted sum
+		of its current value, its derivatives, and its integrals.
+	*/
+	T getValue(unsigned int controller) const;
+
+	/**
+		Returns the outputs of all controllers, or 0 if this bank
+		has no controllers. The returned array is valid until this
+		bank is destroyed.
+	*/
+	const T * getValues() const;
+
+	/**
+		Returns the number of controllers in this bank.
+	*/
+	unsigned int getControllerCount() const;
+
+	/**
+		Writes the state of all controllers to the snapshot. The
+		derivatives, integrals, samples and outputs of all
+		controllers are each written as one block. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize. The number of
+		controllers must be the same.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+PIDControllerBank<T, dn, in, im, Clock>::PIDControllerBank(
+	unsigned int controllerCount,
+	T initialValue,
+	T valueFactor,
+	T differentiableValueFactors[dn],
+	T integrableValueFactors[in]):
+	mControllerCount(controllerCount),
+	mInitialValue(initialValue),
+	mValueFactor(valueFactor),
+	mDerivatives((dn + 1) * controllerCount, initialValue),
+	mPreviousDerivatives(dn * controllerCount, initialValue),
+	mIntegrals(in * controllerCount, initialValue),
+	mSamples(in * im * controllerCount, initialValue),
+	mCurrentIndex(0),
+	mOutputs(controllerCount, initialValue)
+{
+	//without derivatives or integrals, the arrays still hold one
+	//element, which snapshots write
+	mDifferentiableValueFactors[0] = 0;
+	mIntegrableValueFactors[0] = 0;
+	mTotalTimes[0] = 0;
+
+	for(unsigned int i = 0; i < dn; i++)
+	{
+		mDifferentiableValueFactors[i] = differentiableValueFactors[i];
+	}
+
+	for(unsigned int i = 0; i < in; i++)
+	{
+		mIntegrableValueFactors[i] = integrableValueFactors[i];
+		mTotalTimes[i] = im * TIME_UNIT;
+	}
+
+	for(unsigned int i = 0; i < im; i++)
+	{
+		mTimeSamples[i] = TIME_UNIT;
+	}
+
+	updateOutputs();
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDControllerBank<T, dn, in, im, Clock>::setValue(const T values[], float elapsedTime)
+{
+	const unsigned int count = mControllerCount;
+
+	if(count == 0)
+	{
+		return;
+	}
+
+	//Derivatives. Like DifferentiableNumber, only the first
+	//derivative takes the elapsed time into account.
+	T * current = &mDerivatives[0];
+	T * previous = dn > 0 ? &mPreviousDerivatives[0] : 0;
+
+	for(unsigned int order = 0; order <= dn; order++)
+	{
+		T * value = current + order * count;
+		float time = (order == 1 ? elapsedTime : 1.0f) * Clock::timeScale();
+
+		if(order < dn)
+		{
+			T * previousValue = previous + order * count;
+
+			for(unsigned int j = 0; j < count; j++)
+			{
+				previousValue[j] = value[j];
+			}
+		}
+
+		if(order == 0)
+		{
+			for(unsigned int j = 0; j < count; j++)
+			{
+				value[j] = values[j];
+			}
+		}
+		else
+		{
+			const T * lowerValue = value - count;
+			const T * lowerPrevious = previous + (order - 1) * count;
+
+			for(unsigned int j = 0; j < count; j++)
+			{
+				value[j] = (lowerValue[j] - lowerPrevious[j]) / time;
+			}
+		}
+	}
+
+	//Integrals. Like IntegrableNumber, only the first integral
+	//takes the elapsed time into account, and only the last one
+	//updates its time samples.
+	mCurrentIndex = wrapIndex<im>(mCurrentIndex + 1);
+
+	int index = mCurrentIndex;
+
+	for(unsigned int order = 0; order < in; order++)
+	{
+		float time = order == 0 ? elapsedTime : 1.0f;
+
+		if(order == in - 1)
+		{
+			mTotalTimes[order] += time - mTimeSamples[index];
+			mTimeSamples[index] = time;
+		}
+		else
+		{
+			mTotalTimes[order] += time - TIME_UNIT;
+		}
+
+		const float totalTime = mTotalTimes[order];
+		const T * input = order == 0 ? values : &mIntegrals[(order - 1) * count];
+		T * integral = &mIntegrals[order * count];
+		T * samples = &mSamples[(order * im + index) * count];
+
+		for(unsigned int j = 0; j < count; j++)
+		{
+			T newValue = input[j] * time;
+
+			integral[j] += (newValue - samples[j]) / totalTime;
+			samples[j] = newValue;
+		}
+	}
+
+	updateOutputs();
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDControllerBank<T, dn, in, im, Clock>::forceValue(const T values[], float elapsedTime)
+{
+	const unsigned int count = mControllerCount;
+
+	for(unsigned int j = 0; j < count; j++)
+	{
+		mDerivatives[j] = values[j];
+	}
+
+	for(unsigned int j = count; j < (dn + 1) * count; j++)
+	{
+		mDerivatives[j] = mInitialValue;
+	}
+
+	for(unsigned int j = 0; j < dn * count; j++)
+	{
+		mPreviousDerivatives[j] = j < count ? values[j] : mInitialValue;
+	}
+
+	for(unsigned int order = 0; order < in; order++)
+	{
+		mTotalTimes[order] = im * elapsedTime;
+
+		const float totalTime = mTotalTimes[order];
+		const T * input = order == 0 ? values : &mIntegrals[(order - 1) * count];
+		T * integral = &mIntegrals[order * count];
+
+		for(unsigned int j = 0; j < count; j++)
+		{
+			T newValue = input[j] * elapsedTime;
+			T sum = mInitialValue;
+
+			//summed one by one, for the same rounding as IntegrableNumber
+			for(unsigned int i = 0; i < im; i++)
+			{
+				mSamples[(order * im + i) * count + j] = newValue;
+				sum += newValue;
+			}
+
+			integral[j] = sum / totalTime;
+		}
+	}
+
+	if(in > 0)
+	{
+		for(unsigned int i = 0; i < im; i++)
+		{
+			mTimeSamples[i] = elapsedTime;
+		}
+	}
+
+	updateOutputs();
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDControllerBank<T, dn, in, im, Clock>::updateOutputs()
+{
+	const unsigned int count = mControllerCount;
+
+	if(count == 0)
+	{
+		return;
+	}
+
+	T * output = &mOutputs[0];
+	const T * value = &mDerivatives[0];
+
+	for(unsigned int j = 0; j < count; j++)
+	{
+		output[j] = value[j] * mValueFactor;
+	}
+
+	for(unsigned int i = 0; i < dn; i++)
+	{
+		const T factor = mDifferentiableValueFactors[i];
+		const T * derivative = &mDerivatives[(i + 1) * count];
+
+		for(unsigned int j = 0; j < count; j++)
+		{
+			output[j] += factor * derivative[j];
+		}
+	}
+
+	for(unsigned int i = 0; i < in; i++)
+	{
+		const T factor = mIntegrableValueFactors[i];
+		const T * integral = &mIntegrals[i * count];
+
+		for(unsigned int j = 0; j < count; j++)
+		{
+			output[j] += factor * integral[j];
+		}
+	}
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+T PIDControllerBank<T, dn, in, im, Clock>::getValue(unsigned int controller) const
+{
+	return mOutputs[controller];
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+const T * PIDControllerBank<T, dn, in, im, Clock>::getValues() const
+{
+	return mControllerCount > 0 ? &mOutputs[0] : 0;
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+unsigned int PIDControllerBank<T, dn, in, im, Clock>::getControllerCount() const
+{
+	return mControllerCount;
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+void PIDControllerBank<T, dn, in, im, Clock>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(dn);
+	writer.write(in);
+	writer.write(im);
+	writer.write(mControllerCount);
+	writer.write(mInitialValue);
+	writer.write(mValueFactor);
+	writer.write(mDifferentiableValueFactors, dn > 0 ? dn : 1);
+	writer.write(mIntegrableValueFactors, in > 0 ? in : 1);
+	writer.write(mTotalTimes, in > 0 ? in : 1);
+	writer.write(mTimeSamples, im);
+	writer.write(mCurrentIndex);
+	writer.write(mDerivatives);
+	writer.write(mPreviousDerivatives);
+	writer.write(mIntegrals);
+	writer.write(mSamples);
+	writer.write(mOutputs);
+}
+
+template<class T, unsigned int dn, unsigned int in, unsigned int im, class Clock>
+bool PIDControllerBank<T, dn, in, im, Clock>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(dn);
+	reader.expect(in);
+	reader.expect(im);
+	reader.expect(mControllerCount);
+	reader.read(mInitialValue);
+	reader.read(mValueFactor);
+	reader.read(mDifferentiableValueFactors, dn > 0 ? dn : 1);
+	reader.read(mIntegrableValueFactors, in > 0 ? in : 1);
+	reader.read(mTotalTimes, in > 0 ? in : 1);
+	reader.read(mTimeSamples, im);
+	reader.readIndex(mCurrentIndex, im);
+	reader.read(mDerivatives);
+	reader.read(mPreviousDerivatives);
+	reader.read(mIntegrals);
+	reader.read(mSamples);
+	reader.read(mOutputs);
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_PID_CONTROLLER_BANK_H_
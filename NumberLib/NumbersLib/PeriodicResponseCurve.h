@@ -3,7 +3,13 @@
 
 
 #include "AbstractFunction.h"
-#include "Utils.h"
+#include "ResponseCurve.h"
+#include "utils.h"
+
+namespace luma
+{
+namespace numbers
+{
 
 /**
 	This class is useful for implementing arbitrary periodic functions. 
@@ -92,4 +98,6 @@ T PeriodicResponseCurve<T, n>::getInputMax() const
 	return mResponseCurve.getInputMax();
 }
 
-#endif
\ No newline at end of file
+}} //namespace
+
+#endif //_PERIODIC_RESPONSE_CURVE_H_
\ No newline at end of file
@@ -45,7 +45,7 @@ private:
 	*/
 	inline T pingPongValue(T value) const
 	{
-		return value >= mMax ? 2 * (mMax - mIncrement) - value: value;
+		return value >= this->mMax ? 2 * (this->mMax - this->mIncrement) - value: value;
 	}
 
 	/**
@@ -79,6 +79,11 @@ public:
 	virtual void dec(float elapsedTime = 1);
 	virtual void inc(float elapsedTime = 1);
 
+	/**
+		See CyclicNumber::timeScale.
+	*/
+	static float timeScale();
+
 	virtual T getValidValue(const T& value) const;
 
 
@@ -86,18 +91,26 @@ public:
 	T getCyclicValue() const;
 
 	void setIncrement(const T& increment);
+
+	/**
+		See RangedNumber::serialize. The internal cyclic value
+		is written too.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	bool deserialize(SnapshotReader& reader);
 };
 
 template <class T>
 PingPongNumber<T>::PingPongNumber(T value, T min, T max, T increment):
-	RangedNumber(reflect(value, min, max - increment), min, max, increment),
+	RangedNumber<T>(reflect(value, min, max - increment), min, max, increment),
 	mCyclicNumber(value, min, max + max - min - increment - increment, increment)
 {
 }
 
 template <class T>
 PingPongNumber<T>::PingPongNumber(const PingPongNumber &other):
-	RangedNumber(other),
+	RangedNumber<T>(other),
 	mCyclicNumber(other.mCyclicNumber)
 {
 }
@@ -105,9 +118,9 @@ PingPongNumber<T>::PingPongNumber(const PingPongNumber &other):
 template <class T>
 PingPongNumber<T>& PingPongNumber<T>::operator=(const PingPongNumber<T>& other)
 {
-	modify(other.mMin, other.mMax, other.mIncrement);
+	this->modify(other.mMin, other.mMax, other.mIncrement);
 	mCyclicNumber = other.mCyclicNumber;
-	mValue = pingPongValue();
+	this->mValue = pingPongValue();
 
 	return *this;
 }
@@ -116,7 +129,7 @@ template <class T>
 PingPongNumber<T>& PingPongNumber<T>::operator=(const T& value)
 {
 	mCyclicNumber = value;
-	mValue = pingPongValue();
+	this->mValue = pingPongValue();
 
 	return *this;
 }
@@ -167,7 +180,7 @@ template <class T>
 void PingPongNumber<T>::inc(float ellapsedTime)
 {
 	mCyclicNumber.inc(ellapsedTime);
-	mValue = pingPongValue((T) mCyclicNumber);
+	this->mValue = pingPongValue((T) mCyclicNumber);
 
 }
 
@@ -175,15 +188,15 @@ template <class T>
 void PingPongNumber<T>::dec(float ellapsedTime)
 {
 	mCyclicNumber.dec(ellapsedTime);
-	mValue = pingPongValue((T) mCyclicNumber);
+	this->mValue = pingPongValue((T) mCyclicNumber);
 
 }
 
 template <class T>
 void PingPongNumber<T>::setIncrement(const T& increment)
 {
-	mCyclicNumber.modify(mMin, 2 * mMax - mMin - 2 * increment, increment);
-	RangedNumber::setIncrement(increment);
+	mCyclicNumber.modify(this->mMin, 2 * this->mMax - this->mMin - 2 * increment, increment);
+	RangedNumber<T>::setIncrement(increment);
 }
 
 template <class T>
@@ -192,5 +205,24 @@ T PingPongNumber<T>::getCyclicValue() const
 	return mCyclicNumber.getValue();
 }
 
+template <class T>
+float PingPongNumber<T>::timeScale()
+{
+	return CyclicNumber<T>::timeScale();
+}
+
+template <class T>
+void PingPongNumber<T>::serialize(SnapshotWriter& writer) const
+{
+	RangedNumber<T>::serialize(writer);
+	mCyclicNumber.serialize(writer);
+}
+
+template <class T>
+bool PingPongNumber<T>::deserialize(SnapshotReader& reader)
+{
+	return RangedNumber<T>::deserialize(reader) && mCyclicNumber.deserialize(reader);
+}
+
 };};//namespace
 #endif //_PING_PONG_NUMBER_H
\ No newline at end of file
@@ -0,0 +1,278 @@
+#ifndef _PUBLISHED_NUMBER_H_
+#define _PUBLISHED_NUMBER_H_
+
+#include <atomic>
+
+#include "UpdateableNumber.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	Reads the values of orders 0 to maxOrder of a number. This class
+	is used by PublishedNumber, and should generally not be used on
+	its own.
+*/
+template <class U, class T, unsigned int maxOrder>
+struct PublishedOrders
+{
+	static void read(const U& number, T values[])
+	{
+		for(unsigned int order = 0; order <= maxOrder; order++)
+		{
+			values[order] = number.getValue(order);
+		}
+	}
+};
+
+/**
+	Numbers that only have a value of order 0 need not
+	have getValue(order). For numbers that have it, order 0
+	is still getValue(0), as it is when more orders are
+	published.
+*/
+template <class U, class T>
+struct PublishedOrders<U, T, 0>
+{
+	static void read(const U& number, T values[])
+	{
+		values[0] = readOrderZero(number, 0);
+	}
+
+private:
+	//preferred (0 is an int) when V has getValue(order)
+	template <class V>
+	static auto readOrderZero(const V& number, int) -> decltype(number.getValue(0u))
+	{
+		return number.getValue(0u);
+	}
+
+	template <class V>
+	static auto readOrderZero(const V& number, long) -> decltype(number.getValue())
+	{
+		return number.getValue();
+	}
+};
+
+/**
+	Wraps an UpdateableNumber that is updated by one thread (the
+	writer), so that any number of other threads (readers) can read
+	its values without locks.
+
+	Every time the writer sets a value, the values of orders 0 to
+	maxOrder are published together, under a sequence lock: the
+	writer never waits, and a reader that overlaps with a publish
+	retries until it has read values that were all published
+	together. Reading is therefore cheap when the number is updated
+	rarely compared to how long a read takes, which is the normal
+	case for values updated once per tick.
+
+	@code
+	//shared
+	PublishedNumber<FilteredNumber<float, 16, 2>, 2> speed(FilteredNumber<float, 16, 2>(0.0f, weights));
+
+	//simulation thread, every tick
+	speed.setValue(getSpeed(), elapsedTime);
+
+	//UI thread
+	float values[3];
+	speed.getValues(values); //the speed, and its first and second filtered values
+	@endcode
+
+	The value of order 0 is getValue(0) for numbers that have
+	orders, whatever maxOrder is: for filtered numbers, that is the
+	last value set, not the filtered value their getValue() returns.
+	For other numbers, it is getValue().
+
+	Only the members marked as writer functions may be called by the
+	writer, and only the reader functions by other threads. T must be
+	trivially copyable (such as float, int or bool).
+
+	@param U
+		The type of the number, for example BufferedNumber<float>.
+	@param maxOrder
+		The highest order that is published. If this is more than 0,
+		U must have a getValue(order) function, as filtered numbers do.
+	@param T
+		The type of the values.
+*/
+template <class U, unsigned int maxOrder = 0, class T = typename U::ValueType>
+class PublishedNumber : public UpdateableNumber<T>
+{
+private:
+	U mNumber;
+
+	/**
+		Even when the values are consistent, odd while the writer
+		is publishing. Increased by two with every publish.
+	*/
+	std::atomic<unsigned int> mSequence;
+
+	std::atomic<T> mValues[maxOrder + 1];
+
+	/** Returned for orders above maxOrder; never changes, so it needs no atomic. */
+	T mInitialValue;
+
+public:
+	/**
+		Constructs a new PublishedNumber that wraps a copy of the given
+		number, and publishes its values.
+
+		@param initialValue
+			The value returned by getValue for orders above maxOrder,
+			typically the initial value (a zero of type T) of the
+			wrapped number.
+	*/
+	PublishedNumber(const U& number, T initialValue = T());
+
+	/**
+		Writer function. Sets the value of the wrapped number, and
+		publishes its new values.
+	*/
+	void setValue(T value, float elapsedTime = TIME_UNIT);
+
+	/**
+		Writer function. Publishes the current values of the wrapped
+		number. Call this after changing the number through getNumber.
+	*/
+	void publish();
+
+	/**
+		Writer function. Returns the wrapped number, for example to
+		call forceValue. Changes are not seen by readers until
+		publish is called.
+	*/
+	U& getNumber();
+
+	/**
+		Reader function. Returns the last published value of order 0.
+	*/
+	T getValue() const;
+
+	/**
+		Reader function. Returns the last published value of the
+		given order, or the initial value if order is larger
+		than maxOrder.
+	*/
+	T getValue(unsigned int order) const;
+
+	/**
+		Reader function. Copies the last published values of orders
+		0 to maxOrder to values, which must have room for maxOrder + 1
+		values. All values were published together.
+	*/
+	void getValues(T values[]) const;
+
+	/**
+		Reader function. Returns the number of times values have been
+		published, so that a reader can tell whether anything changed
+		since its last read.
+	*/
+	unsigned int getVersion() const;
+};
+
+template <class U, unsigned int maxOrder, class T>
+PublishedNumber<U, maxOrder, T>::PublishedNumber(const U& number, T initialValue):
+	mNumber(number),
+	mSequence(0),
+	mInitialValue(initialValue)
+{
+	T values[maxOrder + 1];
+
+	PublishedOrders<U, T, maxOrder>::read(mNumber, values);
+
+	for(unsigned int order = 0; order <= maxOrder; order++)
+	{
+		mValues[order].store(values[order], std::memory_order_relaxed);
+	}
+}
+
+template <class U, unsigned int maxOrder, class T>
+void PublishedNumber<U, maxOrder, T>::setValue(T value, float elapsedTime)
+{
+	mNumber.setValue(value, elapsedTime);
+	publish();
+}
+
+template <class U, unsigned int maxOrder, class T>
+void PublishedNumber<U, maxOrder, T>::publish()
+{
+	T values[maxOrder + 1];
+
+	PublishedOrders<U, T, maxOrder>::read(mNumber, values);
+
+	//there is only one writer, so the sequence needs no read-modify-write
+	unsigned int sequence = mSequence.load(std::memory_order_relaxed);
+
+	mSequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for(unsigned int order = 0; order <= maxOrder; order++)
+	{
+		mValues[order].store(values[order], std::memory_order_relaxed);
+	}
+
+	mSequence.store(sequence + 2, std::memory_order_release);
+}
+
+template <class U, unsigned int maxOrder, class T>
+U& PublishedNumber<U, maxOrder, T>::getNumber()
+{
+	return mNumber;
+}
+
+template <class U, unsigned int maxOrder, class T>
+void PublishedNumber<U, maxOrder, T>::getValues(T values[]) const
+{
+	for(;;)
+	{
+		unsigned int before = mSequence.load(std::memory_order_acquire);
+
+		if(before & 1)
+		{
+			continue; //the writer is publishing
+		}
+
+		for(unsigned int order = 0; order <= maxOrder; order++)
+		{
+			values[order] = mValues[order].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if(mSequence.load(std::memory_order_relaxed) == before)
+		{
+			return;
+		}
+	}
+}
+
+template <class U, unsigned int maxOrder, class T>
+T PublishedNumber<U, maxOrder, T>::getValue() const
+{
+	//a single value is always consistent
+	return mValues[0].load(std::memory_order_relaxed);
+}
+
+template <class U, unsigned int maxOrder, class T>
+T PublishedNumber<U, maxOrder, T>::getValue(unsigned int order) const
+{
+	if(order <= maxOrder)
+	{
+		return mValues[order].load(std::memory_order_relaxed);
+	}
+
+	return mInitialValue;
+}
+
+template <class U, unsigned int maxOrder, class T>
+unsigned int PublishedNumber<U, maxOrder, T>::getVersion() const
+{
+	return mSequence.load(std::memory_order_acquire) / 2;
+}
+
+}} //namespace
+
+#endif //_PUBLISHED_NUMBER_H_
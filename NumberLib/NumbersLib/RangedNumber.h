@@ -1,7 +1,8 @@
 #ifndef _RANGED_NUMBER_H
 #define _RANGED_NUMBER_H
 
-#include "numbers.h"
+#include "Numbers.h"
+#include "Snapshot.h"
 
 namespace luma
 {
@@ -131,6 +132,17 @@ public:
 		Returns the vlaue of this ranged number.
 	*/
 	T getValue() const;
+
+	/**
+		Writes the value, range and increment of this RangedNumber
+		to the snapshot. See Snapshot.h.
+	*/
+	virtual void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	virtual bool deserialize(SnapshotReader& reader);
 };
 
 
@@ -217,5 +229,25 @@ T RangedNumber<T>::getValue() const
 	return mValue;
 }
 
+template <class T>
+void RangedNumber<T>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mValue);
+	writer.write(mMin);
+	writer.write(mMax);
+	writer.write(mIncrement);
+}
+
+template <class T>
+bool RangedNumber<T>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mValue);
+	reader.read(mMin);
+	reader.read(mMax);
+	reader.read(mIncrement);
+
+	return reader.isOk();
+}
+
 }} //namespace
 #endif
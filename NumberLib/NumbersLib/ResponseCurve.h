@@ -1,6 +1,10 @@
 #ifndef _RESPONSE_CURVE_H_
 #define _RESPONSE_CURVE_H_
 
+#include <stddef.h>
+
+#include "utils.h"
+#include "Simd.h"
 #include "AbstractFunction.h"
 
 namespace luma
@@ -8,6 +12,30 @@ namespace luma
 namespace numbers
 {
 
+/**
+	The type in which ResponseCurve::evaluate() and XYResponseCurve
+	compute where an input lies between the samples. This is double,
+	so that the scale of a curve over integers is not truncated;
+	float and long double curves use their own type.
+*/
+template <class T>
+struct InterpolationScale
+{
+	typedef double Type;
+};
+
+template <>
+struct InterpolationScale<float>
+{
+	typedef float Type;
+};
+
+template <>
+struct InterpolationScale<long double>
+{
+	typedef long double Type;
+};
+
 /**
 	This class is described in AI Programming Wisdom 1, 
 	"The Beauty of Response Curves", by Bob Alexander.
@@ -19,6 +47,8 @@ namespace numbers
 		Number of output samples.
 	@param T
 		The number type of the input and output, usually float or double.
+		For integer types, inputMax - inputMin should be a multiple of
+		n - 1.
 */
 template <class T, unsigned int n>
 class ResponseCurve : public AbstractFunction<T>
@@ -51,31 +81,245 @@ public:
 	*/
 	T operator()(const T input) const;
 
-	inline public T getInputMin() const;
-	inline public T getInputMax() const;
+	/**
+		Calculates the outputs for count inputs at once. The outputs
+		are the same as those of operator() (up to rounding), but
+		this function is not virtual, and evaluates the inputs without
+		branches. For float and double, several inputs are evaluated
+		at once with SSE2 or AVX2 instructions (see Simd.h).
+
+		@param inputs
+			The inputs for which output is sought.
+		@param outputs
+			Receives the outputs. May be the same array as inputs.
+		@param count
+			The number of inputs.
+	*/
+	void evaluate(const T inputs[], T outputs[], size_t count) const;
+
+	inline T getInputMin() const;
+	inline T getInputMax() const;
 
 private:
+	typedef typename InterpolationScale<T>::Type Scale;
+
 	T mInputMin;
 	T mInputMax;
-	T mOutputSamples[n];
+
+	/**
+		The output samples. The last sample is repeated, so that
+		evaluate() needs no special case for inputs at inputMax.
+	*/
+	T mOutputSamples[n + 1];
 
 	/**
 		The difference between two adjacent input values 
 		at sample points.
 	*/
 	T mPeriod;
+
+	/**
+		The reciprocal of mPeriod.
+	*/
+	Scale mScale;
 };
 
+/**
+	Interpolates between the samples of a ResponseCurve for a single
+	input, without branches.
+
+	@param samples
+		The output samples, with the last sample repeated.
+	@param lastIndex
+		The index of the last sample (before the repeated one).
+	@param inputMin
+		The input at the first sample.
+	@param scale
+		The reciprocal of the difference between the inputs at two
+		adjacent samples.
+	@param input
+		The input for which output is sought.
+	@param S
+		The type in which the position between the samples is
+		computed, usually T (see InterpolationScale).
+*/
+template <class T, class S>
+inline T interpolateSamples(const T samples[], S lastIndex, S inputMin, S scale, T input)
+{
+	S x = (input - inputMin) * scale;
+
+	//written so that NaNs end up at index 0
+	x = x > 0 ? x : 0;
+	x = x < lastIndex ? x : lastIndex;
+
+	int index = (int) x;
+	S t = x - (S) index;
+
+	return (T) (samples[index] + t * (samples[index + 1] - samples[index]));
+}
+
+/**
+	Interpolates between the samples of a ResponseCurve for count
+	inputs. This is the scalar version used for types that have no
+	SIMD version.
+*/
+template <class T, class S>
+inline void interpolateSamples(const T samples[], S lastIndex, S inputMin, S scale, const T inputs[], T outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		outputs[i] = interpolateSamples(samples, lastIndex, inputMin, scale, inputs[i]);
+	}
+}
+
+#if defined(NUMBERS_AVX2)
+
+inline void interpolateSamples(const float samples[], float lastIndex, float inputMin, float scale, const float inputs[], float outputs[], size_t count)
+{
+	const __m256 min = _mm256_set1_ps(inputMin);
+	const __m256 factor = _mm256_set1_ps(scale);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 last = _mm256_set1_ps(lastIndex);
+
+	size_t i = 0;
+
+	for(; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(inputs + i), min), factor);
+		x = _mm256_min_ps(_mm256_max_ps(x, zero), last);
+
+		__m256i index = _mm256_cvttps_epi32(x);
+		__m256 t = _mm256_sub_ps(x, _mm256_cvtepi32_ps(index));
+		__m256 a = _mm256_i32gather_ps(samples, index, 4);
+		__m256 b = _mm256_i32gather_ps(samples + 1, index, 4);
+
+#if defined(NUMBERS_FMA)
+		_mm256_storeu_ps(outputs + i, _mm256_fmadd_ps(t, _mm256_sub_ps(b, a), a));
+#else
+		_mm256_storeu_ps(outputs + i, _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a))));
+#endif
+	}
+
+	for(; i < count; i++)
+	{
+		outputs[i] = interpolateSamples(samples, lastIndex, inputMin, scale, inputs[i]);
+	}
+}
+
+inline void interpolateSamples(const double samples[], double lastIndex, double inputMin, double scale, const double inputs[], double outputs[], size_t count)
+{
+	const __m256d min = _mm256_set1_pd(inputMin);
+	const __m256d factor = _mm256_set1_pd(scale);
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d last = _mm256_set1_pd(lastIndex);
+
+	size_t i = 0;
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m256d x = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(inputs + i), min), factor);
+		x = _mm256_min_pd(_mm256_max_pd(x, zero), last);
+
+		__m128i index = _mm256_cvttpd_epi32(x);
+		__m256d t = _mm256_sub_pd(x, _mm256_cvtepi32_pd(index));
+		__m256d a = _mm256_i32gather_pd(samples, index, 8);
+		__m256d b = _mm256_i32gather_pd(samples + 1, index, 8);
+
+#if defined(NUMBERS_FMA)
+		_mm256_storeu_pd(outputs + i, _mm256_fmadd_pd(t, _mm256_sub_pd(b, a), a));
+#else
+		_mm256_storeu_pd(outputs + i, _mm256_add_pd(a, _mm256_mul_pd(t, _mm256_sub_pd(b, a))));
+#endif
+	}
+
+	for(; i < count; i++)
+	{
+		outputs[i] = interpolateSamples(samples, lastIndex, inputMin, scale, inputs[i]);
+	}
+}
+
+#elif defined(NUMBERS_SSE2)
+
+inline void interpolateSamples(const float samples[], float lastIndex, float inputMin, float scale, const float inputs[], float outputs[], size_t count)
+{
+	const __m128 min = _mm_set1_ps(inputMin);
+	const __m128 factor = _mm_set1_ps(scale);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 last = _mm_set1_ps(lastIndex);
+
+	size_t i = 0;
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(inputs + i), min), factor);
+		x = _mm_min_ps(_mm_max_ps(x, zero), last);
+
+		__m128i index = _mm_cvttps_epi32(x);
+		__m128 t = _mm_sub_ps(x, _mm_cvtepi32_ps(index));
+
+		//SSE2 has no gather
+		int indices[4];
+		_mm_storeu_si128((__m128i *) indices, index);
+
+		__m128 a = _mm_setr_ps(samples[indices[0]], samples[indices[1]], samples[indices[2]], samples[indices[3]]);
+		__m128 b = _mm_setr_ps(samples[indices[0] + 1], samples[indices[1] + 1], samples[indices[2] + 1], samples[indices[3] + 1]);
+
+		_mm_storeu_ps(outputs + i, _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))));
+	}
+
+	for(; i < count; i++)
+	{
+		outputs[i] = interpolateSamples(samples, lastIndex, inputMin, scale, inputs[i]);
+	}
+}
+
+inline void interpolateSamples(const double samples[], double lastIndex, double inputMin, double scale, const double inputs[], double outputs[], size_t count)
+{
+	const __m128d min = _mm_set1_pd(inputMin);
+	const __m128d factor = _mm_set1_pd(scale);
+	const __m128d zero = _mm_setzero_pd();
+	const __m128d last = _mm_set1_pd(lastIndex);
+
+	size_t i = 0;
+
+	for(; i + 2 <= count; i += 2)
+	{
+		__m128d x = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(inputs + i), min), factor);
+		x = _mm_min_pd(_mm_max_pd(x, zero), last);
+
+		__m128i index = _mm_cvttpd_epi32(x);
+		__m128d t = _mm_sub_pd(x, _mm_cvtepi32_pd(index));
+
+		int index0 = _mm_cvtsi128_si32(index);
+		int index1 = _mm_cvtsi128_si32(_mm_srli_si128(index, 4));
+
+		__m128d a = _mm_setr_pd(samples[index0], samples[index1]);
+		__m128d b = _mm_setr_pd(samples[index0 + 1], samples[index1 + 1]);
+
+		_mm_storeu_pd(outputs + i, _mm_add_pd(a, _mm_mul_pd(t, _mm_sub_pd(b, a))));
+	}
+
+	for(; i < count; i++)
+	{
+		outputs[i] = interpolateSamples(samples, lastIndex, inputMin, scale, inputs[i]);
+	}
+}
+
+#endif
+
 template <class T, unsigned int n>
 ResponseCurve<T, n>::ResponseCurve(T inputMin, T inputMax, T outputSamples[n]):
 	mInputMin(inputMin),
 	mInputMax(inputMax),
-	mPeriod((inputMax - inputMin) / (n - 1))
+	mPeriod((inputMax - inputMin) / (n - 1)),
+	mScale((n - 1) / (Scale) (inputMax - inputMin))
 {
 	for(unsigned int i = 0; i < n; i++)
 	{
 		mOutputSamples[i] = outputSamples[i];
 	}
+
+	mOutputSamples[n] = outputSamples[n - 1];
 }
 
 template <class T, unsigned int n>
@@ -97,6 +341,12 @@ T ResponseCurve<T, n>::operator()(const T input) const
 	return lerp(input, inputSampleMin, inputSampleMin + mPeriod, mOutputSamples[index], mOutputSamples[index + 1]);
 }
 
+template <class T, unsigned int n>
+void ResponseCurve<T, n>::evaluate(const T inputs[], T outputs[], size_t count) const
+{
+	interpolateSamples(mOutputSamples, (Scale) (n - 1), (Scale) mInputMin, mScale, inputs, outputs, count);
+}
+
 template <class T, unsigned int n>
 T ResponseCurve<T, n>::getInputMin() const
 {
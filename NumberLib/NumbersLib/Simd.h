@@ -0,0 +1,42 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+/**
+	Selects the SIMD instruction sets used by the batch functions
+	of the library, such as ResponseCurve::evaluate.
+
+	The selection is made at compile time, from the instruction sets
+	the compiler targets:
+
+	-	NUMBERS_AVX2 is defined when compiling for AVX2
+		(-mavx2 or -march=native on GCC and Clang, /arch:AVX2 on MSVC).
+	-	NUMBERS_SSE2 is defined when compiling for SSE2, which
+		includes all x64 targets.
+	-	NUMBERS_FMA is defined when fused multiply-add instructions
+		are available.
+
+	Define NUMBERS_NO_SIMD before including any header of the library
+	to use the scalar code only.
+*/
+
+#if !defined(NUMBERS_NO_SIMD)
+	#if defined(__AVX2__)
+		#define NUMBERS_AVX2
+	#endif
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define NUMBERS_SSE2
+	#endif
+
+	#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+		#define NUMBERS_FMA
+	#endif
+#endif
+
+#if defined(NUMBERS_AVX2)
+	#include <immintrin.h>
+#elif defined(NUMBERS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+#endif //_SIMD_H_
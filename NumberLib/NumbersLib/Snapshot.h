@@ -0,0 +1,355 @@
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	@file
+	A binary snapshot format for checkpointing the state of numbers.
+
+	Numbers that have state have the functions
+
+	@code
+	void serialize(SnapshotWriter& writer) const;
+	bool deserialize(SnapshotReader& reader);
+	@endcode
+
+	serialize writes the complete state of the number (including
+	its ranges, weights, thresholds and factors), and deserialize
+	restores it into a number of the same type. Numbers are read
+	back in the order they were written:
+
+	@code
+	std::vector<unsigned char> snapshot;
+	SnapshotWriter writer(snapshot);
+
+	speed.serialize(writer);
+	filters.serialize(writer);
+
+	//later
+	SnapshotReader reader(&snapshot[0], snapshot.size());
+
+	if(!speed.deserialize(reader) || !filters.deserialize(reader))
+	{
+		//the snapshot is damaged, or was written by other types
+	}
+	@endcode
+
+	A snapshot starts with a header that holds SNAPSHOT_VERSION and
+	a byte order mark; values are stored in the byte order and
+	layout of the machine that wrote them. Arrays, such as the ring
+	buffers of filters and the state of banks, are written and read
+	with a single memcpy. The reader works on any block of memory,
+	so a snapshot file can be memory mapped and read in place.
+
+	The number types T must be trivially copyable, as float, double,
+	int and Fixed are.
+
+	The indices that numbers restore, such as the position in a ring
+	buffer, are checked against their template sizes, so that a
+	damaged snapshot fails to read rather than indexing out of range.
+
+	When deserialize fails, the number may have been partly restored,
+	and should be reset or restored from another snapshot.
+*/
+
+/**
+	The version of the snapshot format that SnapshotWriter writes.
+	SnapshotReader reads this and all older versions.
+*/
+const unsigned int SNAPSHOT_VERSION = 1;
+
+/**
+	The first bytes of every snapshot: "LNSS".
+*/
+const unsigned int SNAPSHOT_MAGIC = 0x53534E4C;
+
+/**
+	Written as an unsigned int after the version, so that a reader
+	on a machine with a different byte order can tell.
+*/
+const unsigned int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+/**
+	Appends the state of numbers to a buffer. See Snapshot.h.
+*/
+class SnapshotWriter
+{
+private:
+	std::vector<unsigned char>& mBuffer;
+
+public:
+	/**
+		Constructs a new SnapshotWriter, and writes the snapshot
+		header.
+
+		@param buffer
+			The buffer to which the snapshot is appended.
+	*/
+	SnapshotWriter(std::vector<unsigned char>& buffer);
+
+	/**
+		Writes the bytes of a value.
+	*/
+	template <class T>
+	void write(const T& value);
+
+	/**
+		Writes the bytes of count values at once.
+	*/
+	template <class T>
+	void write(const T values[], size_t count);
+
+	/**
+		Writes all elements of a vector at once. The size is not
+		written.
+	*/
+	template <class T>
+	void write(const std::vector<T>& values);
+
+	/**
+		Returns the size of the buffer in bytes.
+	*/
+	size_t getSize() const;
+};
+
+/**
+	Reads the state of numbers from a snapshot. See Snapshot.h.
+
+	Reading stops at the first failure (a damaged header, reading
+	past the end, a size that does not match or an index out of
+	range); after that, all
+	reads fail, and isOk() returns false.
+*/
+class SnapshotReader
+{
+private:
+	const unsigned char * mData;
+	size_t mSize;
+	size_t mPosition;
+	unsigned int mVersion;
+	bool mOk;
+
+public:
+	/**
+		Constructs a new SnapshotReader, and reads the snapshot
+		header.
+
+		@param data
+			The snapshot. The data is not copied, and must stay
+			valid while this reader is used.
+		@param size
+			The size of the snapshot in bytes.
+	*/
+	SnapshotReader(const void * data, size_t size);
+
+	/**
+		Reads the bytes of a value.
+	*/
+	template <class T>
+	bool read(T& value);
+
+	/**
+		Reads the bytes of count values at once.
+	*/
+	template <class T>
+	bool read(T values[], size_t count);
+
+	/**
+		Reads as many values as the vector holds at once.
+	*/
+	template <class T>
+	bool read(std::vector<T>& values);
+
+	/**
+		Reads a size, and fails unless it is the given size.
+		Numbers write their template sizes (such as the
+		sample count), so that they are not restored from
+		the snapshot of a different type.
+	*/
+	bool expect(unsigned int size);
+
+	/**
+		Reads an index (or count), and fails unless it is less
+		than the given limit. Negative indices fail as well.
+	*/
+	template <class T>
+	bool readIndex(T& index, size_t limit);
+
+	/**
+		Marks the snapshot as damaged, so that this and all
+		further reads fail. Numbers call this when the state
+		they restored is not consistent.
+	*/
+	void fail();
+
+	/**
+		Returns false if any read failed.
+	*/
+	bool isOk() const;
+
+	/**
+		Returns the version of the format of the snapshot.
+	*/
+	unsigned int getVersion() const;
+
+	/**
+		Returns the number of bytes read so far, including
+		the header.
+	*/
+	size_t getPosition() const;
+};
+
+inline SnapshotWriter::SnapshotWriter(std::vector<unsigned char>& buffer):
+	mBuffer(buffer)
+{
+	write(SNAPSHOT_MAGIC);
+	write(SNAPSHOT_VERSION);
+	write(SNAPSHOT_BYTE_ORDER);
+}
+
+template <class T>
+void SnapshotWriter::write(const T& value)
+{
+	write(&value, 1);
+}
+
+template <class T>
+void SnapshotWriter::write(const T values[], size_t count)
+{
+	const unsigned char * bytes = reinterpret_cast<const unsigned char *>(values);
+	size_t byteCount = count * sizeof(T);
+
+	//growing the buffer here, rather than in insert, also avoids a
+	//false -Wstringop-overflow warning of GCC 12
+	if(mBuffer.capacity() - mBuffer.size() < byteCount)
+	{
+		mBuffer.reserve(2 * mBuffer.capacity() + byteCount);
+	}
+
+	mBuffer.insert(mBuffer.end(), bytes, bytes + byteCount);
+}
+
+template <class T>
+void SnapshotWriter::write(const std::vector<T>& values)
+{
+	if(!values.empty())
+	{
+		write(&values[0], values.size());
+	}
+}
+
+inline size_t SnapshotWriter::getSize() const
+{
+	return mBuffer.size();
+}
+
+inline SnapshotReader::SnapshotReader(const void * data, size_t size):
+	mData(static_cast<const unsigned char *>(data)),
+	mSize(size),
+	mPosition(0),
+	mVersion(0),
+	mOk(true)
+{
+	unsigned int magic = 0;
+	unsigned int byteOrder = 0;
+
+	read(magic);
+	read(mVersion);
+	read(byteOrder);
+
+	if(magic != SNAPSHOT_MAGIC || byteOrder != SNAPSHOT_BYTE_ORDER || mVersion == 0 || mVersion > SNAPSHOT_VERSION)
+	{
+		mOk = false;
+	}
+}
+
+template <class T>
+bool SnapshotReader::read(T& value)
+{
+	return read(&value, 1);
+}
+
+template <class T>
+bool SnapshotReader::read(T values[], size_t count)
+{
+	size_t byteCount = count * sizeof(T);
+
+	if(mOk && byteCount == 0)
+	{
+		return true;
+	}
+
+	if(!mOk || byteCount > mSize - mPosition)
+	{
+		mOk = false;
+
+		return false;
+	}
+
+	memcpy(values, mData + mPosition, byteCount);
+	mPosition += byteCount;
+
+	return true;
+}
+
+template <class T>
+bool SnapshotReader::read(std::vector<T>& values)
+{
+	return values.empty() ? mOk : read(&values[0], values.size());
+}
+
+inline bool SnapshotReader::expect(unsigned int size)
+{
+	unsigned int actual = 0;
+
+	if(read(actual) && actual != size)
+	{
+		mOk = false;
+	}
+
+	return mOk;
+}
+
+template <class T>
+bool SnapshotReader::readIndex(T& index, size_t limit)
+{
+	//a negative index converts to a very large size
+	if(read(index) && (size_t) index >= limit)
+	{
+		mOk = false;
+	}
+
+	return mOk;
+}
+
+inline void SnapshotReader::fail()
+{
+	mOk = false;
+}
+
+inline bool SnapshotReader::isOk() const
+{
+	return mOk;
+}
+
+inline unsigned int SnapshotReader::getVersion() const
+{
+	return mVersion;
+}
+
+inline size_t SnapshotReader::getPosition() const
+{
+	return mPosition;
+}
+
+}} //namespace
+
+#endif //_SNAPSHOT_H_
@@ -0,0 +1,180 @@
+#ifndef _TRANSITION_BANK_H_
+#define _TRANSITION_BANK_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "Numbers.h"
+#include "TransitionQueue.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A TransitionBank holds many numbers of the same type, updates all
+	of them with a single call, and appends the numbers whose output
+	changed to a TransitionQueue.
+
+	@code
+	float thresholds[] = {0.7f, 0.7f, 0.7f};
+	float stateValues[] = {1.0f, 0.0f, 0.0f};
+	TransitionBank<BufferedState<3> > moods(agentCount, BufferedState<3>(0, stateValues, thresholds, 0.1f));
+	TransitionQueue<unsigned int> transitions(agentCount);
+
+	//every tick
+	transitions.clear();
+	moods.setValues(observedMoods, elapsedTime, transitions);
+
+	for(size_t i = 0; i < transitions.getCount(); i++)
+	{
+		playAnimation(transitions[i].id, transitions[i].oldState, transitions[i].newState);
+	}
+	@endcode
+
+	The numbers are updated with update(), without virtual calls.
+
+	@param Number
+		The type of the numbers, for example BufferedBool or
+		BufferedState<n>. It should have a non-virtual function
+		bool update(ValueType value, float elapsedTime) that returns
+		whether the output changed.
+*/
+template <class Number>
+class TransitionBank
+{
+public:
+	/**
+		The type of the inputs and outputs of the numbers.
+	*/
+	typedef typename Number::ValueType ValueType;
+
+private:
+	std::vector<Number> mNumbers;
+
+public:
+	/**
+		Constructs a new TransitionBank.
+
+		@param count
+			The number of numbers in this bank.
+		@param prototype
+			Every number starts as a copy of this number.
+	*/
+	TransitionBank(size_t count, const Number& prototype);
+
+	/**
+		Updates every number i with values[i], and appends a
+		transition for every number whose output changed, in
+		order of their indices.
+	*/
+	void setValues(const ValueType values[], float elapsedTime, TransitionQueue<ValueType>& transitions);
+
+	/**
+		Returns the output of number i.
+	*/
+	ValueType getValue(size_t i) const;
+
+	/**
+		Returns number i, for example to force its value.
+		Changes made this way are not reported.
+	*/
+	Number& operator[](size_t i);
+
+	/**
+		Returns number i.
+	*/
+	const Number& operator[](size_t i) const;
+
+	/**
+		Returns the number of numbers in this bank.
+	*/
+	size_t getCount() const;
+
+	/**
+		Writes the state of all numbers to the snapshot, one after
+		the other. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize. The number of numbers
+		must be the same.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class Number>
+TransitionBank<Number>::TransitionBank(size_t count, const Number& prototype):
+	mNumbers(count, prototype)
+{
+}
+
+template <class Number>
+void TransitionBank<Number>::setValues(const ValueType values[], float elapsedTime, TransitionQueue<ValueType>& transitions)
+{
+	for(size_t i = 0; i < mNumbers.size(); i++)
+	{
+		Number& number = mNumbers[i];
+		ValueType oldValue = number.Number::getValue();
+
+		if(number.update(values[i], elapsedTime))
+		{
+			transitions.push((unsigned int) i, oldValue, number.Number::getValue());
+		}
+	}
+}
+
+template <class Number>
+typename TransitionBank<Number>::ValueType TransitionBank<Number>::getValue(size_t i) const
+{
+	return mNumbers[i].Number::getValue();
+}
+
+template <class Number>
+Number& TransitionBank<Number>::operator[](size_t i)
+{
+	return mNumbers[i];
+}
+
+template <class Number>
+const Number& TransitionBank<Number>::operator[](size_t i) const
+{
+	return mNumbers[i];
+}
+
+template <class Number>
+size_t TransitionBank<Number>::getCount() const
+{
+	return mNumbers.size();
+}
+
+template <class Number>
+void TransitionBank<Number>::serialize(SnapshotWriter& writer) const
+{
+	writer.write((unsigned int) mNumbers.size());
+
+	for(size_t i = 0; i < mNumbers.size(); i++)
+	{
+		mNumbers[i].serialize(writer);
+	}
+}
+
+template <class Number>
+bool TransitionBank<Number>::deserialize(SnapshotReader& reader)
+{
+	reader.expect((unsigned int) mNumbers.size());
+
+	for(size_t i = 0; i < mNumbers.size() && reader.isOk(); i++)
+	{
+		mNumbers[i].deserialize(reader);
+	}
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_TRANSITION_BANK_H_
@@ -0,0 +1,172 @@
+#ifndef _TRANSITION_QUEUE_H_
+#define _TRANSITION_QUEUE_H_
+
+#include <stddef.h>
+#include <vector>
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A change of the output of a number in a collection, such as
+	a BufferedBool in a TransitionBank.
+
+	@param State
+		The type of the output, for example bool or unsigned int.
+*/
+template <class State>
+struct Transition
+{
+	/** The index of the number in its collection. */
+	unsigned int id;
+
+	/** The output before the update. */
+	State oldState;
+
+	/** The output after the update. */
+	State newState;
+};
+
+/**
+	A queue of transitions with a fixed capacity, to which
+	TransitionBank and BufferedBoolArray append the transitions of
+	an update, so that downstream systems can react only to the
+	numbers that switched, instead of comparing all outputs with
+	their previous values.
+
+	@code
+	TransitionQueue<bool> transitions(64);
+
+	//every tick
+	transitions.clear();
+	doors.setValues(inputs, elapsedTime, transitions);
+
+	for(size_t i = 0; i < transitions.getCount(); i++)
+	{
+		transitions[i].newState ? open(transitions[i].id) : close(transitions[i].id);
+	}
+	@endcode
+
+	All memory is allocated by the constructor. When the queue is
+	full, further transitions are dropped and counted; after an
+	update that dropped transitions, callers should fall back to
+	reading all outputs.
+
+	@param State
+		The type of the outputs.
+*/
+template <class State>
+class TransitionQueue
+{
+private:
+	std::vector<Transition<State> > mTransitions;
+	size_t mCount;
+	size_t mDroppedCount;
+
+public:
+	/**
+		Constructs a new, empty TransitionQueue.
+
+		@param capacity
+			The largest number of transitions the queue can hold.
+	*/
+	TransitionQueue(size_t capacity);
+
+	/**
+		Appends a transition, or drops it if the queue is full.
+
+		@return
+			false if the transition was dropped.
+	*/
+	bool push(unsigned int id, State oldState, State newState);
+
+	/**
+		Removes all transitions, and resets the dropped count.
+	*/
+	void clear();
+
+	/**
+		Returns the number of transitions in the queue.
+	*/
+	size_t getCount() const;
+
+	/**
+		Returns the largest number of transitions the queue can hold.
+	*/
+	size_t getCapacity() const;
+
+	/**
+		Returns the number of transitions dropped since the last call
+		to clear because the queue was full.
+	*/
+	size_t getDroppedCount() const;
+
+	/**
+		Returns transition i, in the order they were appended.
+	*/
+	const Transition<State>& operator[](size_t i) const;
+};
+
+template <class State>
+TransitionQueue<State>::TransitionQueue(size_t capacity):
+	mTransitions(capacity),
+	mCount(0),
+	mDroppedCount(0)
+{
+}
+
+template <class State>
+bool TransitionQueue<State>::push(unsigned int id, State oldState, State newState)
+{
+	if(mCount == mTransitions.size())
+	{
+		mDroppedCount++;
+
+		return false;
+	}
+
+	Transition<State>& transition = mTransitions[mCount++];
+
+	transition.id = id;
+	transition.oldState = oldState;
+	transition.newState = newState;
+
+	return true;
+}
+
+template <class State>
+void TransitionQueue<State>::clear()
+{
+	mCount = 0;
+	mDroppedCount = 0;
+}
+
+template <class State>
+size_t TransitionQueue<State>::getCount() const
+{
+	return mCount;
+}
+
+template <class State>
+size_t TransitionQueue<State>::getCapacity() const
+{
+	return mTransitions.size();
+}
+
+template <class State>
+size_t TransitionQueue<State>::getDroppedCount() const
+{
+	return mDroppedCount;
+}
+
+template <class State>
+const Transition<State>& TransitionQueue<State>::operator[](size_t i) const
+{
+	return mTransitions[i];
+}
+
+}} //namespace
+
+#endif //_TRANSITION_QUEUE_H_
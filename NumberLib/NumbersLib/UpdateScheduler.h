@@ -0,0 +1,596 @@
+#ifndef _UPDATE_SCHEDULER_H_
+#define _UPDATE_SCHEDULER_H_
+
+#include <stddef.h>
+#include <map>
+#include <vector>
+#include <typeinfo>
+#include <typeindex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Numbers.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	The numbers of one type in an UpdateScheduler. This class is
+	the interface through which the scheduler updates an UpdateArena
+	without knowing the type of its numbers, and should generally not
+	be used on its own.
+*/
+class AbstractUpdateArena
+{
+public:
+	virtual ~AbstractUpdateArena() {}
+
+	/**
+		Returns the number of numbers in this arena.
+	*/
+	virtual size_t getCount() const = 0;
+
+	/**
+		Sets the inputs of numbers begin to end - 1.
+	*/
+	virtual void update(size_t begin, size_t end, float elapsedTime) = 0;
+};
+
+/**
+	Holds all numbers of one concrete type that are updated by an
+	UpdateScheduler, next to their inputs, in one contiguous block.
+
+	Numbers are identified by the index returned by add, which stays
+	valid as more numbers are added (references to the numbers do
+	not).
+
+	@param Number
+		The type of the numbers, for example BufferedNumber<float>. It
+		must have a ValueType, and the functions setValue(value,
+		elapsedTime) and getValue(), as UpdateableNumbers have. They
+		are called without virtual calls.
+*/
+template <class Number>
+class UpdateArena : public AbstractUpdateArena
+{
+public:
+	/**
+		The type of the values of the numbers.
+	*/
+	typedef typename Number::ValueType ValueType;
+
+private:
+	struct Slot
+	{
+		Number number;
+		ValueType input;
+
+		Slot(const Number& prototype);
+	};
+
+	std::vector<Slot> mSlots;
+
+public:
+	/**
+		Adds a copy of the given number. Its input is its current
+		value, so that it is updated towards its current value until
+		setInput is called.
+
+		@return
+			The index of the number in this arena.
+	*/
+	unsigned int add(const Number& number);
+
+	/**
+		Sets the input of number i for the following ticks.
+	*/
+	void setInput(unsigned int i, ValueType value);
+
+	/**
+		Returns the input of number i.
+	*/
+	ValueType getInput(unsigned int i) const;
+
+	/**
+		Returns the value of number i.
+	*/
+	ValueType getValue(unsigned int i) const;
+
+	/**
+		Returns number i, for example to call forceValue.
+	*/
+	Number& getNumber(unsigned int i);
+
+	/**
+		Returns number i.
+	*/
+	const Number& getNumber(unsigned int i) const;
+
+	size_t getCount() const;
+
+	void update(size_t begin, size_t end, float elapsedTime);
+};
+
+/**
+	Updates large collections of numbers of mixed types on several
+	threads.
+
+	Numbers are grouped by their concrete type into arenas (see
+	UpdateArena), so that every arena is updated by a tight loop
+	without virtual calls. Every tick, the arenas are cut into tasks
+	of taskSize numbers; every thread starts on its own contiguous
+	share of the tasks, and threads that run out of work take tasks
+	from the end of the shares of other threads. tick returns when
+	all numbers have been updated.
+
+	@code
+	UpdateScheduler scheduler;
+	UpdateArena<BufferedNumber<float> >& speeds = scheduler.getArena<BufferedNumber<float> >();
+
+	for(int i = 0; i < carCount; i++)
+	{
+		speeds.add(BufferedNumber<float>(0.0f, 0.0f, 100.0f, 0.5f));
+	}
+
+	//every tick
+	for(int i = 0; i < carCount; i++)
+	{
+		speeds.setInput(i, getSpeed(i));
+	}
+
+	scheduler.tick(elapsedTime);
+	@endcode
+
+	The thread that calls tick does its share of the work; the other
+	threads wait for the next tick. Numbers must only be added, and
+	inputs set, between ticks. Numbers of an arena may be updated on
+	different threads, so their setValue functions must not change
+	any state shared with other numbers. This class requires C++11.
+
+	Waking the threads costs some microseconds per tick, so a tick
+	should update at least some tens of thousands of numbers; with
+	a threadCount of 1, no threads are started.
+*/
+class UpdateScheduler
+{
+private:
+	/**
+		Numbers begin to end - 1 of an arena.
+	*/
+	struct Task
+	{
+		AbstractUpdateArena * arena;
+		size_t begin;
+		size_t end;
+	};
+
+	/**
+		The tasks that a thread has not taken yet. The thread takes
+		tasks from the front; other threads take them from the back.
+	*/
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		size_t begin;
+		size_t end;
+
+		/** Keeps the queues of different threads on different cache lines. */
+		char padding[64];
+	};
+
+	std::map<std::type_index, AbstractUpdateArena *> mArenasByType;
+
+	/** The arenas, in the order they were created. */
+	std::vector<AbstractUpdateArena *> mArenas;
+
+	std::vector<Task> mTasks;
+	TaskQueue * mQueues;
+	std::vector<std::thread> mThreads;
+	unsigned int mThreadCount;
+	size_t mTaskSize;
+	float mElapsedTime;
+
+	std::mutex mMutex;
+	std::condition_variable mStart;
+	std::condition_variable mDone;
+
+	/** Increased by every tick, which starts the waiting threads. */
+	unsigned int mTick;
+
+	/** The number of started threads that are still working on this tick. */
+	unsigned int mBusyThreads;
+
+	bool mStopping;
+
+	UpdateScheduler(const UpdateScheduler&);
+	UpdateScheduler& operator=(const UpdateScheduler&);
+
+	/**
+		Cuts the arenas into tasks, and divides them among the queues.
+	*/
+	void prepareTasks();
+
+	/**
+		Takes a task from the queue of the given thread, or from the
+		queue of another thread. Returns false if there are no tasks
+		left.
+	*/
+	bool takeTask(unsigned int thread, Task& task);
+
+	/**
+		Runs tasks until there are none left.
+	*/
+	void runTasks(unsigned int thread);
+
+	/**
+		The loop of the started threads.
+	*/
+	void run(unsigned int thread);
+
+public:
+	/**
+		Constructs a new UpdateScheduler, and starts its threads.
+
+		@param threadCount
+			The number of threads that update numbers, including the
+			thread that calls tick, or 0 to use one thread for every
+			hardware thread.
+		@param taskSize
+			The number of numbers in a task. Smaller tasks balance
+			better; larger tasks have less overhead.
+	*/
+	UpdateScheduler(unsigned int threadCount = 0, size_t taskSize = 1024);
+
+	/**
+		Stops the threads, and destroys all numbers.
+	*/
+	~UpdateScheduler();
+
+	/**
+		Returns the arena that holds the numbers of type Number,
+		and creates it if there is none yet.
+	*/
+	template <class Number>
+	UpdateArena<Number>& getArena();
+
+	/**
+		Adds a copy of the given number to the arena of its type.
+
+		@return
+			The index of the number in its arena.
+	*/
+	template <class Number>
+	unsigned int add(const Number& number);
+
+	/**
+		Sets the input of every number, and returns when all numbers
+		have been updated.
+	*/
+	void tick(float elapsedTime = TIME_UNIT);
+
+	/**
+		Returns the number of threads that update numbers, including
+		the thread that calls tick.
+	*/
+	unsigned int getThreadCount() const;
+
+	/**
+		Returns the number of arenas, which is the number of types
+		of numbers.
+	*/
+	size_t getArenaCount() const;
+
+	/**
+		Returns the number of numbers in all arenas.
+	*/
+	size_t getCount() const;
+};
+
+template <class Number>
+UpdateArena<Number>::Slot::Slot(const Number& prototype):
+	number(prototype),
+	input(prototype.getValue())
+{
+}
+
+template <class Number>
+unsigned int UpdateArena<Number>::add(const Number& number)
+{
+	mSlots.push_back(Slot(number));
+
+	return (unsigned int) (mSlots.size() - 1);
+}
+
+template <class Number>
+void UpdateArena<Number>::setInput(unsigned int i, ValueType value)
+{
+	mSlots[i].input = value;
+}
+
+template <class Number>
+typename UpdateArena<Number>::ValueType UpdateArena<Number>::getInput(unsigned int i) const
+{
+	return mSlots[i].input;
+}
+
+template <class Number>
+typename UpdateArena<Number>::ValueType UpdateArena<Number>::getValue(unsigned int i) const
+{
+	return mSlots[i].number.Number::getValue();
+}
+
+template <class Number>
+Number& UpdateArena<Number>::getNumber(unsigned int i)
+{
+	return mSlots[i].number;
+}
+
+template <class Number>
+const Number& UpdateArena<Number>::getNumber(unsigned int i) const
+{
+	return mSlots[i].number;
+}
+
+template <class Number>
+size_t UpdateArena<Number>::getCount() const
+{
+	return mSlots.size();
+}
+
+template <class Number>
+void UpdateArena<Number>::update(size_t begin, size_t end, float elapsedTime)
+{
+	for(size_t i = begin; i < end; i++)
+	{
+		Slot& slot = mSlots[i];
+
+		//qualified, so that the call is not virtual
+		slot.number.Number::setValue(slot.input, elapsedTime);
+	}
+}
+
+inline UpdateScheduler::UpdateScheduler(unsigned int threadCount, size_t taskSize):
+	mThreadCount(threadCount),
+	mTaskSize(taskSize > 0 ? taskSize : 1),
+	mElapsedTime(TIME_UNIT),
+	mTick(0),
+	mBusyThreads(0),
+	mStopping(false)
+{
+	if(mThreadCount == 0)
+	{
+		mThreadCount = std::thread::hardware_concurrency();
+
+		if(mThreadCount == 0)
+		{
+			mThreadCount = 1;
+		}
+	}
+
+	mQueues = new TaskQueue[mThreadCount];
+
+	for(unsigned int thread = 0; thread < mThreadCount; thread++)
+	{
+		mQueues[thread].begin = 0;
+		mQueues[thread].end = 0;
+	}
+
+	//thread 0 is the thread that calls tick
+	for(unsigned int thread = 1; thread < mThreadCount; thread++)
+	{
+		mThreads.push_back(std::thread(&UpdateScheduler::run, this, thread));
+	}
+}
+
+inline UpdateScheduler::~UpdateScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mStopping = true;
+	}
+
+	mStart.notify_all();
+
+	for(size_t i = 0; i < mThreads.size(); i++)
+	{
+		mThreads[i].join();
+	}
+
+	for(size_t i = 0; i < mArenas.size(); i++)
+	{
+		delete mArenas[i];
+	}
+
+	delete[] mQueues;
+}
+
+template <class Number>
+UpdateArena<Number>& UpdateScheduler::getArena()
+{
+	std::type_index type(typeid(Number));
+	std::map<std::type_index, AbstractUpdateArena *>::iterator found = mArenasByType.find(type);
+
+	if(found != mArenasByType.end())
+	{
+		return *static_cast<UpdateArena<Number> *>(found->second);
+	}
+
+	UpdateArena<Number> * arena = new UpdateArena<Number>();
+
+	mArenasByType[type] = arena;
+	mArenas.push_back(arena);
+
+	return *arena;
+}
+
+template <class Number>
+unsigned int UpdateScheduler::add(const Number& number)
+{
+	return getArena<Number>().add(number);
+}
+
+inline void UpdateScheduler::prepareTasks()
+{
+	mTasks.clear();
+
+	for(size_t i = 0; i < mArenas.size(); i++)
+	{
+		size_t count = mArenas[i]->getCount();
+
+		for(size_t begin = 0; begin < count; begin += mTaskSize)
+		{
+			Task task;
+
+			task.arena = mArenas[i];
+			task.begin = begin;
+			task.end = begin + mTaskSize < count ? begin + mTaskSize : count;
+
+			mTasks.push_back(task);
+		}
+	}
+
+	//contiguous shares, so that every thread starts on its own memory
+	for(unsigned int thread = 0; thread < mThreadCount; thread++)
+	{
+		mQueues[thread].begin = mTasks.size() * thread / mThreadCount;
+		mQueues[thread].end = mTasks.size() * (thread + 1) / mThreadCount;
+	}
+}
+
+inline bool UpdateScheduler::takeTask(unsigned int thread, Task& task)
+{
+	{
+		TaskQueue& queue = mQueues[thread];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if(queue.begin < queue.end)
+		{
+			task = mTasks[queue.begin++];
+
+			return true;
+		}
+	}
+
+	for(unsigned int i = 1; i < mThreadCount; i++)
+	{
+		TaskQueue& victim = mQueues[(thread + i) % mThreadCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if(victim.begin < victim.end)
+		{
+			task = mTasks[--victim.end];
+
+			return true;
+		}
+	}
+
+	//no tasks are added during a tick, so all work is taken
+	return false;
+}
+
+inline void UpdateScheduler::runTasks(unsigned int thread)
+{
+	Task task;
+
+	while(takeTask(thread, task))
+	{
+		task.arena->update(task.begin, task.end, mElapsedTime);
+	}
+}
+
+inline void UpdateScheduler::run(unsigned int thread)
+{
+	unsigned int tick = 0;
+
+	for(;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+
+			while(mTick == tick && !mStopping)
+			{
+				mStart.wait(lock);
+			}
+
+			if(mStopping)
+			{
+				return;
+			}
+
+			tick = mTick;
+		}
+
+		runTasks(thread);
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			if(--mBusyThreads == 0)
+			{
+				mDone.notify_one();
+			}
+		}
+	}
+}
+
+inline void UpdateScheduler::tick(float elapsedTime)
+{
+	mElapsedTime = elapsedTime;
+	prepareTasks();
+
+	if(mThreads.empty())
+	{
+		runTasks(0);
+
+		return;
+	}
+
+	//the lock publishes the tasks and elapsed time to the threads
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mBusyThreads = (unsigned int) mThreads.size();
+		mTick++;
+	}
+
+	mStart.notify_all();
+	runTasks(0);
+
+	//the threads must be done with the queues before the next tick
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while(mBusyThreads > 0)
+	{
+		mDone.wait(lock);
+	}
+}
+
+inline unsigned int UpdateScheduler::getThreadCount() const
+{
+	return mThreadCount;
+}
+
+inline size_t UpdateScheduler::getArenaCount() const
+{
+	return mArenas.size();
+}
+
+inline size_t UpdateScheduler::getCount() const
+{
+	size_t count = 0;
+
+	for(size_t i = 0; i < mArenas.size(); i++)
+	{
+		count += mArenas[i]->getCount();
+	}
+
+	return count;
+}
+
+}} //namespace
+
+#endif //_UPDATE_SCHEDULER_H_
@@ -1,6 +1,10 @@
 #ifndef _UPDATEABLE_NUMBER_H_
 #define _UPDATEABLE_NUMBER_H_
 
+#include <stddef.h>
+
+#include "Numbers.h"
+
 namespace luma
 {
 namespace numbers
@@ -40,6 +44,11 @@ template <class T>
 class UpdateableNumber
 {
 public:
+	/**
+		The type of the values of this number.
+	*/
+	typedef T ValueType;
+
 	/**
 		Get the current value of this AbstractFilteredNumber of the given order.
 	*/
@@ -50,8 +59,41 @@ public:
 		once per update.
 	*/
 	virtual void setValue(T value, float elapsedTime=TIME_UNIT) = 0;
+
+	/**
+		Sets the given values one after the other, as if setValue
+		was called for every value, and writes the value of this
+		number after every update to outputs.
+
+		This function is not virtual. Subclasses hide it with a
+		version that updates the number without virtual calls;
+		this version calls setValue and getValue for every value,
+		and is used for subclasses that do not.
+
+		@param values
+			The input values.
+		@param elapsedTimes
+			The time elapsed before every value, or 0 to use
+			TIME_UNIT for all values.
+		@param outputs
+			Receives the value of getValue() after every update.
+			This may be the same array as values.
+		@param count
+			The number of values.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count);
 };
 
+template <class T>
+void UpdateableNumber<T>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = getValue();
+	}
+}
+
 
 }}//namespace
 #endif //_UPDATEABLE_NUMBER_H_
\ No newline at end of file
@@ -0,0 +1,418 @@
+#ifndef _WEIGHTED_SUM_H_
+#define _WEIGHTED_SUM_H_
+
+#include "utils.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	Describes the shape of the weights of a FilteredNumber.
+
+	If the weights have one of the special shapes, the weighted sum
+	can be updated in constant time when a new sample replaces the
+	oldest one, instead of being recalculated from all samples.
+*/
+enum WeightShape
+{
+	/** Arbitrary weights. The sum is recalculated on every update. */
+	WEIGHTS_GENERAL,
+
+	/** All weights are the same: w_i = c. */
+	WEIGHTS_UNIFORM,
+
+	/** Exponentially decaying weights: w_i = c * r^i, with |r| <= 1. */
+	WEIGHTS_EXPONENTIAL,
+
+	/** Linearly decaying weights: w_i = a - b * i. */
+	WEIGHTS_LINEAR,
+
+	/** The shape is detected from the weights. */
+	WEIGHTS_DETECT
+};
+
+/**
+	Returns the shape of the given weights. Weights that have none
+	of the special shapes (or that would make the constant time
+	update numerically unstable) are WEIGHTS_GENERAL.
+
+	@param n
+		The number of weights.
+*/
+template <class T, unsigned int n>
+WeightShape detectWeightShape(const T weights[]);
+
+/**
+	Maintains the weighted sum of the samples in a ring buffer,
+	where weights[0] is applied to the newest sample, weights[1]
+	to the one before it, and so on.
+
+	This class is used by FilteredNumber, and should generally not
+	be used on its own.
+
+	For the special weight shapes the sum is updated recursively in
+	constant time. To prevent rounding errors from accumulating, the
+	sum is recalculated from all samples every time the ring buffer
+	index wraps around to 0, so the amortised cost stays constant.
+
+	@param n
+		The number of samples in the ring buffer.
+*/
+template <class T, unsigned int n>
+class WeightedSum
+{
+private:
+	WeightShape mShape;
+
+	/** c for uniform and exponential weights, a for linear weights. */
+	T mFirst;
+
+	/** r for exponential weights, b for linear weights. */
+	T mStep;
+
+	/** The weight the oldest sample would have one step later. */
+	T mOldest;
+
+	T mSum;
+
+	/** The sum of all samples, without weights. Used by WEIGHTS_LINEAR. */
+	T mUnweightedSum;
+
+	/**
+		Recalculates the sums from all samples.
+	*/
+	void resum(const T samples[], int index, const T weights[], T zero);
+
+public:
+	/**
+		Constructs a new WeightedSum for the given weights.
+
+		@param weights
+			The weights, which must not change afterwards.
+		@param shape
+			The shape of the weights. If this is WEIGHTS_DETECT,
+			the shape is detected from the weights.
+	*/
+	WeightedSum(const T weights[], WeightShape shape = WEIGHTS_DETECT);
+
+	/**
+		Recalculates the sum from all samples.
+
+		@param samples
+			The ring buffer, with n samples.
+		@param index
+			The index of the newest sample.
+		@param weights
+			The weights passed to the constructor.
+		@param zero
+			A zero of type T.
+	*/
+	T reset(const T samples[], int index, const T weights[], T zero);
+
+	/**
+		Updates the sum after the sample at the given index was
+		replaced with a new sample, and returns the new sum.
+
+		@param samples
+			The ring buffer, with n samples, that already contains
+			the new sample.
+		@param index
+			The index of the new sample.
+		@param oldSample
+			The sample that was replaced.
+		@param weights
+			The weights passed to the constructor.
+		@param zero
+			A zero of type T.
+	*/
+	T update(const T samples[], int index, T oldSample, const T weights[], T zero);
+
+	/**
+		Returns the shape that is used to update the sum.
+	*/
+	WeightShape getShape() const;
+
+	/**
+		Writes the shape and the sums to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+/**
+	The weights of a FilteredNumber, stored in an array that is
+	passed to the constructor. This is the default source of
+	weights of FilteredNumber (see also KernelWeights).
+
+	A source of weights is a class with
+	-	a type Sum, that maintains a weighted sum like WeightedSum;
+	-	a function getWeights, that returns the weights to pass to
+		the functions of Sum;
+	-	a function getWeight(i), that returns the weight of sample i;
+		and
+	-	the functions serialize and deserialize.
+
+	@param n
+		The number of weights.
+*/
+template <class T, unsigned int n>
+class ArrayWeights
+{
+private:
+	T mWeights[n];
+
+public:
+	typedef WeightedSum<T, n> Sum;
+
+	/**
+		Copies the given weights.
+
+		@param weights
+			The weights. The size of the array must be n.
+	*/
+	ArrayWeights(const T weights[]);
+
+	/**
+		Returns the weights.
+	*/
+	const T * getWeights() const;
+
+	/**
+		Returns the weight of sample i.
+	*/
+	T getWeight(int i) const;
+
+	/**
+		Writes the weights to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the weights written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int n>
+WeightShape detectWeightShape(const T weights[])
+{
+	const T tolerance = (T) 0.00001;
+
+	T scale = weights[0] < 0 ? -weights[0] : weights[0];
+	bool uniform = true;
+	bool linear = true;
+	bool exponential = weights[0] != 0;
+
+	T difference = n > 1 ? weights[0] - weights[1] : 0;
+	T ratio = n > 1 && exponential ? weights[1] / weights[0] : 1;
+
+	if(ratio > 1 || ratio < -1)
+	{
+		exponential = false;
+	}
+
+	for(unsigned int i = 1; i < n; i++)
+	{
+		T uniformError = weights[i] - weights[0];
+		T linearError = weights[i - 1] - weights[i] - difference;
+		T exponentialError = weights[i] - weights[i - 1] * ratio;
+
+		uniform = uniform && uniformError <= tolerance * scale && -uniformError <= tolerance * scale;
+		linear = linear && linearError <= tolerance * scale && -linearError <= tolerance * scale;
+		exponential = exponential && exponentialError <= tolerance * scale && -exponentialError <= tolerance * scale;
+	}
+
+	if(uniform)
+	{
+		return WEIGHTS_UNIFORM;
+	}
+	else if(linear)
+	{
+		return WEIGHTS_LINEAR;
+	}
+	else if(exponential)
+	{
+		return WEIGHTS_EXPONENTIAL;
+	}
+
+	return WEIGHTS_GENERAL;
+}
+
+template <class T, unsigned int n>
+WeightedSum<T, n>::WeightedSum(const T weights[], WeightShape shape):
+	mShape(shape == WEIGHTS_DETECT ? detectWeightShape<T, n>(weights) : shape),
+	mFirst(weights[0]),
+	mStep(0),
+	mOldest(0),
+	mSum(0),
+	mUnweightedSum(0)
+{
+	switch(mShape)
+	{
+	case WEIGHTS_UNIFORM:
+		mOldest = mFirst;
+		break;
+
+	case WEIGHTS_LINEAR:
+		mStep = n > 1 ? weights[0] - weights[1] : 0;
+		mOldest = mFirst - mStep * n;
+		break;
+
+	case WEIGHTS_EXPONENTIAL:
+		mStep = n > 1 && weights[0] != 0 ? weights[1] / weights[0] : 0;
+
+		//the recursion is unstable for growing weights
+		if(mStep > 1 || mStep < -1)
+		{
+			mShape = WEIGHTS_GENERAL;
+		}
+
+		mOldest = mFirst;
+
+		for(unsigned int i = 0; i < n; i++)
+		{
+			mOldest *= mStep;
+		}
+		break;
+
+	default:
+		mShape = WEIGHTS_GENERAL;
+		break;
+	}
+}
+
+template <class T, unsigned int n>
+void WeightedSum<T, n>::resum(const T samples[], int index, const T weights[], T zero)
+{
+	mSum = zero;
+	mUnweightedSum = zero;
+
+	for(unsigned int i = 0; i < n; i++)
+	{
+		int slot = wrapIndex<n>(index - (int) i);
+
+		mSum += samples[slot] * weights[i];
+
+		if(mShape == WEIGHTS_LINEAR)
+		{
+			mUnweightedSum += samples[slot];
+		}
+	}
+}
+
+template <class T, unsigned int n>
+T WeightedSum<T, n>::reset(const T samples[], int index, const T weights[], T zero)
+{
+	resum(samples, index, weights, zero);
+
+	return mSum;
+}
+
+template <class T, unsigned int n>
+T WeightedSum<T, n>::update(const T samples[], int index, T oldSample, const T weights[], T zero)
+{
+	T newSample = samples[index];
+
+	//index 0: resynchronise once per cycle
+	switch(index == 0 ? WEIGHTS_GENERAL : mShape)
+	{
+	case WEIGHTS_UNIFORM:
+		mSum += mFirst * (newSample - oldSample);
+		break;
+
+	case WEIGHTS_EXPONENTIAL:
+		mSum = mSum * mStep + mFirst * newSample - mOldest * oldSample;
+		break;
+
+	case WEIGHTS_LINEAR:
+		mSum += mFirst * newSample - mStep * mUnweightedSum - mOldest * oldSample;
+		mUnweightedSum += newSample - oldSample;
+		break;
+
+	default:
+		resum(samples, index, weights, zero);
+		break;
+	}
+
+	return mSum;
+}
+
+template <class T, unsigned int n>
+WeightShape WeightedSum<T, n>::getShape() const
+{
+	return mShape;
+}
+
+template <class T, unsigned int n>
+void WeightedSum<T, n>::serialize(SnapshotWriter& writer) const
+{
+	writer.write((int) mShape);
+	writer.write(mFirst);
+	writer.write(mStep);
+	writer.write(mOldest);
+	writer.write(mSum);
+	writer.write(mUnweightedSum);
+}
+
+template <class T, unsigned int n>
+bool WeightedSum<T, n>::deserialize(SnapshotReader& reader)
+{
+	int shape = 0;
+
+	reader.read(shape);
+	reader.read(mFirst);
+	reader.read(mStep);
+	reader.read(mOldest);
+	reader.read(mSum);
+	reader.read(mUnweightedSum);
+
+	mShape = (WeightShape) shape;
+
+	return reader.isOk();
+}
+
+template <class T, unsigned int n>
+ArrayWeights<T, n>::ArrayWeights(const T weights[])
+{
+	for(unsigned int i = 0; i < n; i++)
+	{
+		mWeights[i] = weights[i];
+	}
+}
+
+template <class T, unsigned int n>
+const T * ArrayWeights<T, n>::getWeights() const
+{
+	return mWeights;
+}
+
+template <class T, unsigned int n>
+T ArrayWeights<T, n>::getWeight(int i) const
+{
+	return mWeights[i];
+}
+
+template <class T, unsigned int n>
+void ArrayWeights<T, n>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mWeights, n);
+}
+
+template <class T, unsigned int n>
+bool ArrayWeights<T, n>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mWeights, n);
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_WEIGHTED_SUM_H_
@@ -0,0 +1,327 @@
+#ifndef _WINDOW_MEDIAN_NUMBER_H_
+#define _WINDOW_MEDIAN_NUMBER_H_
+
+#include "utils.h"
+#include "AbstractFilteredNumber.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	A filtered number whose filtered value is the median of the last
+	sampleCount values, which, unlike a weighted mean, is not pulled
+	away by single spikes.
+
+	The samples are kept in a ring buffer, as in FilteredNumber, and
+	are also ordered in two heaps: a max-heap of the smaller half of
+	the samples, and a min-heap of the larger half, so that the median
+	is at the tops of the heaps. A new sample replaces the oldest one
+	in whichever heap it is in, and is moved into place; every update
+	takes O(log sampleCount) time.
+
+	The window starts out filled with the initial value. The window
+	is a number of samples; the elapsed time is ignored.
+
+	@param T
+		The type of the values; it must have operator<. If sampleCount
+		is even, the median is the mean of the two middle samples, so
+		T must also support + and division by an int.
+	@param sampleCount
+		The number of samples in the window.
+*/
+template <class T, unsigned int sampleCount>
+class WindowMedianNumber : public AbstractFilteredNumber<T, sampleCount, 1>
+{
+private:
+	/** The number of samples in the max-heap of smaller samples. */
+	static const int LOW_COUNT = (sampleCount + 1) / 2;
+
+	/** The number of samples in the min-heap of larger samples. */
+	static const int HIGH_COUNT = sampleCount - LOW_COUNT;
+
+	T mSamples[sampleCount];
+
+	/**
+		The slots of the samples, ordered as two heaps: positions
+		0 to LOW_COUNT - 1 hold the max-heap of smaller samples, and
+		the other positions hold the min-heap of larger samples.
+	*/
+	int mHeap[sampleCount];
+
+	/** The position of every slot in mHeap. */
+	int mPositions[sampleCount];
+
+	int mCurrentIndex;
+	T mCurrentValue;
+	T mInitialValue;
+
+	/**
+		Returns whether the sample at heap position p belongs above
+		the sample at heap position q in their heap.
+	*/
+	bool above(int p, int q) const;
+
+	void swapPositions(int p, int q);
+
+	/**
+		Moves the sample at position base + k up its heap, and
+		returns its new position relative to base.
+	*/
+	int siftUp(int base, int k);
+
+	/**
+		Moves the sample at position base + k down its heap of
+		count samples.
+	*/
+	void siftDown(int base, int count, int k);
+
+public:
+	/**
+		Constructs a new WindowMedianNumber, whose window is filled
+		with the initial value.
+	*/
+	WindowMedianNumber(T initialValue);
+
+	/**
+		Gets the value of the given order: the last value for order
+		0, the median for order 1, and the initial value otherwise.
+	*/
+	T getValue(unsigned int order = 1) const;
+
+	/**
+		Replaces the oldest sample with the given value. The elapsed
+		time is ignored.
+	*/
+	void setValue(T value, float elapsedTime = TIME_UNIT);
+
+	/**
+		Fills the window with the given value.
+	*/
+	void forceValue(T value);
+
+	/**
+		Returns the median of the last sampleCount values.
+	*/
+	T getMedian() const;
+
+	/**
+		See UpdateableNumber::process. The outputs are the values
+		of the given order (by default 1, the median), and the
+		number is updated without virtual calls.
+	*/
+	void process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order = 1);
+
+	/**
+		Writes the samples and the heaps to the snapshot. See
+		Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int sampleCount>
+WindowMedianNumber<T, sampleCount>::WindowMedianNumber(T initialValue):
+	mInitialValue(initialValue)
+{
+	forceValue(initialValue);
+}
+
+template <class T, unsigned int sampleCount>
+bool WindowMedianNumber<T, sampleCount>::above(int p, int q) const
+{
+	//p and q are always in the same heap
+	return p < LOW_COUNT ? mSamples[mHeap[q]] < mSamples[mHeap[p]] : mSamples[mHeap[p]] < mSamples[mHeap[q]];
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::swapPositions(int p, int q)
+{
+	int slot = mHeap[p];
+
+	mHeap[p] = mHeap[q];
+	mHeap[q] = slot;
+	mPositions[mHeap[p]] = p;
+	mPositions[mHeap[q]] = q;
+}
+
+template <class T, unsigned int sampleCount>
+int WindowMedianNumber<T, sampleCount>::siftUp(int base, int k)
+{
+	while(k > 0)
+	{
+		int parent = (k - 1) / 2;
+
+		if(!above(base + k, base + parent))
+		{
+			break;
+		}
+
+		swapPositions(base + k, base + parent);
+		k = parent;
+	}
+
+	return k;
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::siftDown(int base, int count, int k)
+{
+	for(;;)
+	{
+		int child = 2 * k + 1;
+
+		if(child >= count)
+		{
+			break;
+		}
+
+		if(child + 1 < count && above(base + child + 1, base + child))
+		{
+			child++;
+		}
+
+		if(!above(base + child, base + k))
+		{
+			break;
+		}
+
+		swapPositions(base + child, base + k);
+		k = child;
+	}
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::setValue(T value, float /*elapsedTime*/)
+{
+	mCurrentIndex = wrapIndex<sampleCount>(mCurrentIndex + 1);
+	mCurrentValue = value;
+	mSamples[mCurrentIndex] = value;
+
+	int position = mPositions[mCurrentIndex];
+
+	//restore the heap the sample is in; a heap of one sample is
+	//always in order (and skipping it lets the compiler see that
+	//no position is out of bounds)
+	if(position < LOW_COUNT)
+	{
+		if(LOW_COUNT > 1)
+		{
+			siftDown(0, LOW_COUNT, siftUp(0, position));
+		}
+	}
+	else if(HIGH_COUNT > 1)
+	{
+		siftDown(LOW_COUNT, HIGH_COUNT, siftUp(LOW_COUNT, position - LOW_COUNT));
+	}
+
+	//only the changed sample can be on the wrong side, and it is now at a top
+	if(HIGH_COUNT > 0 && mSamples[mHeap[LOW_COUNT]] < mSamples[mHeap[0]])
+	{
+		swapPositions(0, LOW_COUNT);
+
+		if(LOW_COUNT > 1)
+		{
+			siftDown(0, LOW_COUNT, 0);
+		}
+
+		if(HIGH_COUNT > 1)
+		{
+			siftDown(LOW_COUNT, HIGH_COUNT, 0);
+		}
+	}
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::forceValue(T value)
+{
+	mCurrentIndex = 0;
+	mCurrentValue = value;
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		mSamples[i] = value;
+		mHeap[i] = i;
+		mPositions[i] = i;
+	}
+}
+
+template <class T, unsigned int sampleCount>
+T WindowMedianNumber<T, sampleCount>::getMedian() const
+{
+	if(HIGH_COUNT < LOW_COUNT)
+	{
+		return mSamples[mHeap[0]];
+	}
+
+	return (mSamples[mHeap[0]] + mSamples[mHeap[LOW_COUNT]]) / 2;
+}
+
+template <class T, unsigned int sampleCount>
+T WindowMedianNumber<T, sampleCount>::getValue(unsigned int order) const
+{
+	if(order == 0)
+	{
+		return mCurrentValue;
+	}
+	else if(order == 1)
+	{
+		return getMedian();
+	}
+
+	return mInitialValue;
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::process(const T values[], const float elapsedTimes[], T outputs[], size_t count, unsigned int order)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		WindowMedianNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+		outputs[i] = WindowMedianNumber::getValue(order);
+	}
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMedianNumber<T, sampleCount>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(sampleCount);
+	writer.write(mSamples, sampleCount);
+	writer.write(mHeap, sampleCount);
+	writer.write(mPositions, sampleCount);
+	writer.write(mCurrentIndex);
+	writer.write(mCurrentValue);
+	writer.write(mInitialValue);
+}
+
+template <class T, unsigned int sampleCount>
+bool WindowMedianNumber<T, sampleCount>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(sampleCount);
+	reader.read(mSamples, sampleCount);
+	reader.read(mHeap, sampleCount);
+	reader.read(mPositions, sampleCount);
+	reader.readIndex(mCurrentIndex, sampleCount);
+	reader.read(mCurrentValue);
+	reader.read(mInitialValue);
+
+	//the heaps must hold every slot once, at its position
+	for(unsigned int i = 0; i < sampleCount && reader.isOk(); i++)
+	{
+		if(mHeap[i] < 0 || mHeap[i] >= (int) sampleCount || mPositions[mHeap[i]] != (int) i)
+		{
+			reader.fail();
+		}
+	}
+
+	return reader.isOk();
+}
+
+}} //namespace
+
+#endif //_WINDOW_MEDIAN_NUMBER_H_
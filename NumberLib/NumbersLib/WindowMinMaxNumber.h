@@ -0,0 +1,290 @@
+#ifndef _WINDOW_MIN_MAX_NUMBER_H_
+#define _WINDOW_MIN_MAX_NUMBER_H_
+
+#include "utils.h"
+#include "UpdateableNumber.h"
+#include "Snapshot.h"
+
+namespace luma
+{
+namespace numbers
+{
+
+/**
+	The largest (or smallest) of the last sampleCount samples, kept
+	in a monotonic deque: the deque holds the samples that can still
+	become the extremum, in the order they were set, so that the
+	extremum is always at the front. This class is used by
+	WindowMinMaxNumber, and should generally not be used on its own.
+
+	@param keepLarger
+		true to keep the maximum, false to keep the minimum.
+*/
+template <class T, unsigned int sampleCount, bool keepLarger>
+class MonotonicWindow
+{
+private:
+	T mValues[sampleCount];
+
+	/** The sequence numbers of the samples, to tell when they leave the window. */
+	unsigned int mSequences[sampleCount];
+
+	int mFront;
+	unsigned int mCount;
+
+public:
+	/**
+		Makes value (with the given sequence number) the only sample
+		in the deque.
+	*/
+	void reset(T value, unsigned int sequence);
+
+	/**
+		Adds a sample, whose sequence number must be one more than
+		that of the last sample. Takes amortized constant time.
+	*/
+	void push(T value, unsigned int sequence);
+
+	/**
+		Returns the extremum of the last sampleCount samples.
+	*/
+	T getValue() const;
+
+	void serialize(SnapshotWriter& writer) const;
+	bool deserialize(SnapshotReader& reader);
+};
+
+/**
+	Keeps the minimum and maximum of the last sampleCount values,
+	for example to detect spikes in a signal that is also smoothed
+	by a FilteredNumber with the same sample count.
+
+	Every update takes amortized constant time, regardless of the
+	sample count: samples that are smaller than a later sample can
+	never be the maximum again, and are dropped (and likewise for
+	the minimum). The memory used is proportional to sampleCount.
+
+	Like the samples of a FilteredNumber, the window starts out
+	filled with the initial value. The window is a number of
+	samples; the elapsed time is ignored.
+
+	@param T
+		The type of the values; it must have operator<=.
+	@param sampleCount
+		The number of samples in the window.
+*/
+template <class T, unsigned int sampleCount>
+class WindowMinMaxNumber : public UpdateableNumber<T>
+{
+private:
+	MonotonicWindow<T, sampleCount, false> mMinimum;
+	MonotonicWindow<T, sampleCount, true> mMaximum;
+	T mCurrentValue;
+	unsigned int mSequence;
+
+public:
+	/**
+		Constructs a new WindowMinMaxNumber, whose window is
+		filled with the initial value.
+	*/
+	WindowMinMaxNumber(T initialValue);
+
+	/**
+		Adds a sample to the window. The elapsed time is ignored.
+	*/
+	void setValue(T value, float elapsedTime = TIME_UNIT);
+
+	/**
+		Returns the last value that was set.
+	*/
+	T getValue() const;
+
+	/**
+		Returns the smallest of the last sampleCount values.
+	*/
+	T getMinimum() const;
+
+	/**
+		Returns the largest of the last sampleCount values.
+	*/
+	T getMaximum() const;
+
+	/**
+		Fills the window with the given value.
+	*/
+	void forceValue(T value);
+
+	/**
+		Sets the given values one after the other, as if setValue
+		was called for every value, without virtual calls.
+
+		@param minima
+			Receives the minimum after every update, or 0.
+		@param maxima
+			Receives the maximum after every update, or 0.
+	*/
+	void process(const T values[], const float elapsedTimes[], T minima[], T maxima[], size_t count);
+
+	/**
+		Writes both deques to the snapshot. See Snapshot.h.
+	*/
+	void serialize(SnapshotWriter& writer) const;
+
+	/**
+		Reads the state written by serialize.
+	*/
+	bool deserialize(SnapshotReader& reader);
+};
+
+template <class T, unsigned int sampleCount, bool keepLarger>
+void MonotonicWindow<T, sampleCount, keepLarger>::reset(T value, unsigned int sequence)
+{
+	mFront = 0;
+	mCount = 1;
+	mValues[0] = value;
+	mSequences[0] = sequence;
+}
+
+template <class T, unsigned int sampleCount, bool keepLarger>
+void MonotonicWindow<T, sampleCount, keepLarger>::push(T value, unsigned int sequence)
+{
+	//at most one sample leaves the window per update
+	if(sequence - mSequences[mFront] >= sampleCount)
+	{
+		mFront = wrapIndex<sampleCount>(mFront + 1);
+		mCount--;
+	}
+
+	while(mCount > 0)
+	{
+		T back = mValues[wrapIndex<sampleCount>(mFront + (int) mCount - 1)];
+
+		if(keepLarger ? back <= value : value <= back)
+		{
+			mCount--;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	//there is always room: the deque holds at most sampleCount - 1 earlier samples
+	int back = wrapIndex<sampleCount>(mFront + (int) mCount);
+
+	mValues[back] = value;
+	mSequences[back] = sequence;
+	mCount++;
+}
+
+template <class T, unsigned int sampleCount, bool keepLarger>
+T MonotonicWindow<T, sampleCount, keepLarger>::getValue() const
+{
+	return mValues[mFront];
+}
+
+template <class T, unsigned int sampleCount, bool keepLarger>
+void MonotonicWindow<T, sampleCount, keepLarger>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(mValues, sampleCount);
+	writer.write(mSequences, sampleCount);
+	writer.write(mFront);
+	writer.write(mCount);
+}
+
+template <class T, unsigned int sampleCount, bool keepLarger>
+bool MonotonicWindow<T, sampleCount, keepLarger>::deserialize(SnapshotReader& reader)
+{
+	reader.read(mValues, sampleCount);
+	reader.read(mSequences, sampleCount);
+	reader.readIndex(mFront, sampleCount);
+	reader.readIndex(mCount, sampleCount + 1);
+
+	return reader.isOk();
+}
+
+template <class T, unsigned int sampleCount>
+WindowMinMaxNumber<T, sampleCount>::WindowMinMaxNumber(T initialValue)
+{
+	forceValue(initialValue);
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMinMaxNumber<T, sampleCount>::setValue(T value, float /*elapsedTime*/)
+{
+	mSequence++;
+	mCurrentValue = value;
+	mMinimum.push(value, mSequence);
+	mMaximum.push(value, mSequence);
+}
+
+template <class T, unsigned int sampleCount>
+T WindowMinMaxNumber<T, sampleCount>::getValue() const
+{
+	return mCurrentValue;
+}
+
+template <class T, unsigned int sampleCount>
+T WindowMinMaxNumber<T, sampleCount>::getMinimum() const
+{
+	return mMinimum.getValue();
+}
+
+template <class T, unsigned int sampleCount>
+T WindowMinMaxNumber<T, sampleCount>::getMaximum() const
+{
+	return mMaximum.getValue();
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMinMaxNumber<T, sampleCount>::forceValue(T value)
+{
+	//the last of sampleCount equal samples stands for all of them
+	mSequence = 0;
+	mCurrentValue = value;
+	mMinimum.reset(value, mSequence);
+	mMaximum.reset(value, mSequence);
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMinMaxNumber<T, sampleCount>::process(const T values[], const float elapsedTimes[], T minima[], T maxima[], size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		WindowMinMaxNumber::setValue(values[i], elapsedTimes ? elapsedTimes[i] : TIME_UNIT);
+
+		if(minima)
+		{
+			minima[i] = mMinimum.getValue();
+		}
+
+		if(maxima)
+		{
+			maxima[i] = mMaximum.getValue();
+		}
+	}
+}
+
+template <class T, unsigned int sampleCount>
+void WindowMinMaxNumber<T, sampleCount>::serialize(SnapshotWriter& writer) const
+{
+	writer.write(sampleCount);
+	writer.write(mCurrentValue);
+	writer.write(mSequence);
+	mMinimum.serialize(writer);
+	mMaximum.serialize(writer);
+}
+
+template <class T, unsigned int sampleCount>
+bool WindowMinMaxNumber<T, sampleCount>::deserialize(SnapshotReader& reader)
+{
+	reader.expect(sampleCount);
+	reader.read(mCurrentValue);
+	reader.read(mSequence);
+
+	return mMinimum.deserialize(reader) && mMaximum.deserialize(reader);
+}
+
+}} //namespace
+
+#endif //_WINDOW_MIN_MAX_NUMBER_H_
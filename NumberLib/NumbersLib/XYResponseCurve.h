@@ -2,6 +2,7 @@
 #define _XY_RESPONSE_CURVE_H
 
 #include "AbstractFunction.h"
+#include "ResponseCurve.h"
 
 namespace luma
 {
@@ -10,11 +11,26 @@ namespace numbers
 /**
 	Similar to ResponseCurve, but allows sample points to be unevenly spaced.
 
-	This curve is slower than the ordinary ResponseCurve. However, it is useful 
-	for generating the inverse of a monotonic function. For rapid access, this 
-	curve should be sampled into a ordinary ResponseCurve.
+	This curve is useful for generating the inverse of a monotonic function. 
+
+	To find the input samples around an input quickly, the input range is 
+	divided into bucketCount equal buckets, and for every bucket the range 
+	of input sample indices it overlaps is stored. A lookup then only 
+	searches the samples in one bucket, which takes constant time when 
+	the samples are not too unevenly spaced. The result is exactly the
+	same as without the buckets.
+
+	@param T
+		The number type of the input and output, usually float or double.
+		For integer types, the buckets and the interpolation are computed
+		in double (see InterpolationScale), and the output is truncated.
+	@param n
+		Number of samples.
+	@param bucketCount
+		The number of buckets used to speed up lookups. If this is 0, 
+		the input samples are searched with a binary search.
 */
-template<class T, unsigned int n>
+template<class T, unsigned int n, unsigned int bucketCount = n>
 class XYResponseCurve: public AbstractFunction<T>
 {
 public:
@@ -44,6 +60,10 @@ public:
 	*/
 	T operator()(const T input) const;
 	
+	/**
+		Swaps the input and output samples. The output samples 
+		must be strictly increasing.
+	*/
 	void makeInverse();
 
 	/**
@@ -52,23 +72,49 @@ public:
 	unsigned int findInputIndex(const T input) const;
 
 private:
+	typedef typename InterpolationScale<T>::Type Scale;
+
 	T mInputSamples[n];
 	T mOutputSamples[n];
-	
+
+	/**
+		For every bucket b, the input samples with index 
+		mBucketIndices[b] + 1 up to mBucketIndices[b + 1] 
+		fall in bucket b.
+	*/
+	unsigned int mBucketIndices[bucketCount + 1];
+
+	/**
+		The number of buckets per unit input, or 0 if all input
+		samples are the same.
+	*/
+	Scale mBucketScale;
+
+	/**
+		Returns the bucket an input falls in.
+	*/
+	inline unsigned int findBucket(const T input) const;
+
+	/**
+		Rebuilds the buckets from the input samples.
+	*/
+	void buildBuckets();
 };
 
-template<class T, unsigned int n> 
-XYResponseCurve<T, n>::XYResponseCurve(T inputSamples[n], T outputSamples[n])
+template<class T, unsigned int n, unsigned int bucketCount> 
+XYResponseCurve<T, n, bucketCount>::XYResponseCurve(T inputSamples[n], T outputSamples[n])
 {
 	for(unsigned i = 0; i < n; i++)
 	{
 		mInputSamples[i] = inputSamples[i];
 		mOutputSamples[i] = outputSamples[i];
 	}
+
+	buildBuckets();
 }
 
-template<class T, unsigned int n> 
-T XYResponseCurve<T, n>::operator()(const T input) const
+template<class T, unsigned int n, unsigned int bucketCount> 
+T XYResponseCurve<T, n, bucketCount>::operator()(const T input) const
 {
 	if (input <= mInputSamples[0])
 	{
@@ -86,19 +132,27 @@ T XYResponseCurve<T, n>::operator()(const T input) const
 	T x1 = mInputSamples[index + 1];
 	T x0 = mInputSamples[index];
 
-	T tau = (input - x0) / (x1 - x0);
+	Scale tau = (Scale) (input - x0) / (Scale) (x1 - x0);
 	T y1 = mOutputSamples[index + 1];
 	T y0 = mOutputSamples[index];
-	return (y1 - y0) * tau + y0;
+	return (T) ((y1 - y0) * tau + y0);
 }
 
-template<class T, unsigned int n> 
-unsigned int XYResponseCurve<T, n>::findInputIndex(const T input) const
+template<class T, unsigned int n, unsigned int bucketCount> 
+unsigned int XYResponseCurve<T, n, bucketCount>::findInputIndex(const T input) const
 {
 	unsigned int min = 0;
 	unsigned int max = n;
 	unsigned int mid;
 
+	if(bucketCount > 0)
+	{
+		unsigned int bucket = findBucket(input);
+
+		min = mBucketIndices[bucket];
+		max = mBucketIndices[bucket + 1] + 1;
+	}
+
 	while (max > min + 1)
 	{
 		mid = (max + min) / 2 ;
@@ -116,8 +170,8 @@ unsigned int XYResponseCurve<T, n>::findInputIndex(const T input) const
 
 	return min;
 }
-template<class T, unsigned int n> 
-void XYResponseCurve<T, n>::makeInverse()
+template<class T, unsigned int n, unsigned int bucketCount> 
+void XYResponseCurve<T, n, bucketCount>::makeInverse()
 {
 	T tmp;
 
@@ -127,10 +181,57 @@ void XYResponseCurve<T, n>::makeInverse()
 		mInputSamples[i] = mOutputSamples[i];
 		mOutputSamples[i] = tmp;
 	}
+
+	buildBuckets();
 }
 
+template<class T, unsigned int n, unsigned int bucketCount> 
+unsigned int XYResponseCurve<T, n, bucketCount>::findBucket(const T input) const
+{
+	Scale x = (Scale) (input - mInputSamples[0]) * mBucketScale;
 
+	//written so that NaNs end up in bucket 0
+	x = x > 0 ? x : 0;
+	x = x < (Scale) (bucketCount - 1) ? x : (Scale) (bucketCount - 1);
+
+	return (unsigned int) x;
 }
+
+template<class T, unsigned int n, unsigned int bucketCount> 
+void XYResponseCurve<T, n, bucketCount>::buildBuckets()
+{
+	if(bucketCount == 0)
+	{
+		return;
+	}
+
+	Scale range = (Scale) (mInputSamples[n - 1] - mInputSamples[0]);
+
+	//with a single sample, all inputs fall in bucket 0
+	mBucketScale = range > 0 ? bucketCount / range : 0;
+
+	/*
+		findBucket is monotonic, so an input in bucket b lies to the right
+		of all samples in earlier buckets, and to the left of all samples
+		in later buckets. Its index is therefore between the index of the
+		last sample before bucket b and the index of the last sample in
+		bucket b. The buckets of the samples are calculated with the same
+		function as those of inputs, so that rounding cannot break this.
+	*/
+	unsigned int sample = 0;
+
+	for(unsigned int bucket = 0; bucket <= bucketCount; bucket++)
+	{
+		while(sample < n && findBucket(mInputSamples[sample]) < bucket)
+		{
+			sample++;
+		}
+
+		mBucketIndices[bucket] = sample > 0 ? sample - 1 : 0;
+	}
 }
 
+
+}} //namespace
+
 #endif //_XYRESPONSE_CURVE_H
\ No newline at end of file
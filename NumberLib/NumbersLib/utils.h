@@ -54,6 +54,40 @@ inline T clamp(const T& value, const T& minValue, const T& maxValue);
 template <class T>
 inline T mod(const T& value, const T& minValue, const T& maxValue);
 
+/**
+	Returns the same as mod, but only for values that lie at most one 
+	range outside the range, that is, between (2 * minValue - maxValue)
+	and (2 * maxValue - minValue). This is the case when a value in the 
+	range is moved by at most the size of the range, as when a 
+	CyclicNumber is incremented.
+
+	Only comparisons and subtractions are used, no division, and 
+	compilers generally replace the comparisons with conditional moves.
+	mod uses this function for values that are in its range.
+*/
+template <class T>
+inline T wrap(const T& value, const T& minValue, const T& maxValue);
+
+/**
+	Returns index mod n, for indices between -n and 2 * n (excluding 
+	2 * n), for stepping through ring buffers of n elements.
+
+	If n is a power of two, the index is masked (and any index is 
+	allowed); otherwise it is wrapped like wrap().
+*/
+template <unsigned int n>
+inline int wrapIndex(int index);
+
+/**
+	Returns value * elapsedTime * timeScale, converted to T. Ranged
+	numbers use this to scale their increments by the elapsed time.
+
+	Fixed point types overload this function so that the scaling is
+	done in integer arithmetic (see Fixed.h).
+*/
+template <class T>
+inline T scaleByTime(const T& value, float elapsedTime, float timeScale);
+
 /**
 	Returns a number reflected between the bounds.
 
@@ -150,7 +184,7 @@ inline T floor(T x);
 	inputs to use to make a decision.
 */
 template <class T>
-inline T extreme(T v1, T v2, T center);
+inline T extreme(T v1, T v2, T center = 0);
 
 /**
 	Integrates a sequence of numbers. Same as accumulating the sequence in place. 
@@ -183,13 +217,51 @@ inline T clamp(const T& value, const T& minValue, const T& maxValue)
 	return min(maxValue, max(minValue, value));
 }
 
+/**
+	Returns dividend / divisor rounded towards 0. For integer types this
+	is ordinary division; float, double and long double are overloaded
+	below, and Fixed in Fixed.h. Any other type whose division does not
+	truncate needs an overload of its own. Used by mod.
+*/
+template <class T>
+inline T truncatedQuotient(const T& dividend, const T& divisor)
+{
+	return dividend / divisor;
+}
+
+inline float truncatedQuotient(const float& dividend, const float& divisor)
+{
+	float quotient = dividend / divisor;
+
+	return (float) (quotient >= 0 ? ::floor(quotient) : ::ceil(quotient));
+}
+
+inline double truncatedQuotient(const double& dividend, const double& divisor)
+{
+	double quotient = dividend / divisor;
+
+	return quotient >= 0 ? ::floor(quotient) : ::ceil(quotient);
+}
+
+inline long double truncatedQuotient(const long double& dividend, const long double& divisor)
+{
+	long double quotient = dividend / divisor;
+
+	return quotient >= 0 ? floorl(quotient) : ceill(quotient);
+}
+
 template <class T>
 inline T mod(const T& value, const T& minValue, const T& maxValue)
 {
 	T tmpValue = value - minValue;
 	T range = maxValue - minValue;
 
-	int quotient = (int)(tmpValue / range);
+	if(tmpValue >= -range && tmpValue < range + range)
+	{
+		return wrap(value, minValue, maxValue);
+	}
+
+	T quotient = truncatedQuotient(tmpValue, range);
 	T remainder = tmpValue - quotient * range;
 
 	if (remainder < 0)
@@ -200,6 +272,37 @@ inline T mod(const T& value, const T& minValue, const T& maxValue)
 	return minValue + remainder;
 }
 
+template <class T>
+inline T wrap(const T& value, const T& minValue, const T& maxValue)
+{
+	T tmpValue = value - minValue;
+	T range = maxValue - minValue;
+
+	tmpValue = tmpValue >= range ? tmpValue - range : tmpValue;
+	tmpValue = tmpValue < 0 ? tmpValue + range : tmpValue;
+
+	return minValue + tmpValue;
+}
+
+template <unsigned int n>
+inline int wrapIndex(int index)
+{
+	if((n & (n - 1)) == 0)
+	{
+		return index & (int) (n - 1);
+	}
+
+	index = index >= (int) n ? index - (int) n : index;
+
+	return index < 0 ? index + (int) n : index;
+}
+
+template <class T>
+inline T scaleByTime(const T& value, float elapsedTime, float timeScale)
+{
+	return (T) (value * elapsedTime * timeScale);
+}
+
 template <class T>
 inline T reflect(const T& value, const T& minValue, const T& maxValue)
 {
@@ -259,7 +362,7 @@ inline T floor(T x)
 }
 
 template <class T>
-inline T extreme(T v1, T v2, T center = 0)
+inline T extreme(T v1, T v2, T center)
 {
 	return abs(v1 - center) > abs(v2 - center) ? v1 : v2;
 }
@@ -12,23 +12,46 @@
 #include "TestClampedNumber.h"
 #include "TestCyclicNumber.h"
 #include "TestPingPongNumber.h"
+#include "TestBasicRangedNumber.h"
+#include "TestFixed.h"
+#include "TestClock.h"
 
 #include "TestBufferedBool.h"
+#include "TestBufferedBoolArray.h"
 #include "TestBufferedState.h"
+#include "TestLazyBufferedState.h"
 #include "TestBufferedStep.h"
+#include "TestTransitionBank.h"
 
 #include "TestResponseCurve.h"
+#include "TestFastSigmoid.h"
 #include "TestBufferedNumber.h"
 
 #include "TestFilteredNumber.h"
+#include "TestFilteredNumberBank.h"
+#include "TestKernelFilteredNumber.h"
 
 #include "TestDifferentiableNumber.h"
 #include "TestIntegrableNumber.h"
 #include "TestPIDBufferedNumber.h"
+#include "TestPIDControllerBank.h"
+
+#include "TestSnapshot.h"
+#include "TestNumberPool.h"
+#include "TestExponentialFilteredNumber.h"
+#include "TestWindowMinMaxNumber.h"
+#include "TestWindowMedianNumber.h"
 
 #include "TestPeriodicResponseCurve.h"
 #include "TestXYResponseCurve.h"
 
+//These need C++11, which the Visual Studio 2008 projects do not have.
+//Visual Studio does not report C++11 in __cplusplus by default.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#include "TestPublishedNumber.h"
+#include "TestUpdateScheduler.h"
+#endif
+
 #include "BufferedNumber.h"
 
 #include <stdlib.h>
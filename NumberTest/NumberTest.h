@@ -3,4 +3,12 @@
 
 #define FLOAT_THRESHOLD 0.0001f
 
+/**
+	The parameters of a helper function that makes checks for the
+	TEST that calls it, and the arguments the TEST passes to it.
+	The CHECK macros of UnitTest++ report through these.
+*/
+#define TEST_HELPER_PARAMETERS UnitTest::TestResults& testResults_, UnitTest::TestDetails const& m_details
+#define TEST_HELPER_ARGUMENTS testResults_, m_details
+
 #endif //_NUMBER_TEST_H
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "UnitTest++.h"
+#include "BasicRangedNumber.h"
+#include "ClampedNumber.h"
+#include "CyclicNumber.h"
+#include "PingPongNumber.h"
+#include "BufferedNumber.h"
+
+using namespace luma::numbers;
+
+SUITE(TestBasicRangedNumber)
+{
+	TEST(TestSize)
+	{
+		CHECK_EQUAL(4 * sizeof(int), sizeof(BasicRangedNumber<int, ClampPolicy>));
+		CHECK_EQUAL(4 * sizeof(int), sizeof(BasicRangedNumber<int, CyclicPolicy>));
+		CHECK_EQUAL(4 * sizeof(int), sizeof(BasicRangedNumber<int, ReflectPolicy>));
+	}
+
+	TEST(TestConstructorValueInit)
+	{
+		BasicRangedNumber<int, ClampPolicy> c(12, 0, 10, 1);
+		BasicRangedNumber<int, CyclicPolicy> y(12, 0, 10, 1);
+		BasicRangedNumber<int, ReflectPolicy> p(5, 2, 5, 1);
+
+		CHECK_EQUAL(9, c.getValue());
+		CHECK_EQUAL(2, y.getValue());
+		CHECK_EQUAL(3, p.getValue());
+	}
+
+	TEST(TestSameAsClampedNumber)
+	{
+		ClampedNumber<int> n(0, -3, 4, 1);
+		BasicRangedNumber<int, ClampPolicy> b(0, -3, 4, 1);
+
+		for(int i = 0; i < 20; i++)
+		{
+			if(i % 7 < 4)
+			{
+				n++;
+				b++;
+			}
+			else
+			{
+				n--;
+				b--;
+			}
+
+			CHECK_EQUAL((int) n, (int) b);
+		}
+	}
+
+	TEST(TestSameAsCyclicNumber)
+	{
+		CyclicNumber<int> n(0, -3, 4, 1);
+		BasicRangedNumber<int, CyclicPolicy> b(0, -3, 4, 1);
+
+		for(int i = 0; i < 20; i++)
+		{
+			if(i % 9 < 6)
+			{
+				n++;
+				b++;
+			}
+			else
+			{
+				n--;
+				b--;
+			}
+
+			CHECK_EQUAL((int) n, (int) b);
+		}
+	}
+
+	TEST(TestSameAsPingPongNumber)
+	{
+		PingPongNumber<int> n(2, 2, 5, 1);
+		BasicRangedNumber<int, ReflectPolicy> b(2, 2, 5, 1);
+
+		for(int i = 0; i < 20; i++)
+		{
+			if(i % 9 < 6)
+			{
+				n++;
+				b++;
+			}
+			else
+			{
+				n--;
+				b--;
+			}
+
+			CHECK_EQUAL((int) n, (int) b);
+		}
+	}
+
+	TEST(TestIncWithElapsedTime)
+	{
+		ClampedNumber<float> n(0.0f, -3.0f, 3.0f, 0.1f);
+		BasicRangedNumber<float, ClampPolicy> b(0.0f, -3.0f, 3.0f, 0.1f);
+
+		for(int i = 0; i < 40; i++)
+		{
+			n.inc(0.9f);
+			b.inc(0.9f);
+
+			CHECK_CLOSE((float) n, (float) b, FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestBufferedNumber)
+	{
+		BufferedNumber<float> n(0.0f, -3, 3, 0.1f);
+		BufferedNumber<float, BasicRangedNumber<float, ClampPolicy> > b(0.0f, -3, 3, 0.1f);
+
+		for(int i = 1; i < 40; i++)
+		{
+			float value = i < 20 ? 1.3f : -0.7f;
+
+			n.setValue(value, 0.95f);
+			b.setValue(value, 0.95f);
+
+			CHECK_CLOSE(n.getValue(), b.getValue(), FLOAT_THRESHOLD);
+		}
+	}
+}
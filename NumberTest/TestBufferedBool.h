@@ -92,4 +92,43 @@ SUITE(TestBufferedBool)
 		CHECK_EQUAL(true, b.getValue());
 
 	}
-}
\ No newline at end of file
+
+	TEST(TestProcess)
+	{
+		BufferedBool expected(0.2f, 0.5f, 0.1f);
+		BufferedBool actual(0.2f, 0.5f, 0.1f);
+		bool values[] = {true, true, true, true, true, true, false, false, false, false};
+		bool outputs[10];
+
+		actual.process(values, 0, outputs, 10);
+
+		for(int i = 0; i < 10; i++)
+		{
+			expected.setValue(values[i]);
+			CHECK_EQUAL(expected.getValue(), outputs[i]);
+		}
+
+		CHECK_EQUAL(true, outputs[5]);
+		CHECK_CLOSE(expected.getFloatValue(), actual.getFloatValue(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestUpdateReportsChange)
+	{
+		BufferedBool b(0.3f, 0.6f, 0.1f);
+
+		for(int i = 0; i < 6; i++)
+		{
+			CHECK_EQUAL(false, b.update(true));
+		}
+
+		CHECK_EQUAL(true, b.update(true));
+
+		for(int j = 0; j < 4; j++)
+		{
+			CHECK_EQUAL(false, b.update(false));
+		}
+
+		CHECK_EQUAL(true, b.update(false));
+		CHECK_EQUAL(false, b.getValue());
+	}
+}
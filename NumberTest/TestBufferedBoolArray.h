@@ -0,0 +1,207 @@
+#include <vector>
+
+#include "UnitTest++.h"
+#include "BufferedBool.h"
+#include "BufferedBoolArray.h"
+
+using namespace luma::numbers;
+
+SUITE(TestBufferedBoolArray)
+{
+	TEST(TestConstructor)
+	{
+		BufferedBoolArray<> flags(70, 0.3f, 0.7f, 0.1f);
+
+		CHECK_EQUAL(70u, flags.getCount());
+		CHECK_EQUAL(3u, flags.getWordCount());
+
+		for(size_t i = 0; i < 70; i++)
+		{
+			CHECK_EQUAL(false, flags.getValue(i));
+		}
+	}
+
+	TEST(TestEmpty)
+	{
+		BufferedBoolArray<> flags(0, 0.3f, 0.7f, 0.1f);
+
+		flags.setValues(0);
+
+		CHECK_EQUAL(0u, flags.getWordCount());
+		CHECK(flags.getValues() == 0);
+		CHECK(flags.getChanged() == 0);
+		CHECK_EQUAL(0u, flags.nextChanged(0));
+	}
+
+	TEST(TestSameAsBufferedBool)
+	{
+		const size_t count = 101;
+		BufferedBoolArray<> flags(count, 0.3f, 0.6f, 0.1f);
+		std::vector<BufferedBool> expected(count, BufferedBool(0.3f, 0.6f, 0.1f));
+		BufferedBoolArray<>::Word inputs[4];
+
+		for(int step = 0; step < 200; step++)
+		{
+			float elapsedTime = 0.5f + (rand() % 100) / 100.0f;
+
+			for(int word = 0; word < 4; word++)
+			{
+				//flags switch more often when they are mostly on or mostly off
+				inputs[word] = step % 40 < 20 ? rand() | rand() : rand() & rand();
+			}
+
+			flags.setValues(inputs, elapsedTime);
+
+			for(size_t i = 0; i < count; i++)
+			{
+				expected[i].setValue((inputs[i / 32] >> (i % 32)) & 1, elapsedTime);
+
+				CHECK_EQUAL(expected[i].getValue(), flags.getValue(i));
+				CHECK_EQUAL(expected[i].getFloatValue(), flags.getLevel(i));
+			}
+		}
+	}
+
+	TEST(TestUnsignedShortLevels)
+	{
+		//the SIMD version against the scalar version
+		unsigned short levels[32];
+		unsigned short expectedLevels[32];
+		unsigned short tops[32];
+		unsigned short bottoms[32];
+
+		for(int i = 0; i < 32; i++)
+		{
+			levels[i] = expectedLevels[i] = (unsigned short) (rand() % 60000);
+			tops[i] = (unsigned short) (rand() % 65536);
+			bottoms[i] = (unsigned short) (rand() % 65536);
+		}
+
+		for(int step = 0; step < 100; step++)
+		{
+			unsigned int inputs = (unsigned int) rand() ^ ((unsigned int) rand() << 16);
+			unsigned short increment = (unsigned short) (rand() % 5000);
+			unsigned int notBelow;
+			unsigned int expectedNotBelow;
+
+			unsigned int above = updateBufferedBoolLanes(levels, inputs, increment, (unsigned short) 60000, tops, bottoms, notBelow);
+			unsigned int expectedAbove = updateBufferedBoolLanes<unsigned short>(expectedLevels, inputs, increment, (unsigned short) 60000, tops, bottoms, expectedNotBelow);
+
+			CHECK_EQUAL(expectedAbove, above);
+			CHECK_EQUAL(expectedNotBelow, notBelow);
+
+			for(int i = 0; i < 32; i++)
+			{
+				CHECK_EQUAL(expectedLevels[i], levels[i]);
+			}
+		}
+	}
+
+	TEST(TestUnsignedShortSwitching)
+	{
+		BufferedBoolArray<unsigned short> flags(40, 0.35f, 0.65f, 0.1f);
+		BufferedBoolArray<unsigned short>::Word on[] = {0xFFFFFFFF, 0xFF};
+		BufferedBoolArray<unsigned short>::Word off[] = {0, 0};
+
+		for(int i = 0; i < 6; i++)
+		{
+			flags.setValues(on);
+			CHECK_EQUAL(false, flags.getValue(39));
+		}
+
+		flags.setValues(on);
+		CHECK_EQUAL(true, flags.getValue(0));
+		CHECK_EQUAL(true, flags.getValue(39));
+
+		for(int i = 0; i < 3; i++)
+		{
+			flags.setValues(off);
+			CHECK_EQUAL(true, flags.getValue(39));
+		}
+
+		flags.setValues(off);
+		CHECK_EQUAL(false, flags.getValue(39));
+	}
+
+	TEST(TestChanged)
+	{
+		BufferedBoolArray<> flags(100, 0.3f, 0.5f, 0.25f);
+		BufferedBoolArray<>::Word inputs[4] = {0, 0, 0, 0};
+
+		//flags 3, 40 and 99 switch on after three updates
+		inputs[0] = 1 << 3;
+		inputs[1] = 1 << 8;
+		inputs[3] = 1 << 3;
+
+		flags.setValues(inputs);
+		flags.setValues(inputs);
+		CHECK_EQUAL(100u, flags.nextChanged(0));
+
+		flags.setValues(inputs);
+
+		size_t changed[4];
+		int changedCount = 0;
+
+		for(size_t i = flags.nextChanged(0); i < flags.getCount(); i = flags.nextChanged(i + 1))
+		{
+			changed[changedCount++] = i;
+		}
+
+		CHECK_EQUAL(3, changedCount);
+		CHECK_EQUAL(3u, changed[0]);
+		CHECK_EQUAL(40u, changed[1]);
+		CHECK_EQUAL(99u, changed[2]);
+		CHECK_EQUAL((1u << 3), flags.getChanged()[0]);
+
+		//no changes while the inputs stay the same
+		flags.setValues(inputs);
+		CHECK_EQUAL(100u, flags.nextChanged(0));
+		CHECK_EQUAL((1u << 3), flags.getValues()[0]);
+	}
+
+	TEST(TestPaddingIgnored)
+	{
+		BufferedBoolArray<> flags(33, 0.3f, 0.5f, 0.5f);
+		BufferedBoolArray<>::Word inputs[2] = {0, 0xFFFFFFFE};
+
+		flags.setValues(inputs);
+		flags.setValues(inputs);
+
+		CHECK_EQUAL(0u, flags.getValues()[1]);
+		CHECK_EQUAL(33u, flags.nextChanged(0));
+	}
+
+	TEST(TestPerFlagThresholds)
+	{
+		BufferedBoolArray<> flags(64, 0.3f, 0.6f, 0.1f);
+		BufferedBoolArray<>::Word inputs[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+
+		flags.setThresholds(5, 0.1f, 0.25f);
+
+		for(int i = 0; i < 3; i++)
+		{
+			flags.setValues(inputs);
+		}
+
+		CHECK_EQUAL(true, flags.getValue(5));
+		CHECK_EQUAL(false, flags.getValue(4));
+		CHECK_EQUAL(false, flags.getValue(6));
+	}
+
+	TEST(TestForceValue)
+	{
+		BufferedBoolArray<> flags(10, 0.3f, 0.7f, 0.1f);
+		BufferedBool expected(0.3f, 0.7f, 0.1f);
+
+		flags.forceValue(7, true);
+		expected.forceValue(true);
+
+		CHECK_EQUAL(true, flags.getValue(7));
+		CHECK_EQUAL(false, flags.getValue(6));
+		CHECK_CLOSE(expected.getFloatValue(), flags.getLevel(7), FLOAT_THRESHOLD);
+
+		flags.forceValue(7, false);
+		CHECK_EQUAL(false, flags.getValue(7));
+		CHECK_CLOSE(0.0f, flags.getLevel(7), FLOAT_THRESHOLD);
+	}
+}
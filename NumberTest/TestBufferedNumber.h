@@ -117,4 +117,23 @@ SUITE(TestBufferedNumber)
 
 		CHECK_CLOSE(-4.0f, n.getValue(), FLOAT_THRESHOLD);
 	}
+
+	TEST(TestProcess)
+	{
+		BufferedNumber<float> expected(0.0f, -3, 3, 0.1f);
+		BufferedNumber<float> actual(0.0f, -3, 3, 0.1f);
+		float values[] = {1.0f, 1.0f, -2.0f, 0.05f, 0.0f, 2.5f};
+		float elapsedTimes[] = {1.0f, 2.0f, 0.5f, 3.0f, 1.0f, 10.0f};
+		float outputs[6];
+
+		actual.process(values, elapsedTimes, outputs, 6);
+
+		for(int i = 0; i < 6; i++)
+		{
+			expected.setValue(values[i], elapsedTimes[i]);
+			CHECK_EQUAL(expected.getValue(), outputs[i]);
+		}
+
+		CHECK_EQUAL(expected.getValue(), actual.getValue());
+	}
 }
\ No newline at end of file
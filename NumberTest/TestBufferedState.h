@@ -128,5 +128,20 @@ SUITE(TestBufferedState)
 		CHECK_EQUAL(2u, b.getValue());
 	}
 
+	TEST(TestUpdateReportsChange)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
 
+		BufferedState<3> b(0, stateValues, thresholds, 0.1f);
+
+		for(int i = 0; i < 6; i++)
+		{
+			CHECK_EQUAL(false, b.update(2));
+		}
+
+		CHECK_EQUAL(true, b.update(2));
+		CHECK_EQUAL(2u, b.getValue());
+		CHECK_EQUAL(false, b.update(2));
+	}
 }
\ No newline at end of file
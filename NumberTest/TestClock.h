@@ -0,0 +1,137 @@
+#include "UnitTest++.h"
+#include "Clock.h"
+#include "ClampedNumber.h"
+#include "BasicRangedNumber.h"
+#include "BufferedNumber.h"
+#include "DifferentiableNumber.h"
+#include "PIDBufferedNumber.h"
+#include "PIDControllerBank.h"
+
+using namespace luma::numbers;
+
+struct PhysicsTime {};
+struct InputTime {};
+
+SUITE(TestClock)
+{
+	TEST(TestTimeScales)
+	{
+		CHECK_CLOSE(frameRate, DefaultClock::timeScale(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(30.0f, (ConstantClock<30>::timeScale()), FLOAT_THRESHOLD);
+		CHECK_CLOSE(0.25f, (ConstantClock<1, 4>::timeScale()), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestRuntimeClockGroups)
+	{
+		CHECK_CLOSE(frameRate, RuntimeClock<InputTime>::timeScale(), FLOAT_THRESHOLD);
+
+		RuntimeClock<PhysicsTime>::setTimeScale(30.0f);
+		RuntimeClock<InputTime>::setTimeScale(120.0f);
+
+		CHECK_CLOSE(30.0f, RuntimeClock<PhysicsTime>::timeScale(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(120.0f, RuntimeClock<InputTime>::timeScale(), FLOAT_THRESHOLD);
+
+		RuntimeClock<PhysicsTime>::setTimeScale(frameRate);
+		RuntimeClock<InputTime>::setTimeScale(frameRate);
+	}
+
+	TEST(TestClampedNumber)
+	{
+		ClampedNumber<float, ConstantClock<4> > n(0.0f, -10.0f, 10.0f, 0.5f);
+
+		n.inc(0.5f);
+		CHECK_CLOSE(1.0f, (float) n, FLOAT_THRESHOLD);
+
+		n.dec(0.25f);
+		CHECK_CLOSE(0.5f, (float) n, FLOAT_THRESHOLD);
+
+		CHECK_CLOSE(4.0f, (ClampedNumber<float, ConstantClock<4> >::timeScale()), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestDifferentRatesInOneBuild)
+	{
+		RuntimeClock<PhysicsTime>::setTimeScale(30.0f);
+		RuntimeClock<InputTime>::setTimeScale(120.0f);
+
+		ClampedNumber<float, RuntimeClock<PhysicsTime> > physics(0.0f, -100.0f, 100.0f, 0.1f);
+		ClampedNumber<float, RuntimeClock<InputTime> > input(0.0f, -100.0f, 100.0f, 0.1f);
+
+		//one second at each rate
+		for(int i = 0; i < 30; i++)
+		{
+			physics.inc(1.0f / 30);
+		}
+
+		for(int i = 0; i < 120; i++)
+		{
+			input.inc(1.0f / 120);
+		}
+
+		CHECK_CLOSE(3.0f, (float) physics, 0.001f);
+		CHECK_CLOSE(12.0f, (float) input, 0.001f);
+
+		RuntimeClock<PhysicsTime>::setTimeScale(frameRate);
+		RuntimeClock<InputTime>::setTimeScale(frameRate);
+	}
+
+	TEST(TestBasicRangedNumber)
+	{
+		ClampedNumber<float, ConstantClock<3> > expected(0.0f, -1.0f, 1.0f, 0.125f);
+		BasicRangedNumber<float, ClockedClampPolicy<ConstantClock<3> > > n(0.0f, -1.0f, 1.0f, 0.125f);
+
+		for(int i = 0; i < 10; i++)
+		{
+			i % 3 ? n.inc(0.5f) : n.dec(0.25f);
+			i % 3 ? expected.inc(0.5f) : expected.dec(0.25f);
+
+			CHECK_EQUAL((float) expected, (float) n);
+		}
+	}
+
+	TEST(TestBufferedNumber)
+	{
+		BufferedNumber<float, ClampedNumber<float, ConstantClock<4> > > n(0.0f, -10.0f, 10.0f, 0.5f);
+
+		//moves 0.5 per quarter unit of time
+		n.setValue(2.0f, 0.25f);
+		CHECK_CLOSE(0.5f, n.getValue(), FLOAT_THRESHOLD);
+
+		n.setValue(2.0f, 0.5f);
+		CHECK_CLOSE(1.5f, n.getValue(), FLOAT_THRESHOLD);
+
+		//within one step of the ideal value
+		n.setValue(2.0f, 0.5f);
+		CHECK_CLOSE(2.0f, n.getValue(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestDifferentiableNumber)
+	{
+		DifferentiableNumber<float, 2, ConstantClock<10> > n(0.0f);
+
+		n.setValue(1.0f, 0.1f);
+		CHECK_CLOSE(1.0f, n.getValue(1), FLOAT_THRESHOLD);
+		CHECK_CLOSE(0.1f, n.getValue(2), FLOAT_THRESHOLD);
+
+		n.setValue(3.0f, 0.2f);
+		CHECK_CLOSE(1.0f, n.getValue(1), FLOAT_THRESHOLD);
+		CHECK_CLOSE(0.0f, n.getValue(2), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestPIDControllerBank)
+	{
+		float dFactors[] = {0.1f, 0.2f};
+		float iFactors[] = {0.3f};
+		float values[3] = {0.5f, -0.25f, 1.0f};
+
+		PIDControllerBank<float, 2, 1, 4, ConstantClock<8> > bank(3, 0.0f, 0.7f, dFactors, iFactors);
+		PIDBufferedNumber<float, 2, 1, 4, ConstantClock<8> > number(0.0f, 0.7f, dFactors, iFactors);
+
+		for(int step = 0; step < 10; step++)
+		{
+			bank.setValue(values, 0.125f);
+			number.setValue(values[0], 0.125f);
+
+			CHECK_CLOSE(number.getValue(), bank.getValue(0), FLOAT_THRESHOLD);
+		}
+	}
+}
@@ -156,4 +156,49 @@ SUITE(TestDifferentiableNumber)
 
 		CHECK_CLOSE(10.0f, n.getValue(0), FLOAT_THRESHOLD);
 	}
+
+	TEST(TestProcess)
+	{
+		DifferentiableNumber<float, 2> expected(0.0f);
+		DifferentiableNumber<float, 2> actual(0.0f);
+		float values[] = {1.0f, 3.0f, -2.0f, 0.5f};
+		float elapsedTimes[] = {1.0f, 2.0f, 0.5f, 4.0f};
+		float outputs[4];
+
+		actual.process(values, elapsedTimes, outputs, 4);
+
+		for(int i = 0; i < 4; i++)
+		{
+			expected.setValue(values[i], elapsedTimes[i]);
+			CHECK_EQUAL(expected.getValue(1), outputs[i]);
+		}
+
+		CHECK_EQUAL(expected.getValue(2), actual.getValue(2));
+	}
+
+	TEST(TestHigherOrdersAreDifferencesOfLowerOrders)
+	{
+		DifferentiableNumber<float, 3> n(0.0f);
+		DifferentiableNumber<float, 1> first(0.0f);
+		DifferentiableNumber<float, 1> second(0.0f);
+		DifferentiableNumber<float, 1> third(0.0f);
+
+		for(int i = 0; i < 20; i++)
+		{
+			float value = (float) ((i * 7) % 5);
+			float elapsedTime = 0.5f + (i % 3) * 0.5f;
+
+			n.setValue(value, elapsedTime);
+			first.setValue(value, elapsedTime);
+			second.setValue(first.getValue(1));
+			third.setValue(second.getValue(1));
+
+			CHECK_EQUAL(value, n.getValue(0));
+			CHECK_EQUAL(first.getValue(1), n.getValue(1));
+			CHECK_EQUAL(second.getValue(1), n.getValue(2));
+			CHECK_EQUAL(third.getValue(1), n.getValue(3));
+		}
+
+		CHECK_EQUAL(0.0f, n.getValue(4));
+	}
 }
\ No newline at end of file
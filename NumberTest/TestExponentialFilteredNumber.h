@@ -0,0 +1,202 @@
+#include <vector>
+
+#include "UnitTest++.h"
+#include "ExponentialFilteredNumber.h"
+
+using namespace luma::numbers;
+
+SUITE(TestExponentialFilteredNumber)
+{
+	TEST(TestConstructor)
+	{
+		ExponentialFilteredNumber<float, 2> n(3.0f, 4.0f);
+
+		CHECK_EQUAL(3.0f, n.getValue(0));
+		CHECK_EQUAL(3.0f, n.getValue(1));
+		CHECK_EQUAL(3.0f, n.getValue(2));
+		CHECK_EQUAL(4.0f, n.getTimeConstant());
+	}
+
+	TEST(TestStepResponse)
+	{
+		float timeConstant = 2.0f;
+		float alpha = 1.0f - expf(-1.0f / timeConstant);
+
+		ExponentialFilteredNumber<float, 2> n(0.0f, timeConstant);
+
+		n.setValue(1.0f);
+
+		CHECK_EQUAL(1.0f, n.getValue(0));
+		CHECK_CLOSE(alpha, n.getValue(1), FLOAT_THRESHOLD);
+		CHECK_CLOSE(alpha * alpha, n.getValue(2), FLOAT_THRESHOLD);
+
+		n.setValue(1.0f);
+
+		CHECK_CLOSE(1.0f - (1.0f - alpha) * (1.0f - alpha), n.getValue(1), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestTimeConstant)
+	{
+		ExponentialFilteredNumber<double, 1> n(0.0, 5.0f);
+
+		//after one time constant, 1 - 1/e of the way
+		n.setValue(1.0, 5.0f);
+		CHECK_CLOSE(1.0 - exp(-1.0), n.getValue(1), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestElapsedTime)
+	{
+		ExponentialFilteredNumber<double, 1> halves(0.0, 3.0f);
+		ExponentialFilteredNumber<double, 1> whole(0.0, 3.0f);
+		ExponentialFilteredNumber<double, 1> mixed(0.0, 3.0f);
+
+		for(int i = 0; i < 10; i++)
+		{
+			halves.setValue(2.0, 0.5f);
+			halves.setValue(2.0, 0.5f);
+			whole.setValue(2.0, 1.0f);
+			mixed.setValue(2.0, 0.25f);
+			mixed.setValue(2.0, 0.75f);
+
+			CHECK_CLOSE(whole.getValue(1), halves.getValue(1), 1e-6);
+			CHECK_CLOSE(whole.getValue(1), mixed.getValue(1), 1e-6);
+		}
+
+		//no time, no change
+		double value = whole.getValue(1);
+
+		whole.setValue(100.0, 0.0f);
+		CHECK_EQUAL(value, whole.getValue(1));
+		CHECK_EQUAL(100.0, whole.getValue(0));
+	}
+
+	TEST(TestZeroTimeConstant)
+	{
+		ExponentialFilteredNumber<float, 2> n(0.0f, 0.0f);
+
+		n.setValue(5.0f);
+		CHECK_EQUAL(5.0f, n.getValue(1));
+		CHECK_EQUAL(5.0f, n.getValue(2));
+	}
+
+	TEST(TestHigherOrders)
+	{
+		ExponentialFilteredNumber<float, 3> n(0.0f, 2.5f);
+		ExponentialFilteredNumber<float, 1> first(0.0f, 2.5f);
+		ExponentialFilteredNumber<float, 1> second(0.0f, 2.5f);
+
+		for(int i = 0; i < 20; i++)
+		{
+			float value = (float) ((i * 7) % 5);
+			float elapsedTime = 0.5f + (i % 3) * 0.5f;
+
+			n.setValue(value, elapsedTime);
+			first.setValue(value, elapsedTime);
+			second.setValue(first.getValue(1), elapsedTime);
+
+			CHECK_CLOSE(first.getValue(1), n.getValue(1), FLOAT_THRESHOLD);
+			CHECK_CLOSE(second.getValue(1), n.getValue(2), FLOAT_THRESHOLD);
+		}
+
+		CHECK_EQUAL(0.0f, n.getValue(4));
+	}
+
+	TEST(TestForceValue)
+	{
+		ExponentialFilteredNumber<float, 2> n(0.0f, 10.0f);
+
+		n.setValue(3.0f);
+		n.forceValue(7.0f);
+
+		for(unsigned int order = 0; order <= 2; order++)
+		{
+			CHECK_EQUAL(7.0f, n.getValue(order));
+		}
+
+		n.setValue(7.0f);
+		CHECK_CLOSE(7.0f, n.getValue(2), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestSetTimeConstant)
+	{
+		ExponentialFilteredNumber<float, 1> n(0.0f, 1.0f);
+		ExponentialFilteredNumber<float, 1> expected(0.0f, 4.0f);
+
+		n.setValue(1.0f);
+		n.setTimeConstant(4.0f);
+		n.forceValue(0.0f);
+		n.setValue(1.0f);
+		expected.setValue(1.0f);
+
+		CHECK_EQUAL(expected.getValue(1), n.getValue(1));
+	}
+
+	TEST(TestTimeConstantFromSampleCount)
+	{
+		typedef ExponentialFilteredNumber<float, 1> Filter;
+
+		Filter n(0.0f, Filter::timeConstantFromSampleCount(9));
+
+		n.setValue(1.0f);
+		CHECK_CLOSE(0.2f, n.getValue(1), FLOAT_THRESHOLD);
+
+		CHECK_EQUAL(0.0f, Filter::timeConstantFromSampleCount(1));
+	}
+
+	TEST(TestProcess)
+	{
+		ExponentialFilteredNumber<float, 2> expected(0.0f, 3.0f);
+		ExponentialFilteredNumber<float, 2> actual(0.0f, 3.0f);
+		float values[] = {1, 4, 2, 8, 5, 7};
+		float elapsedTimes[] = {1, 0.5f, 0.5f, 2, 1, 1};
+		float outputs[6];
+
+		actual.process(values, elapsedTimes, outputs, 6, 2);
+
+		for(int i = 0; i < 6; i++)
+		{
+			expected.setValue(values[i], elapsedTimes[i]);
+			CHECK_EQUAL(expected.getValue(2), outputs[i]);
+		}
+	}
+
+	TEST(TestThroughBaseClass)
+	{
+		ExponentialFilteredNumber<float, 1> n(0.0f, 1.0f);
+		AbstractFilteredNumber<float, 1, 1>& base = n;
+
+		base.setValue(2.0f);
+
+		CHECK_EQUAL(2.0f, base.getValue(0));
+		CHECK_EQUAL(n.getValue(1), base.getValue(1));
+	}
+
+	TEST(TestSnapshot)
+	{
+		ExponentialFilteredNumber<float, 2> n(0.0f, 3.0f);
+		ExponentialFilteredNumber<float, 2> restored(1.0f, 1.0f);
+		ExponentialFilteredNumber<float, 1> otherOrder(1.0f, 1.0f);
+		std::vector<unsigned char> snapshot;
+
+		n.setValue(4.0f, 0.5f);
+		n.setValue(2.0f, 1.5f);
+
+		SnapshotWriter writer(snapshot);
+		n.serialize(writer);
+
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+		CHECK(restored.deserialize(reader));
+		CHECK_EQUAL(3.0f, restored.getTimeConstant());
+
+		SnapshotReader otherReader(&snapshot[0], snapshot.size());
+		CHECK(!otherOrder.deserialize(otherReader));
+
+		n.setValue(5.0f, 0.75f);
+		restored.setValue(5.0f, 0.75f);
+
+		for(unsigned int order = 0; order <= 2; order++)
+		{
+			CHECK_EQUAL(n.getValue(order), restored.getValue(order));
+		}
+	}
+}
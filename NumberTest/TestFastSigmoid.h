@@ -0,0 +1,108 @@
+#include <stdio.h>
+
+#include "UnitTest++.h"
+#include "utils.h"
+#include "FastSigmoid.h"
+
+using namespace luma::numbers;
+
+/**
+	Returns the largest difference between a FastSigmoid and the exact
+	sigmoid (calculated with doubles), over inputs well beyond the
+	input range.
+*/
+template <class T>
+double maxSigmoidError(const FastSigmoid<T>& f, T inputMin, T inputMax, T outputMin, T outputMax)
+{
+	const int inputCount = 100000;
+	double maxError = 0;
+	T width = inputMax - inputMin;
+
+	for(int i = 0; i <= inputCount; i++)
+	{
+		T input = inputMin - 10 * width + (21 * width * i) / inputCount;
+		double exact = sigmoid((double) input, (double) inputMin, (double) inputMax, (double) outputMin, (double) outputMax);
+		double error = fabs(f(input) - exact);
+
+		maxError = error > maxError ? error : maxError;
+	}
+
+	return maxError;
+}
+
+SUITE(TestFastSigmoid)
+{
+	TEST(TestSameAsSigmoid)
+	{
+		FastSigmoid<float> f(-5.0f, 5.0f, -4.0f, 4.0f);
+
+		CHECK_CLOSE(sigmoid(0.0f, -5.0f, 5.0f, -4.0f, 4.0f), f(0.0f), 0.001f);
+		CHECK_CLOSE(sigmoid(2.0f, -5.0f, 5.0f, -4.0f, 4.0f), f(2.0f), 0.001f);
+		CHECK_CLOSE(4.0f, f(100.0f), 0.001f);
+		CHECK_CLOSE(-4.0f, f(-100.0f), 0.001f);
+	}
+
+	TEST(TestMaxError)
+	{
+		double bounds[] = {0.01, 0.0001, 0.000001};
+
+		for(int i = 0; i < 3; i++)
+		{
+			FastSigmoid<double> f(-0.5, 0.5, 0.0, 10.0, bounds[i]);
+			double error = maxSigmoidError(f, -0.5, 0.5, 0.0, 10.0);
+
+			printf("FastSigmoid<double>: max error %g (bound %g, %u samples)\n", error, bounds[i], f.getSampleCount());
+			CHECK(error <= bounds[i]);
+		}
+
+		FastSigmoid<float> g(-5.0f, 5.0f, -4.0f, 4.0f, 0.0001f);
+		double error = maxSigmoidError(g, -5.0f, 5.0f, -4.0f, 4.0f);
+
+		//float rounding comes on top of the bound
+		printf("FastSigmoid<float>: max error %g (bound %g, %u samples)\n", error, 0.0001, g.getSampleCount());
+		CHECK(error <= 0.0001 + 1e-5);
+	}
+
+	TEST(TestDecreasing)
+	{
+		FastSigmoid<float> f(0.0f, 1.0f, 1.0f, 0.0f, 0.001f);
+
+		CHECK_CLOSE(sigmoid(0.3f, 0.0f, 1.0f, 1.0f, 0.0f), f(0.3f), 0.001f);
+		CHECK_CLOSE(0.0f, f(20.0f), 0.001f);
+	}
+
+	TEST(TestEvaluateSameAsOperator)
+	{
+		FastSigmoid<float> f(-1.0f, 2.0f, 0.0f, 3.0f);
+		FastSigmoid<double> g(-1.0, 2.0, 0.0, 3.0);
+
+		//not a multiple of the SIMD width, to test the remainder
+		float inputs[101];
+		float outputs[101];
+		double doubleInputs[101];
+		double doubleOutputs[101];
+
+		for(int i = 0; i < 101; i++)
+		{
+			inputs[i] = -20.0f + i * 0.4f;
+			doubleInputs[i] = inputs[i];
+		}
+
+		f.evaluate(inputs, outputs, 101);
+		g.evaluate(doubleInputs, doubleOutputs, 101);
+
+		for(int i = 0; i < 101; i++)
+		{
+			CHECK_CLOSE(f(inputs[i]), outputs[i], FLOAT_THRESHOLD);
+			CHECK_CLOSE(g(doubleInputs[i]), doubleOutputs[i], FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestThroughInterface)
+	{
+		FastSigmoid<float> f(-5.0f, 5.0f, 0.0f, 1.0f);
+		const AbstractFunction<float>& function = f;
+
+		CHECK_CLOSE(f(1.5f), function(1.5f), FLOAT_THRESHOLD);
+	}
+}
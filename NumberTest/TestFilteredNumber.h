@@ -85,4 +85,88 @@ SUITE(TestFilteredNumber)
 		CHECK_CLOSE(15.0f / 15.0f, n.getValue(), FLOAT_THRESHOLD);
 	}
 
+	TEST(TestDetectWeightShape)
+	{
+		float general[] = {1, 2, 4, 8};
+		float uniform[] = {2, 2, 2, 2};
+		float exponential[] = {8, 4, 2, 1};
+		float linear[] = {4, 3, 2, 1};
+
+		CHECK_EQUAL(WEIGHTS_GENERAL, (detectWeightShape<float, 4>(general)));
+		CHECK_EQUAL(WEIGHTS_UNIFORM, (detectWeightShape<float, 4>(uniform)));
+		CHECK_EQUAL(WEIGHTS_EXPONENTIAL, (detectWeightShape<float, 4>(exponential)));
+		CHECK_EQUAL(WEIGHTS_LINEAR, (detectWeightShape<float, 4>(linear)));
+
+		FilteredNumber<float, 4, 2> n(0.0f, exponential);
+		CHECK_EQUAL(WEIGHTS_EXPONENTIAL, n.getWeightShape());
+
+		FilteredNumber<float, 4, 2> m(0.0f, exponential, WEIGHTS_GENERAL);
+		CHECK_EQUAL(WEIGHTS_GENERAL, m.getWeightShape());
+	}
+
+	TEST(TestIncrementalSameAsGeneral)
+	{
+		const int sampleCount = 256;
+		float uniform[sampleCount];
+		float exponential[sampleCount];
+		float linear[sampleCount];
+
+		for(int i = 0; i < sampleCount; i++)
+		{
+			uniform[i] = 1.0f;
+			exponential[i] = i == 0 ? 1.0f : exponential[i - 1] * 0.9f;
+			linear[i] = (float) (sampleCount - i);
+		}
+
+		FilteredNumber<float, sampleCount, 2> uniformFast(0.0f, uniform);
+		FilteredNumber<float, sampleCount, 2> uniformSlow(0.0f, uniform, WEIGHTS_GENERAL);
+		FilteredNumber<float, sampleCount, 2> exponentialFast(0.0f, exponential);
+		FilteredNumber<float, sampleCount, 2> exponentialSlow(0.0f, exponential, WEIGHTS_GENERAL);
+		FilteredNumber<float, sampleCount, 2> linearFast(0.0f, linear);
+		FilteredNumber<float, sampleCount, 2> linearSlow(0.0f, linear, WEIGHTS_GENERAL);
+
+		CHECK_EQUAL(WEIGHTS_UNIFORM, uniformFast.getWeightShape());
+		CHECK_EQUAL(WEIGHTS_EXPONENTIAL, exponentialFast.getWeightShape());
+		CHECK_EQUAL(WEIGHTS_LINEAR, linearFast.getWeightShape());
+
+		for(int i = 0; i < 3 * sampleCount; i++)
+		{
+			float value = (rand() % 100) / 50.0f - 1.0f;
+			float elapsedTime = 0.5f + (rand() % 100) / 100.0f;
+
+			uniformFast.setValue(value, elapsedTime);
+			uniformSlow.setValue(value, elapsedTime);
+			exponentialFast.setValue(value, elapsedTime);
+			exponentialSlow.setValue(value, elapsedTime);
+			linearFast.setValue(value, elapsedTime);
+			linearSlow.setValue(value, elapsedTime);
+
+			for(unsigned int order = 1; order <= 2; order++)
+			{
+				CHECK_CLOSE(uniformSlow.getValue(order), uniformFast.getValue(order), FLOAT_THRESHOLD);
+				CHECK_CLOSE(exponentialSlow.getValue(order), exponentialFast.getValue(order), FLOAT_THRESHOLD);
+				CHECK_CLOSE(linearSlow.getValue(order), linearFast.getValue(order), FLOAT_THRESHOLD);
+			}
+		}
+	}
+
+	TEST(TestProcess)
+	{
+		float weights[] = {1, 2, 4, 8};
+		FilteredNumber<float, 4, 2> expected(0.0f, weights);
+		FilteredNumber<float, 4, 2> actual(0.0f, weights);
+		float values[] = {1.0f, 3.0f, -2.0f, 0.5f, 0.0f, 2.5f, 1.0f};
+		float outputs[7];
+
+		//no elapsed times: TIME_UNIT for every value
+		actual.process(values, 0, outputs, 7, 2);
+
+		for(int i = 0; i < 7; i++)
+		{
+			expected.setValue(values[i]);
+			CHECK_EQUAL(expected.getValue(2), outputs[i]);
+		}
+
+		CHECK_EQUAL(expected.getValue(1), actual.getValue(1));
+	}
 }
\ No newline at end of file
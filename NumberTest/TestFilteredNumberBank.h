@@ -0,0 +1,86 @@
+#include "UnitTest++.h"
+#include "FilteredNumber.h"
+#include "FilteredNumberBank.h"
+
+using namespace luma::numbers;
+
+SUITE(TestFilteredNumberBank)
+{
+	TEST(TestConstructor)
+	{
+		float weights[] = {1, 2, 4, 8};
+		FilteredNumberBank<float, 4, 2> bank(5, 0.0f, weights);
+
+		CHECK_EQUAL(5u, bank.getFilterCount());
+
+		for(int i = 0; i < 5; i++)
+		{
+			CHECK_CLOSE(0.0f, bank.getValue(i, 0), FLOAT_THRESHOLD);
+			CHECK_CLOSE(0.0f, bank.getValue(i, 1), FLOAT_THRESHOLD);
+			CHECK_CLOSE(0.0f, bank.getValue(i, 2), FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestGetValueOutOfBounds)
+	{
+		float weights[] = {1, 2, 4, 8};
+		FilteredNumberBank<float, 4, 1> bank(3, 0.0f, weights);
+		float values[] = {1.0f, 2.0f, 3.0f};
+
+		bank.setValue(values);
+
+		CHECK_CLOSE(0.0f, bank.getValue(0, 2), FLOAT_THRESHOLD);
+		CHECK(bank.getValues(2) == 0);
+	}
+
+	TEST(TestSetValue)
+	{
+		float weights[] = {1, 2, 4, 8};
+		FilteredNumberBank<float, 4, 1> bank(2, 0.0f, weights);
+		float values[] = {1.0f, 2.0f};
+
+		bank.setValue(values);
+		CHECK_CLOSE(1.0f / 15.0f, bank.getValue(0), FLOAT_THRESHOLD);
+		CHECK_CLOSE(2.0f / 15.0f, bank.getValue(1), FLOAT_THRESHOLD);
+
+		bank.setValue(values);
+		CHECK_CLOSE(3.0f / 15.0f, bank.getValue(0), FLOAT_THRESHOLD);
+		CHECK_CLOSE(6.0f / 15.0f, bank.getValue(1), FLOAT_THRESHOLD);
+
+		bank.setValue(values);
+		bank.setValue(values);
+		CHECK_CLOSE(15.0f / 15.0f, bank.getValues(1)[0], FLOAT_THRESHOLD);
+		CHECK_CLOSE(30.0f / 15.0f, bank.getValues(1)[1], FLOAT_THRESHOLD);
+	}
+
+	TEST(TestSameAsFilteredNumber)
+	{
+		const int filterCount = 300; //more than one block
+		float weights[] = {1, 3, 2, 5, 4};
+		float values[filterCount];
+
+		FilteredNumberBank<float, 5, 3> bank(filterCount, 0.0f, weights);
+		FilteredNumber<float, 5, 3> first(0.0f, weights);
+		FilteredNumber<float, 5, 3> last(0.0f, weights);
+
+		for(int k = 0; k < 50; k++)
+		{
+			float elapsedTime = 0.5f + (rand() % 100) / 100.0f;
+
+			for(int i = 0; i < filterCount; i++)
+			{
+				values[i] = (rand() % 100) / 50.0f - 1.0f;
+			}
+
+			bank.setValue(values, elapsedTime);
+			first.setValue(values[0], elapsedTime);
+			last.setValue(values[filterCount - 1], elapsedTime);
+
+			for(unsigned int order = 0; order <= 4; order++)
+			{
+				CHECK_CLOSE(first.getValue(order), bank.getValue(0, order), FLOAT_THRESHOLD);
+				CHECK_CLOSE(last.getValue(order), bank.getValue(filterCount - 1, order), FLOAT_THRESHOLD);
+			}
+		}
+	}
+}
@@ -0,0 +1,144 @@
+#include "UnitTest++.h"
+#include "Fixed.h"
+#include "ClampedNumber.h"
+#include "CyclicNumber.h"
+#include "PingPongNumber.h"
+#include "BufferedNumber.h"
+
+using namespace luma::numbers;
+
+SUITE(TestFixed)
+{
+	TEST(TestConversions)
+	{
+		CHECK_EQUAL(3 << 16, Fixed16(3).getRaw());
+		CHECK_EQUAL(-(3 << 16), Fixed16(-3).getRaw());
+		CHECK_EQUAL(1 << 15, Fixed16(0.5f).getRaw());
+		CHECK_EQUAL(-(1 << 14), Fixed16(-0.25).getRaw());
+		CHECK_EQUAL(1, Fixed16(1.0f / 65536).getRaw());
+		CHECK_EQUAL(1, Fixed16(0.6f / 65536).getRaw());
+		CHECK_EQUAL(-1, Fixed16(-0.6f / 65536).getRaw());
+
+		CHECK_CLOSE(2.75f, Fixed16(2.75f).toFloat(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(-2.75, Fixed16(-2.75f).toDouble(), FLOAT_THRESHOLD);
+		CHECK_EQUAL(2, Fixed16(2.75f).toInt());
+		CHECK_EQUAL(-3, Fixed16(-2.75f).toInt());
+		CHECK_EQUAL(7, Fixed16::fromRaw(7).getRaw());
+	}
+
+	TEST(TestArithmetic)
+	{
+		Fixed16 a(2.5f);
+		Fixed16 b(-0.75f);
+
+		CHECK_CLOSE(1.75f, (a + b).toFloat(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(3.25f, (a - b).toFloat(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(-1.875f, (a * b).toFloat(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(-10.0f / 3, (a / b).toFloat(), 1.0f / 65536);
+		CHECK_CLOSE(0.75f, (-b).toFloat(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(5.0f, (2 * a).toFloat(), FLOAT_THRESHOLD);
+
+		//products round down, quotients round towards 0
+		CHECK_EQUAL(0, (Fixed16::fromRaw(1) * Fixed16(0.5f)).getRaw());
+		CHECK_EQUAL(-1, (Fixed16::fromRaw(-1) * Fixed16(0.5f)).getRaw());
+		CHECK_EQUAL(0, (Fixed16::fromRaw(-1) / Fixed16(2)).getRaw());
+	}
+
+	TEST(TestComparisons)
+	{
+		Fixed16 a(1.5f);
+		Fixed16 b(2);
+
+		CHECK(a < b);
+		CHECK(a <= b);
+		CHECK(b > a);
+		CHECK(b >= a);
+		CHECK(a != b);
+		CHECK(a == Fixed16(3) / Fixed16(2));
+	}
+
+	TEST(TestTruncatedQuotient)
+	{
+		CHECK_EQUAL(Fixed16(3).getRaw(), truncatedQuotient(Fixed16(7.5f), Fixed16(2)).getRaw());
+		CHECK_EQUAL(Fixed16(-3).getRaw(), truncatedQuotient(Fixed16(-7.5f), Fixed16(2)).getRaw());
+	}
+
+	TEST(TestScaleByTime)
+	{
+		CHECK_EQUAL(Fixed16(0.375f).getRaw(), scaleByTime(Fixed16(0.75f), 0.5f, 1.0f).getRaw());
+		CHECK_EQUAL(Fixed16(1.5f).getRaw(), scaleByTime(Fixed16(0.75f), 0.5f, 4.0f).getRaw());
+	}
+
+	TEST(TestClampedNumber)
+	{
+		ClampedNumber<Fixed16> c(Fixed16(0), Fixed16(-1), Fixed16(1), Fixed16(0.25f));
+
+		c.inc(2.0f);
+		CHECK_CLOSE(0.5f, c.getValue().toFloat(), FLOAT_THRESHOLD);
+
+		c.inc(4.0f);
+		CHECK_CLOSE(0.75f, c.getValue().toFloat(), FLOAT_THRESHOLD);
+
+		c.dec(20.0f);
+		CHECK_CLOSE(-1.0f, c.getValue().toFloat(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestCyclicNumber)
+	{
+		CyclicNumber<Fixed16> c(Fixed16(0), Fixed16(0), Fixed16(5), Fixed16(1));
+
+		c.inc(4.5f);
+		CHECK_CLOSE(4.5f, ((Fixed16) c).toFloat(), FLOAT_THRESHOLD);
+
+		c.inc(1.0f);
+		CHECK_CLOSE(0.5f, ((Fixed16) c).toFloat(), FLOAT_THRESHOLD);
+
+		c.dec(1.0f);
+		CHECK_CLOSE(4.5f, ((Fixed16) c).toFloat(), FLOAT_THRESHOLD);
+
+		c = Fixed16(-12);
+		CHECK_CLOSE(3.0f, ((Fixed16) c).toFloat(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestPingPongNumber)
+	{
+		PingPongNumber<Fixed16> p(Fixed16(0), Fixed16(0), Fixed16(4), Fixed16(1));
+		PingPongNumber<int> expected(0, 0, 4, 1);
+
+		for(int i = 0; i < 12; i++)
+		{
+			++p;
+			++expected;
+
+			CHECK_EQUAL((int) expected, ((Fixed16) p).toInt());
+		}
+	}
+
+	TEST(TestBufferedNumber)
+	{
+		BufferedNumber<Fixed16> fixed(Fixed16(0), Fixed16(-2), Fixed16(2), Fixed16(0.125f));
+		BufferedNumber<float> expected(0.0f, -2.0f, 2.0f, 0.125f);
+		float inputs[] = {1.0f, 1.0f, 1.0f, -1.5f, -1.5f, 0.5f, 0.5f, 0.5f};
+
+		for(int i = 0; i < 8; i++)
+		{
+			fixed.setValue(Fixed16(inputs[i]), 0.5f);
+			expected.setValue(inputs[i], 0.5f);
+
+			CHECK_CLOSE(expected.getValue(), fixed.getValue().toFloat(), FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestDeterministic)
+	{
+		//the raw values only depend on integer arithmetic
+		BufferedNumber<Fixed16> n(Fixed16(0), Fixed16(-100), Fixed16(100), Fixed16(0.1f));
+
+		for(int i = 0; i < 100; i++)
+		{
+			n.setValue(Fixed16(50), 1.0f / 60);
+		}
+
+		CHECK_EQUAL(100 * (6554 * 1092 >> 16), n.getValue().getRaw());
+	}
+}
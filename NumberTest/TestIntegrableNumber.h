@@ -301,5 +301,44 @@ SUITE(TestIntegrableNumber)
 		CHECK_CLOSE(10.0f, iNumber.getValue(0), FLOAT_THRESHOLD);
 		CHECK_CLOSE(10.0f, iNumber.getValue(1), FLOAT_THRESHOLD);
 		CHECK_CLOSE(10.0f, iNumber.getValue(2), FLOAT_THRESHOLD);
-	}	
+	}
+
+	TEST(TestOrdersAreMovingAverages)
+	{
+		const int sampleCount = 4;
+		const int maxOrder = 4;
+		IntegrableNumber<float, sampleCount, maxOrder> iNumber(0.0f);
+
+		//history[k][i] is the value of order k, i updates ago
+		float history[maxOrder + 1][sampleCount] = {{0}};
+
+		for(int step = 0; step < 20; step++)
+		{
+			float value = (float) ((step * 7) % 5) - 2.0f;
+
+			for(int order = 0; order <= maxOrder; order++)
+			{
+				for(int i = sampleCount - 1; i > 0; i--)
+				{
+					history[order][i] = history[order][i - 1];
+				}
+
+				float sum = 0.0f;
+
+				for(int i = 1; order > 0 && i < sampleCount; i++)
+				{
+					sum += history[order - 1][i];
+				}
+
+				history[order][0] = order == 0 ? value : (sum + history[order - 1][0]) / sampleCount;
+			}
+
+			iNumber.setValue(value);
+
+			for(int order = 0; order <= maxOrder; order++)
+			{
+				CHECK_CLOSE(history[order][0], iNumber.getValue(order), FLOAT_THRESHOLD);
+			}
+		}
+	}
 }
\ No newline at end of file
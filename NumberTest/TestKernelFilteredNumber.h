@@ -0,0 +1,122 @@
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "FilteredNumber.h"
+#include "KernelFilteredNumber.h"
+
+using namespace luma::numbers;
+
+/**
+	Checks that a KernelFilteredNumber gives the same values as a
+	FilteredNumber constructed with the weights of the kernel.
+*/
+template <class Kernel>
+void checkKernelSameAsFilteredNumber(TEST_HELPER_PARAMETERS)
+{
+	const unsigned int sampleCount = 16;
+	float weights[sampleCount];
+
+	for(unsigned int i = 0; i < sampleCount; i++)
+	{
+		weights[i] = Kernel::template weight<float, sampleCount>(i);
+	}
+
+	FilteredNumber<float, sampleCount, 2> expected(0.0f, weights);
+	KernelFilteredNumber<float, sampleCount, 2, Kernel> actual(0.0f);
+
+	CHECK_EQUAL(expected.getWeightShape(), actual.getWeightShape());
+
+	for(unsigned int i = 0; i < 3 * sampleCount; i++)
+	{
+		float value = (rand() % 100) / 50.0f - 1.0f;
+		float elapsedTime = 0.5f + (rand() % 100) / 100.0f;
+
+		expected.setValue(value, elapsedTime);
+		actual.setValue(value, elapsedTime);
+
+		for(unsigned int order = 0; order <= 3; order++)
+		{
+			CHECK_CLOSE(expected.getValue(order), actual.getValue(order), FLOAT_THRESHOLD);
+		}
+	}
+}
+
+SUITE(TestKernelFilteredNumber)
+{
+	TEST(TestWeights)
+	{
+		KernelFilteredNumber<float, 4, 1, BoxKernel> box(0.0f);
+		KernelFilteredNumber<float, 4, 1, TriangleKernel> triangle(0.0f);
+		KernelFilteredNumber<float, 4, 1, ExponentialKernel<1> > exponential(0.0f);
+		KernelFilteredNumber<float, 4, 1, GaussianKernel<2> > gaussian(0.0f);
+
+		for(int i = 0; i < 4; i++)
+		{
+			CHECK_CLOSE(1.0f, box.getWeight(i), FLOAT_THRESHOLD);
+			CHECK_CLOSE((float) (4 - i), triangle.getWeight(i), FLOAT_THRESHOLD);
+			CHECK_CLOSE(1.0f / (1 << i), exponential.getWeight(i), FLOAT_THRESHOLD);
+			CHECK_CLOSE((float) exp(-i * i / 8.0), gaussian.getWeight(i), FLOAT_THRESHOLD);
+		}
+
+		CHECK_EQUAL(WEIGHTS_UNIFORM, box.getWeightShape());
+		CHECK_EQUAL(WEIGHTS_LINEAR, triangle.getWeightShape());
+		CHECK_EQUAL(WEIGHTS_EXPONENTIAL, exponential.getWeightShape());
+		CHECK_EQUAL(WEIGHTS_GENERAL, gaussian.getWeightShape());
+	}
+
+	TEST(TestBoxKernel)
+	{
+		KernelFilteredNumber<float, 4, 1, BoxKernel> n(0.0f);
+
+		n.setValue(4);
+		CHECK_CLOSE(1.0f, n.getValue(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(4.0f, n.getValue(0), FLOAT_THRESHOLD);
+
+		n.setValue(4);
+		n.setValue(4);
+		n.setValue(4);
+		CHECK_CLOSE(4.0f, n.getValue(), FLOAT_THRESHOLD);
+
+		n.setValue(0);
+		CHECK_CLOSE(3.0f, n.getValue(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestGetValueOutOfBounds)
+	{
+		KernelFilteredNumber<float, 4, 2, TriangleKernel> n(0.0f);
+
+		n.setValue(1.0f);
+		CHECK_CLOSE(0.0f, n.getValue(3), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestSameAsFilteredNumber)
+	{
+		checkKernelSameAsFilteredNumber<BoxKernel>(TEST_HELPER_ARGUMENTS);
+		checkKernelSameAsFilteredNumber<TriangleKernel>(TEST_HELPER_ARGUMENTS);
+		checkKernelSameAsFilteredNumber<ExponentialKernel<3> >(TEST_HELPER_ARGUMENTS);
+		checkKernelSameAsFilteredNumber<GaussianKernel<4> >(TEST_HELPER_ARGUMENTS);
+	}
+
+	TEST(TestKernelWeights)
+	{
+		FilteredNumber<float, 4, 2, KernelWeights<float, 4, TriangleKernel> > n(0.0f);
+		KernelFilteredNumber<float, 4, 2, TriangleKernel> kernel(0.0f);
+
+		CHECK_EQUAL(WEIGHTS_LINEAR, n.getWeightShape());
+		CHECK_CLOSE(4.0f, n.getWeight(0), FLOAT_THRESHOLD);
+
+		for(int i = 0; i < 10; i++)
+		{
+			n.setValue((float) (i * i % 5));
+			kernel.setValue((float) (i * i % 5));
+
+			CHECK_EQUAL(kernel.getValue(1), n.getValue(1));
+			CHECK_EQUAL(kernel.getValue(2), n.getValue(2));
+		}
+	}
+
+	TEST(TestNoWeightStorage)
+	{
+		CHECK(sizeof(KernelFilteredNumber<float, 64, 1, GaussianKernel<8> >) + 64 * sizeof(float)
+			<= sizeof(FilteredNumber<float, 64, 1>));
+	}
+}
@@ -0,0 +1,150 @@
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "BufferedState.h"
+#include "LazyBufferedState.h"
+
+using namespace luma::numbers;
+
+/**
+	Feeds the same pseudo-random states to a BufferedState and a
+	LazyBufferedState, and checks that the triggered states are
+	the same, and that the state values differ by at most maxDifference.
+*/
+template <unsigned int n>
+void checkSameAsBufferedState(TEST_HELPER_PARAMETERS, float increment, const float elapsedTimes[], int elapsedTimeCount, float maxDifference)
+{
+	float thresholds[n];
+	float stateValues[n];
+
+	for(unsigned int i = 0; i < n; i++)
+	{
+		thresholds[i] = 0.5f + 0.0625f * (i % 4);
+		stateValues[i] = i == 0 ? 1.0f : 0.0f;
+	}
+
+	BufferedState<n> expected(0, stateValues, thresholds, increment);
+	LazyBufferedState<n> actual(0, stateValues, thresholds, increment);
+	unsigned int random = 12345;
+
+	for(int step = 0; step < 2000; step++)
+	{
+		random = random * 1103515245u + 12345u;
+
+		//favour a few states for a while, so that states trigger
+		unsigned int state = ((random >> 16) % 4 + (step / 100) * 3) % n;
+		float elapsedTime = elapsedTimes[step % elapsedTimeCount];
+
+		unsigned int oldState = expected.getValue();
+
+		expected.setValue(state, elapsedTime);
+		CHECK_EQUAL(expected.getValue() != oldState, actual.update(state, elapsedTime));
+		CHECK_EQUAL(expected.getValue(), actual.getValue());
+
+		for(unsigned int i = 0; i < n; i++)
+		{
+			CHECK_CLOSE(expected.getStateValue(i), actual.getStateValue(i), maxDifference);
+		}
+
+		if(step == 1000)
+		{
+			expected.forceValue(n - 1);
+			actual.forceValue(n - 1);
+		}
+	}
+}
+
+SUITE(TestLazyBufferedState)
+{
+	TEST(TestStateTransition)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		LazyBufferedState<3> b(0, stateValues, thresholds, 0.1f);
+
+		for(int i = 0; i < 6; i++)
+		{
+			b.setValue(2);
+			CHECK_EQUAL(0u, b.getValue());
+		}
+
+		b.setValue(2);
+		CHECK_EQUAL(2u, b.getValue());
+	}
+
+	TEST(TestForceStateSetStateValues)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		LazyBufferedState<3> b(0, stateValues, thresholds, 0.2f);
+
+		b.forceValue(2);
+		b.setValue(0);
+		CHECK_EQUAL(2u, b.getValue());
+		CHECK_CLOSE(0.6f, b.getStateValue(2), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestExactlySameAsBufferedState)
+	{
+		float elapsedTimes[] = {1.0f, 0.5f, 2.0f, 0.25f};
+
+		checkSameAsBufferedState<8>(TEST_HELPER_ARGUMENTS, 0.125f, elapsedTimes, 4, 0.0f);
+		checkSameAsBufferedState<64>(TEST_HELPER_ARGUMENTS, 0.0625f, elapsedTimes, 4, 0.0f);
+	}
+
+	TEST(TestSameAsBufferedState)
+	{
+		float elapsedTimes[] = {1.0f, 0.9f, 1.2f};
+
+		checkSameAsBufferedState<8>(TEST_HELPER_ARGUMENTS, 0.1f, elapsedTimes, 1, 1e-5f);
+		checkSameAsBufferedState<8>(TEST_HELPER_ARGUMENTS, 0.07f, elapsedTimes, 3, 1e-5f);
+	}
+
+	TEST(TestRebase)
+	{
+		float thresholds[2] = {0.6f, 0.6f};
+		float stateValues[2] = {1.0f, 0.0f};
+
+		LazyBufferedState<2> b(0, stateValues, thresholds, 0.25f);
+
+		//decays past REBASE_DECAY twice
+		for(int i = 0; i < 8 * LazyBufferedState<2>::REBASE_DECAY + 2; i++)
+		{
+			b.setValue(i % 3 == 0 ? 1 : 0);
+		}
+
+		b.setValue(0);
+		b.setValue(0);
+		CHECK_EQUAL(0u, b.getValue());
+
+		b.setValue(1);
+		b.setValue(1);
+		CHECK_EQUAL(0.5f, b.getStateValue(1));
+		CHECK_EQUAL(0u, b.getValue());
+
+		b.setValue(1);
+		CHECK_EQUAL(1u, b.getValue());
+	}
+
+	TEST(TestProcess)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		LazyBufferedState<3> expected(0, stateValues, thresholds, 0.1f);
+		LazyBufferedState<3> actual(0, stateValues, thresholds, 0.1f);
+		unsigned int values[] = {2, 2, 2, 2, 2, 2, 2, 1, 1, 1};
+		unsigned int outputs[10];
+
+		actual.process(values, 0, outputs, 10);
+
+		for(int i = 0; i < 10; i++)
+		{
+			expected.setValue(values[i]);
+			CHECK_EQUAL(expected.getValue(), outputs[i]);
+		}
+
+		CHECK_EQUAL(2u, outputs[9]);
+	}
+}
@@ -0,0 +1,224 @@
+#include <vector>
+
+#include "UnitTest++.h"
+#include "BufferedNumber.h"
+#include "FilteredNumber.h"
+#include "NumberPool.h"
+
+using namespace luma::numbers;
+
+/**
+	Counts how many instances exist, to check that the pool
+	destroys what it creates.
+*/
+class CountedNumber
+{
+private:
+	int mValue;
+
+public:
+	static int sInstanceCount;
+
+	CountedNumber(int value):
+		mValue(value)
+	{
+		sInstanceCount++;
+	}
+
+	CountedNumber(const CountedNumber& other):
+		mValue(other.mValue)
+	{
+		sInstanceCount++;
+	}
+
+	~CountedNumber()
+	{
+		sInstanceCount--;
+	}
+
+	int getValue() const
+	{
+		return mValue;
+	}
+};
+
+int CountedNumber::sInstanceCount = 0;
+
+SUITE(TestNumberPool)
+{
+	TEST(TestCreateAndGet)
+	{
+		NumberPool<BufferedNumber<float> > pool;
+		NumberHandle a = pool.create(BufferedNumber<float>(0.5f, -1.0f, 1.0f, 0.1f));
+		NumberHandle b = pool.create(BufferedNumber<float>(-0.5f, -1.0f, 1.0f, 0.1f));
+
+		CHECK_EQUAL(2u, pool.getCount());
+		CHECK(pool.isValid(a));
+		CHECK(pool.isValid(b));
+
+		pool.get(a)->setValue(1.0f);
+
+		CHECK_CLOSE(0.6f, pool.get(a)->getValue(), FLOAT_THRESHOLD);
+		CHECK_CLOSE(-0.5f, pool.get(b)->getValue(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestDefaultHandleIsInvalid)
+	{
+		NumberPool<CountedNumber> pool;
+
+		CHECK(!pool.isValid(NumberHandle()));
+
+		pool.create(CountedNumber(1));
+
+		CHECK(!pool.isValid(NumberHandle()));
+		CHECK(pool.get(NumberHandle()) == 0);
+		CHECK(!pool.destroy(NumberHandle()));
+	}
+
+	TEST(TestDestroy)
+	{
+		{
+			NumberPool<CountedNumber, 4> pool;
+			NumberHandle a = pool.create(CountedNumber(1));
+			NumberHandle b = pool.create(CountedNumber(2));
+
+			CHECK_EQUAL(2, CountedNumber::sInstanceCount);
+
+			CHECK(pool.destroy(a));
+			CHECK_EQUAL(1, CountedNumber::sInstanceCount);
+			CHECK_EQUAL(1u, pool.getCount());
+
+			//stale handles are recognised, also after the slot is reused
+			CHECK(!pool.destroy(a));
+
+			NumberHandle c = pool.create(CountedNumber(3));
+
+			CHECK_EQUAL(a.slot, c.slot);
+			CHECK(!pool.isValid(a));
+			CHECK(pool.get(a) == 0);
+			CHECK_EQUAL(3, pool.get(c)->getValue());
+			CHECK_EQUAL(2, pool.get(b)->getValue());
+
+			for(int i = 0; i < 10; i++)
+			{
+				pool.create(CountedNumber(i));
+			}
+
+			CHECK_EQUAL(12, CountedNumber::sInstanceCount);
+		}
+
+		CHECK_EQUAL(0, CountedNumber::sInstanceCount);
+	}
+
+	TEST(TestClear)
+	{
+		NumberPool<CountedNumber, 4> pool;
+		NumberHandle a = pool.create(CountedNumber(1));
+
+		for(int i = 0; i < 6; i++)
+		{
+			pool.create(CountedNumber(i));
+		}
+
+		pool.clear();
+
+		CHECK_EQUAL(0, CountedNumber::sInstanceCount);
+		CHECK_EQUAL(0u, pool.getCount());
+		CHECK_EQUAL(8u, pool.getCapacity());
+		CHECK(!pool.isValid(a));
+		CHECK(pool.begin() == pool.end());
+	}
+
+	TEST(TestSlabsAreAligned)
+	{
+		typedef NumberPool<FilteredNumber<float, 3, 1>, 5> Pool;
+
+		Pool pool;
+		float weights[] = {1, 1, 1};
+		std::vector<NumberHandle> handles;
+
+		for(int i = 0; i < 11; i++)
+		{
+			handles.push_back(pool.create(FilteredNumber<float, 3, 1>(0.0f, weights)));
+		}
+
+		CHECK_EQUAL(15u, pool.getCapacity());
+
+		for(int i = 0; i < 11; i += 5)
+		{
+			CHECK_EQUAL(0u, (size_t) pool.get(handles[i]) % Pool::CACHE_LINE_SIZE);
+		}
+
+		//numbers of a slab are next to each other
+		CHECK(pool.get(handles[1]) == pool.get(handles[0]) + 1);
+	}
+
+	TEST(TestPointersAreStable)
+	{
+		NumberPool<CountedNumber, 2> pool;
+		NumberHandle first = pool.create(CountedNumber(7));
+		const CountedNumber * address = pool.get(first);
+
+		for(int i = 0; i < 100; i++)
+		{
+			pool.create(CountedNumber(i));
+		}
+
+		CHECK(address == pool.get(first));
+		CHECK_EQUAL(7, address->getValue());
+	}
+
+	TEST(TestIteration)
+	{
+		NumberPool<CountedNumber, 4> pool;
+		std::vector<NumberHandle> handles;
+
+		for(int i = 0; i < 10; i++)
+		{
+			handles.push_back(pool.create(CountedNumber(i)));
+		}
+
+		pool.destroy(handles[0]);
+		pool.destroy(handles[4]);
+		pool.destroy(handles[5]);
+		pool.destroy(handles[9]);
+
+		int expected[] = {1, 2, 3, 6, 7, 8};
+		int count = 0;
+
+		for(NumberPool<CountedNumber, 4>::Iterator i = pool.begin(); i != pool.end(); ++i)
+		{
+			CHECK_EQUAL(expected[count], i->getValue());
+			CHECK_EQUAL(expected[count], pool.get(i.getHandle())->getValue());
+			count++;
+		}
+
+		CHECK_EQUAL(6, count);
+	}
+
+	TEST(TestChurnReusesMemory)
+	{
+		NumberPool<CountedNumber, 16> pool;
+		std::vector<NumberHandle> handles;
+
+		for(int i = 0; i < 100; i++)
+		{
+			handles.push_back(pool.create(CountedNumber(i)));
+		}
+
+		size_t capacity = pool.getCapacity();
+
+		for(int round = 0; round < 50; round++)
+		{
+			for(int i = round % 3; i < 100; i += 3)
+			{
+				CHECK(pool.destroy(handles[i]));
+				handles[i] = pool.create(CountedNumber(i + round));
+			}
+		}
+
+		CHECK_EQUAL(capacity, pool.getCapacity());
+		CHECK_EQUAL(100u, pool.getCount());
+		CHECK_EQUAL(100, CountedNumber::sInstanceCount);
+	}
+}
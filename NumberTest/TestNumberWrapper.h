@@ -20,4 +20,20 @@ SUITE(TestNumberWrapper)
 		CHECK_CLOSE(1.34f, n.getValue(), FLOAT_THRESHOLD);
 
 	}
+
+	TEST(TestProcessThroughInterface)
+	{
+		NumberWrapper<float> n(1.0f);
+		UpdateableNumber<float>& updateable = n;
+		float values[] = {2.0f, 3.0f, 4.0f};
+		float outputs[3];
+
+		//the scalar fallback, with virtual calls
+		updateable.process(values, 0, outputs, 3);
+
+		CHECK_CLOSE(2.0f, outputs[0], FLOAT_THRESHOLD);
+		CHECK_CLOSE(3.0f, outputs[1], FLOAT_THRESHOLD);
+		CHECK_CLOSE(4.0f, outputs[2], FLOAT_THRESHOLD);
+		CHECK_CLOSE(4.0f, n.getValue(), FLOAT_THRESHOLD);
+	}
 }
\ No newline at end of file
@@ -210,4 +210,64 @@ SUITE(TestPIDBufferedNumber)
 
 		CHECK_CLOSE(0.0f, pidNumber.getValue(), FLOAT_THRESHOLD);
 	}
+
+	TEST(TestValueIsWeightedSum)
+	{
+		float dFactors[] = {0.1f, 0.2f};
+		float iFactors[] = {0.3f, 0.4f};
+		PIDBufferedNumber<float, 2, 2, 4> pidNumber(0.0f, 0.5f, dFactors, iFactors);
+		DifferentiableNumber<float, 2> dNumber(0.0f);
+		IntegrableNumber<float, 4, 2> iNumber(0.0f);
+
+		for(int i = 0; i < 20; i++)
+		{
+			float value = (float) ((i * 7) % 5) - 2.0f;
+			float elapsedTime = 0.5f + (i % 3) * 0.5f;
+
+			if(i == 10)
+			{
+				pidNumber.forceValue(value, elapsedTime);
+				dNumber.forceValue(value);
+				iNumber.forceValue(value, elapsedTime);
+			}
+			else
+			{
+				pidNumber.setValue(value, elapsedTime);
+				dNumber.setValue(value, elapsedTime);
+				iNumber.setValue(value, elapsedTime);
+			}
+
+			float expected = 0.5f * value
+				+ 0.1f * dNumber.getValue(1) + 0.2f * dNumber.getValue(2)
+				+ 0.3f * iNumber.getValue(1) + 0.4f * iNumber.getValue(2);
+
+			CHECK_CLOSE(expected, pidNumber.getValue(), FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestProcess)
+	{
+		float dFactors[] = {0.1f, 0.2f};
+		float iFactors[] = {0.3f};
+		PIDBufferedNumber<float, 2, 1, 4> expected(0.0f, 0.4f, dFactors, iFactors);
+		PIDBufferedNumber<float, 2, 1, 4> actual(0.0f, 0.4f, dFactors, iFactors);
+		float values[] = {1.0f, 3.0f, -2.0f, 0.5f, 0.0f, 2.5f, 1.0f};
+		float elapsedTimes[] = {1.0f, 2.0f, 0.5f, 3.0f, 1.0f, 1.5f, 1.0f};
+
+		//the outputs may overwrite the inputs
+		float outputs[7];
+
+		for(int i = 0; i < 7; i++)
+		{
+			outputs[i] = values[i];
+		}
+
+		actual.process(outputs, elapsedTimes, outputs, 7);
+
+		for(int i = 0; i < 7; i++)
+		{
+			expected.setValue(values[i], elapsedTimes[i]);
+			CHECK_EQUAL(expected.getValue(), outputs[i]);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "UnitTest++.h"
+#include "PIDBufferedNumber.h"
+#include "PIDControllerBank.h"
+#include "Simd.h"
+
+using namespace luma::numbers;
+
+//When the compiler fuses multiplications and additions (for example
+//with -march=native), it may do so differently for the bank and the
+//individual controllers, so that the last bits of the outputs differ.
+#if defined(NUMBERS_FMA)
+	#define CHECK_SAME_OUTPUT(expected, actual) CHECK_CLOSE(expected, actual, FLOAT_THRESHOLD)
+#else
+	#define CHECK_SAME_OUTPUT(expected, actual) CHECK_EQUAL(expected, actual)
+#endif
+
+SUITE(TestPIDControllerBank)
+{
+	TEST(TestConstructor)
+	{
+		float dFactors[] = {0.1f, 0.1f};
+		float iFactors[] = {0.1f};
+
+		PIDControllerBank<float, 2, 1, 4> bank(5, 0.0f, 0.4f, dFactors, iFactors);
+
+		CHECK_EQUAL(5u, bank.getControllerCount());
+
+		for(int i = 0; i < 5; i++)
+		{
+			CHECK_CLOSE(0.0f, bank.getValue(i), FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestSameAsPIDBufferedNumber)
+	{
+		const int controllerCount = 37;
+		float dFactors[] = {0.1f, 0.2f, 0.3f};
+		float iFactors[] = {0.4f, 0.5f, 0.6f};
+		float values[controllerCount];
+
+		PIDControllerBank<float, 3, 3, 5> bank(controllerCount, 0.0f, 0.7f, dFactors, iFactors);
+		std::vector<PIDBufferedNumber<float, 3, 3, 5> > numbers(controllerCount,
+			PIDBufferedNumber<float, 3, 3, 5>(0.0f, 0.7f, dFactors, iFactors));
+
+		for(int step = 0; step < 40; step++)
+		{
+			float elapsedTime = 0.5f + (rand() % 100) / 100.0f;
+
+			for(int i = 0; i < controllerCount; i++)
+			{
+				values[i] = (rand() % 2000) / 1000.0f - 1.0f;
+			}
+
+			if(step == 20)
+			{
+				bank.forceValue(values, elapsedTime);
+			}
+			else
+			{
+				bank.setValue(values, elapsedTime);
+			}
+
+			for(int i = 0; i < controllerCount; i++)
+			{
+				if(step == 20)
+				{
+					numbers[i].forceValue(values[i], elapsedTime);
+				}
+				else
+				{
+					numbers[i].setValue(values[i], elapsedTime);
+				}
+
+				CHECK_SAME_OUTPUT(numbers[i].getValue(), bank.getValue(i));
+				CHECK_SAME_OUTPUT(numbers[i].getValue(), bank.getValues()[i]);
+			}
+		}
+	}
+
+	TEST(TestSingleIntegral)
+	{
+		float dFactors[] = {0.3f};
+		float iFactors[] = {1.0f};
+		float values[] = {1.0f, 2.0f};
+
+		PIDControllerBank<float, 1, 1, 4> bank(2, 0.0f, 1.0f, dFactors, iFactors);
+		PIDBufferedNumber<float, 1, 1, 4> n0(0.0f, 1.0f, dFactors, iFactors);
+		PIDBufferedNumber<float, 1, 1, 4> n1(0.0f, 1.0f, dFactors, iFactors);
+
+		for(int step = 0; step < 10; step++)
+		{
+			float elapsedTime = step % 3 + 0.5f;
+
+			bank.setValue(values, elapsedTime);
+			n0.setValue(values[0], elapsedTime);
+			n1.setValue(values[1], elapsedTime);
+
+			CHECK_SAME_OUTPUT(n0.getValue(), bank.getValue(0));
+			CHECK_SAME_OUTPUT(n1.getValue(), bank.getValue(1));
+
+			values[0] += 0.5f;
+			values[1] -= 0.25f;
+		}
+	}
+}
@@ -0,0 +1,171 @@
+#include <thread>
+
+#include "UnitTest++.h"
+#include "BufferedNumber.h"
+#include "FilteredNumber.h"
+#include "PublishedNumber.h"
+
+using namespace luma::numbers;
+
+/**
+	A number whose value of order k is (k + 1) times its value,
+	so that readers can check that all orders were published
+	together.
+*/
+class MultipleNumber : public UpdateableNumber<int>
+{
+private:
+	int mValue;
+
+public:
+	MultipleNumber():
+		mValue(0)
+	{
+	}
+
+	int getValue() const
+	{
+		return mValue;
+	}
+
+	int getValue(unsigned int order) const
+	{
+		return mValue * (int) (order + 1);
+	}
+
+	void setValue(int value, float = TIME_UNIT)
+	{
+		mValue = value;
+	}
+};
+
+SUITE(TestPublishedNumber)
+{
+	TEST(TestConstructor)
+	{
+		PublishedNumber<BufferedNumber<float> > n(BufferedNumber<float>(0.5f, -1.0f, 1.0f, 0.1f));
+
+		CHECK_CLOSE(0.5f, n.getValue(), FLOAT_THRESHOLD);
+		CHECK_EQUAL(0u, n.getVersion());
+	}
+
+	TEST(TestSetValue)
+	{
+		PublishedNumber<BufferedNumber<float> > n(BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.1f));
+		BufferedNumber<float> expected(0.0f, -1.0f, 1.0f, 0.1f);
+
+		for(int i = 0; i < 5; i++)
+		{
+			n.setValue(1.0f);
+			expected.setValue(1.0f);
+
+			CHECK_CLOSE(expected.getValue(), n.getValue(), FLOAT_THRESHOLD);
+			CHECK_EQUAL((unsigned int) i + 1, n.getVersion());
+		}
+	}
+
+	TEST(TestAllOrders)
+	{
+		float weights[] = {1, 1, 1, 1};
+		PublishedNumber<FilteredNumber<float, 4, 2>, 2> n(FilteredNumber<float, 4, 2>(0.0f, weights));
+		FilteredNumber<float, 4, 2> expected(0.0f, weights);
+		float values[3];
+
+		for(int i = 0; i < 6; i++)
+		{
+			n.setValue((float) i, 0.5f);
+			expected.setValue((float) i, 0.5f);
+
+			n.getValues(values);
+
+			for(unsigned int order = 0; order <= 2; order++)
+			{
+				CHECK_CLOSE(expected.getValue(order), values[order], FLOAT_THRESHOLD);
+				CHECK_CLOSE(expected.getValue(order), n.getValue(order), FLOAT_THRESHOLD);
+			}
+		}
+	}
+
+	TEST(TestOrderZeroForAnyMaxOrder)
+	{
+		float weights[] = {1, 1, 1, 1};
+		PublishedNumber<FilteredNumber<float, 4, 2> > onlyOrderZero(FilteredNumber<float, 4, 2>(0.0f, weights));
+		PublishedNumber<FilteredNumber<float, 4, 2>, 2> allOrders(FilteredNumber<float, 4, 2>(0.0f, weights));
+
+		for(int i = 1; i < 6; i++)
+		{
+			onlyOrderZero.setValue((float) i, 0.5f);
+			allOrders.setValue((float) i, 0.5f);
+
+			//the last value set, not the filtered value
+			CHECK_EQUAL((float) i, onlyOrderZero.getValue());
+			CHECK_EQUAL((float) i, allOrders.getValue());
+			CHECK_EQUAL(onlyOrderZero.getNumber().getValue(0), onlyOrderZero.getValue(0));
+		}
+	}
+
+	TEST(TestOrderOutOfRange)
+	{
+		float weights[] = {1, 1, 1, 1};
+		PublishedNumber<FilteredNumber<float, 4, 2>, 1> n(FilteredNumber<float, 4, 2>(0.0f, weights), -1.0f);
+		PublishedNumber<BufferedNumber<float> > defaulted(BufferedNumber<float>(0.5f, -1.0f, 1.0f, 0.1f));
+
+		n.setValue(3.0f);
+
+		//like filtered numbers, the initial value, not the value of order 0
+		CHECK_EQUAL(-1.0f, n.getValue(2));
+		CHECK_EQUAL(0.0f, defaulted.getValue(1));
+	}
+
+	TEST(TestPublish)
+	{
+		PublishedNumber<BufferedNumber<float> > n(BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.1f));
+
+		n.getNumber().forceValue(0.75f);
+		CHECK_CLOSE(0.0f, n.getValue(), FLOAT_THRESHOLD);
+
+		n.publish();
+		CHECK_CLOSE(0.75f, n.getValue(), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestConsistentSnapshots)
+	{
+		const int updateCount = 200000;
+		PublishedNumber<MultipleNumber, 3> n((MultipleNumber()));
+		int inconsistentCount = 0;
+		int lastValue = 0;
+		bool increasing = true;
+
+		std::thread writer([&n]()
+		{
+			for(int i = 1; i <= updateCount; i++)
+			{
+				n.setValue(i);
+			}
+		});
+
+		while(lastValue < updateCount)
+		{
+			int values[4];
+
+			n.getValues(values);
+
+			for(int order = 1; order <= 3; order++)
+			{
+				if(values[order] != values[0] * (order + 1))
+				{
+					inconsistentCount++;
+				}
+			}
+
+			increasing = increasing && values[0] >= lastValue;
+			lastValue = values[0];
+		}
+
+		writer.join();
+
+		CHECK_EQUAL(0, inconsistentCount);
+		CHECK(increasing);
+		CHECK_EQUAL((unsigned int) updateCount, n.getVersion());
+	}
+}
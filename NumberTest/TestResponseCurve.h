@@ -31,4 +31,85 @@ SUITE(TestTransferFunction)
 		CHECK_CLOSE(4.0f, f(2.0f), FLOAT_THRESHOLD);
 		CHECK_CLOSE(5.0f, f(2.5f), FLOAT_THRESHOLD);
 	}
+
+	TEST(TestEvaluateSameAsOperator)
+	{
+		float outputSamples[16];
+		double doubleOutputSamples[16];
+
+		for(int i = 0; i < 16; i++)
+		{
+			outputSamples[i] = (float) (i * i % 7);
+			doubleOutputSamples[i] = outputSamples[i];
+		}
+
+		ResponseCurve<float, 16> f(-1.0f, 2.0f, outputSamples);
+		ResponseCurve<double, 16> g(-1.0, 2.0, doubleOutputSamples);
+
+		//not a multiple of the SIMD width, to test the remainder
+		float inputs[101];
+		float outputs[101];
+		double doubleInputs[101];
+		double doubleOutputs[101];
+
+		for(int i = 0; i < 101; i++)
+		{
+			inputs[i] = -1.5f + i * 0.04f;
+			doubleInputs[i] = inputs[i];
+		}
+
+		f.evaluate(inputs, outputs, 101);
+		g.evaluate(doubleInputs, doubleOutputs, 101);
+
+		for(int i = 0; i < 101; i++)
+		{
+			CHECK_CLOSE(f(inputs[i]), outputs[i], FLOAT_THRESHOLD);
+			CHECK_CLOSE(g(doubleInputs[i]), doubleOutputs[i], FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestEvaluateClamps)
+	{
+		float outputSamples[3] = {3.0f, 4.0f, 6.0f};
+		ResponseCurve<float, 3> f(1.0f, 3.0f, outputSamples);
+
+		float values[9] = {-100.0f, 0.0f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 4.0f, 100.0f};
+		float expected[9] = {3.0f, 3.0f, 3.0f, 3.5f, 4.0f, 5.0f, 6.0f, 6.0f, 6.0f};
+
+		//in place
+		f.evaluate(values, values, 9);
+
+		for(int i = 0; i < 9; i++)
+		{
+			CHECK_CLOSE(expected[i], values[i], FLOAT_THRESHOLD);
+		}
+	}
+
+	TEST(TestEvaluateIntegers)
+	{
+		int outputSamples[3] = {0, 100, 300};
+		ResponseCurve<int, 3> f(-10, 10, outputSamples);
+
+		int inputs[25];
+		int outputs[25];
+
+		for(int i = 0; i < 25; i++)
+		{
+			inputs[i] = i - 12;
+		}
+
+		f.evaluate(inputs, outputs, 25);
+
+		CHECK_EQUAL(0, outputs[0]);
+		CHECK_EQUAL(50, outputs[7]);
+		CHECK_EQUAL(100, outputs[12]);
+		CHECK_EQUAL(200, outputs[17]);
+		CHECK_EQUAL(300, outputs[24]);
+
+		//the same up to rounding
+		for(int i = 0; i < 25; i++)
+		{
+			CHECK_CLOSE(f(inputs[i]), outputs[i], 1);
+		}
+	}
 }
\ No newline at end of file
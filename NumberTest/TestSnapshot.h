@@ -0,0 +1,565 @@
+#include <vector>
+#include <new>
+
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "Snapshot.h"
+#include "Fixed.h"
+#include "ClampedNumber.h"
+#include "CyclicNumber.h"
+#include "PingPongNumber.h"
+#include "BasicRangedNumber.h"
+#include "BufferedBool.h"
+#include "BufferedBoolArray.h"
+#include "BufferedState.h"
+#include "LazyBufferedState.h"
+#include "BufferedStep.h"
+#include "BufferedNumber.h"
+#include "NumberWrapper.h"
+#include "FilteredNumber.h"
+#include "FilteredNumberBank.h"
+#include "KernelFilteredNumber.h"
+#include "DifferentiableNumber.h"
+#include "IntegrableNumber.h"
+#include "PIDBufferedNumber.h"
+#include "PIDControllerBank.h"
+#include "TransitionBank.h"
+#include "WindowMedianNumber.h"
+#include "WindowMinMaxNumber.h"
+
+using namespace luma::numbers;
+
+/**
+	Writes a number to a snapshot, and reads the snapshot into
+	another number. Returns false if reading failed, or did not
+	read the whole snapshot.
+*/
+template <class From, class To>
+bool copyThroughSnapshot(const From& from, To& to)
+{
+	std::vector<unsigned char> snapshot;
+	SnapshotWriter writer(snapshot);
+
+	from.serialize(writer);
+
+	SnapshotReader reader(&snapshot[0], snapshot.size());
+
+	return to.deserialize(reader) && reader.getPosition() == snapshot.size();
+}
+
+/**
+	Writes a number to a snapshot, overwrites the bytes at the given
+	offset (counted from the end of the header) with value, and reads
+	the snapshot into another number. Returns what deserialize returns.
+*/
+template <class Number, class Value>
+bool copyThroughDamagedSnapshot(const Number& from, Number& to, size_t offset, Value value)
+{
+	std::vector<unsigned char> snapshot;
+	SnapshotWriter writer(snapshot);
+	size_t headerSize = writer.getSize();
+
+	from.serialize(writer);
+	memcpy(&snapshot[headerSize + offset], &value, sizeof(value));
+
+	SnapshotReader reader(&snapshot[0], snapshot.size());
+
+	return to.deserialize(reader);
+}
+
+/**
+	Updates two updateable numbers with the same values, and checks
+	that their values stay exactly the same.
+*/
+template <class Number>
+void checkSameUpdates(TEST_HELPER_PARAMETERS, Number& expected, Number& actual, float scale)
+{
+	for(int i = 0; i < 20; i++)
+	{
+		typename Number::ValueType value = (typename Number::ValueType) (((i * 7) % 11) * scale);
+		float elapsedTime = 0.5f + (i % 3) * 0.25f;
+
+		expected.setValue(value, elapsedTime);
+		actual.setValue(value, elapsedTime);
+
+		CHECK_EQUAL(expected.getValue(), actual.getValue());
+	}
+}
+
+SUITE(TestSnapshot)
+{
+	TEST(TestHeader)
+	{
+		std::vector<unsigned char> snapshot;
+		SnapshotWriter writer(snapshot);
+
+		writer.write(1.5f);
+
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+		float value = 0;
+
+		CHECK(reader.isOk());
+		CHECK_EQUAL(SNAPSHOT_VERSION, reader.getVersion());
+		CHECK(reader.read(value));
+		CHECK_EQUAL(1.5f, value);
+
+		//nothing left
+		CHECK(!reader.read(value));
+		CHECK(!reader.isOk());
+	}
+
+	TEST(TestDamagedHeaderFails)
+	{
+		std::vector<unsigned char> snapshot;
+		SnapshotWriter writer(snapshot);
+
+		writer.write(1.5f);
+
+		std::vector<unsigned char> wrongMagic(snapshot);
+		wrongMagic[0] ^= 1;
+		CHECK(!SnapshotReader(&wrongMagic[0], wrongMagic.size()).isOk());
+
+		std::vector<unsigned char> newerVersion(snapshot);
+		unsigned int version = SNAPSHOT_VERSION + 1;
+		memcpy(&newerVersion[sizeof(unsigned int)], &version, sizeof(version));
+		CHECK(!SnapshotReader(&newerVersion[0], newerVersion.size()).isOk());
+
+		CHECK(!SnapshotReader(&snapshot[0], 5).isOk());
+	}
+
+	TEST(TestRangedNumbers)
+	{
+		ClampedNumber<float> clamped(0.5f, 0.0f, 2.0f, 0.25f);
+		ClampedNumber<float> restoredClamped(0.0f, -1.0f, 1.0f, 0.1f);
+		PingPongNumber<int> pingPong(0, 0, 4, 1);
+		PingPongNumber<int> restoredPingPong(0, 0, 4, 1);
+		BasicRangedNumber<float, ReflectPolicy> reflected(0.0f, 0.0f, 1.0f, 0.3f);
+		BasicRangedNumber<float, ReflectPolicy> restoredReflected(0.0f, 0.0f, 1.0f, 0.1f);
+		ClampedNumber<Fixed16> fixed(Fixed16(0), Fixed16(-4), Fixed16(4), Fixed16(0.375));
+		ClampedNumber<Fixed16> restoredFixed(Fixed16(0), Fixed16(0), Fixed16(1), Fixed16(0.5));
+
+		clamped.inc();
+		clamped.inc(0.5f);
+
+		//on the way down, which only the cyclic value tells
+		for(int i = 0; i < 5; i++)
+		{
+			pingPong++;
+		}
+
+		for(int i = 0; i < 4; i++)
+		{
+			reflected.inc();
+			fixed.dec();
+		}
+
+		CHECK(copyThroughSnapshot(clamped, restoredClamped));
+		CHECK(copyThroughSnapshot(pingPong, restoredPingPong));
+		CHECK(copyThroughSnapshot(reflected, restoredReflected));
+		CHECK(copyThroughSnapshot(fixed, restoredFixed));
+
+		for(int i = 0; i < 6; i++)
+		{
+			clamped.inc();
+			restoredClamped.inc();
+			pingPong++;
+			restoredPingPong++;
+			reflected.inc();
+			restoredReflected.inc();
+			fixed.dec(0.5f);
+			restoredFixed.dec(0.5f);
+
+			CHECK_EQUAL(clamped.getValue(), restoredClamped.getValue());
+			CHECK_EQUAL(pingPong.getValue(), restoredPingPong.getValue());
+			CHECK_EQUAL(reflected.getValue(), restoredReflected.getValue());
+			CHECK_EQUAL(fixed.getValue().getRaw(), restoredFixed.getValue().getRaw());
+		}
+	}
+
+	TEST(TestThroughBaseClass)
+	{
+		CyclicNumber<int> cyclic(3, 0, 7, 2);
+		CyclicNumber<int> restored(0, 0, 7, 1);
+		const RangedNumber<int>& base = cyclic;
+
+		CHECK(copyThroughSnapshot(base, restored));
+		CHECK_EQUAL(3, restored.getValue());
+		CHECK_EQUAL(2, restored.increment());
+	}
+
+	TEST(TestBufferedNumbers)
+	{
+		BufferedBool flag(0.3f, 0.6f, 0.1f);
+		BufferedBool restoredFlag(0.1f, 0.9f, 0.5f);
+		BufferedNumber<float> buffered(0.0f, -10.0f, 10.0f, 0.5f);
+		BufferedNumber<float> restoredBuffered(0.0f, 0.0f, 1.0f, 0.1f);
+		NumberWrapper<float> wrapper(2.0f);
+		NumberWrapper<float> restoredWrapper(0.0f);
+
+		for(int i = 0; i < 7; i++)
+		{
+			flag.setValue(true);
+			buffered.setValue(4.0f);
+		}
+
+		CHECK(copyThroughSnapshot(flag, restoredFlag));
+		CHECK(copyThroughSnapshot(buffered, restoredBuffered));
+		CHECK(copyThroughSnapshot(wrapper, restoredWrapper));
+
+		CHECK_EQUAL(true, restoredFlag.getValue());
+		CHECK_EQUAL(flag.getFloatValue(), restoredFlag.getFloatValue());
+		CHECK_EQUAL(2.0f, restoredWrapper.getValue());
+
+		for(int i = 0; i < 10; i++)
+		{
+			flag.setValue(i % 4 == 0);
+			restoredFlag.setValue(i % 4 == 0);
+
+			CHECK_EQUAL(flag.getValue(), restoredFlag.getValue());
+		}
+
+		checkSameUpdates(TEST_HELPER_ARGUMENTS, buffered, restoredBuffered, -1.0f);
+	}
+
+	TEST(TestBufferedStep)
+	{
+		float upwardsThresholds[] = {0.3f, 0.6f, 0.9f};
+		float downwardsThresholds[] = {0.1f, 0.4f, 0.7f};
+		float otherThresholds[] = {0.5f, 0.5f, 0.5f};
+
+		BufferedStep<4> step(0.0f, 1.0f, upwardsThresholds, downwardsThresholds, 0.05f);
+		BufferedStep<4> restored(0.0f, 1.0f, otherThresholds, otherThresholds, 0.2f);
+
+		for(int i = 0; i < 12; i++)
+		{
+			step.setStateUp(true);
+		}
+
+		CHECK(copyThroughSnapshot(step, restored));
+
+		for(int i = 0; i < 30; i++)
+		{
+			step.setStateUp(i < 10 || i % 3 == 0);
+			restored.setStateUp(i < 10 || i % 3 == 0);
+
+			CHECK_EQUAL(step.getState(), restored.getState());
+		}
+	}
+
+	TEST(TestBufferedStates)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float otherThresholds[3] = {0.9f, 0.9f, 0.9f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		BufferedState<3> state(0, stateValues, thresholds, 0.125f);
+		BufferedState<3> restoredState(0, stateValues, otherThresholds, 0.5f);
+		LazyBufferedState<3> restoredLazy(0, stateValues, otherThresholds, 0.5f);
+		BufferedState<3> restoredFromLazy(0, stateValues, otherThresholds, 0.5f);
+
+		for(int i = 0; i < 5; i++)
+		{
+			state.setValue(2);
+		}
+
+		state.setValue(1);
+
+		CHECK(copyThroughSnapshot(state, restoredState));
+		CHECK(copyThroughSnapshot(state, restoredLazy));
+
+		for(int i = 0; i < 12; i++)
+		{
+			unsigned int value = i < 4 ? 2 : 1;
+
+			state.setValue(value);
+			restoredState.setValue(value);
+			restoredLazy.setValue(value);
+
+			CHECK_EQUAL(state.getValue(), restoredState.getValue());
+			CHECK_EQUAL(state.getValue(), restoredLazy.getValue());
+
+			for(unsigned int j = 0; j < 3; j++)
+			{
+				CHECK_EQUAL(state.getStateValue(j), restoredLazy.getStateValue(j));
+			}
+		}
+
+		CHECK(copyThroughSnapshot(restoredLazy, restoredFromLazy));
+
+		for(unsigned int j = 0; j < 3; j++)
+		{
+			CHECK_EQUAL(state.getStateValue(j), restoredFromLazy.getStateValue(j));
+		}
+	}
+
+	TEST(TestFilteredNumbers)
+	{
+		float weights[] = {8, 4, 2, 1};
+		float otherWeights[] = {1, 1, 1, 1};
+
+		FilteredNumber<float, 4, 2> filtered(0.0f, weights);
+		FilteredNumber<float, 4, 2> restoredFiltered(0.0f, otherWeights);
+		KernelFilteredNumber<float, 8, 2, TriangleKernel> kernel(0.0f);
+		KernelFilteredNumber<float, 8, 2, TriangleKernel> restoredKernel(0.0f);
+		IntegrableNumber<float, 5, 3> integrable(0.0f);
+		IntegrableNumber<float, 5, 3> restoredIntegrable(0.0f);
+		DifferentiableNumber<float, 3> differentiable(0.0f);
+		DifferentiableNumber<float, 3> restoredDifferentiable(0.0f);
+
+		for(int i = 0; i < 7; i++)
+		{
+			filtered.setValue((float) i, 0.5f);
+			kernel.setValue((float) (i * i), 0.75f);
+			integrable.setValue((float) -i, 1.25f);
+			differentiable.setValue((float) (i * i * i), 0.5f);
+		}
+
+		CHECK(copyThroughSnapshot(filtered, restoredFiltered));
+		CHECK(copyThroughSnapshot(kernel, restoredKernel));
+		CHECK(copyThroughSnapshot(integrable, restoredIntegrable));
+		CHECK(copyThroughSnapshot(differentiable, restoredDifferentiable));
+
+		CHECK_EQUAL(filtered.getWeightShape(), restoredFiltered.getWeightShape());
+		CHECK_EQUAL(8.0f, restoredFiltered.getWeight(0));
+
+		checkSameUpdates(TEST_HELPER_ARGUMENTS, filtered, restoredFiltered, 0.5f);
+		checkSameUpdates(TEST_HELPER_ARGUMENTS, kernel, restoredKernel, 2.0f);
+
+		for(int i = 0; i < 20; i++)
+		{
+			integrable.setValue((float) (i % 5), 0.5f);
+			restoredIntegrable.setValue((float) (i % 5), 0.5f);
+		}
+
+		checkSameUpdates(TEST_HELPER_ARGUMENTS, differentiable, restoredDifferentiable, 3.0f);
+
+		for(unsigned int order = 0; order <= 3; order++)
+		{
+			CHECK_EQUAL(filtered.getValue(order), restoredFiltered.getValue(order));
+			CHECK_EQUAL(integrable.getValue(order), restoredIntegrable.getValue(order));
+			CHECK_EQUAL(differentiable.getValue(order), restoredDifferentiable.getValue(order));
+		}
+	}
+
+	TEST(TestUnusedSumIsWrittenAsZero)
+	{
+		typedef KernelWeightedSum<float, 4, BoxKernel> Sum;
+
+		//fill the memory first, so that a member the constructor
+		//leaves alone does not happen to be 0
+		double memory[sizeof(Sum) / sizeof(double) + 1];
+		memset(memory, 0xAB, sizeof(memory));
+		Sum * sum = new(memory) Sum();
+
+		std::vector<unsigned char> snapshot;
+		SnapshotWriter writer(snapshot);
+		sum->serialize(writer);
+
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+		float weightedSum = 1;
+		float unweightedSum = 1;
+
+		CHECK(reader.read(weightedSum));
+		CHECK(reader.read(unweightedSum));
+		CHECK_EQUAL(0.0f, weightedSum);
+		CHECK_EQUAL(0.0f, unweightedSum);
+	}
+
+	TEST(TestPIDBufferedNumber)
+	{
+		float dFactors[] = {0.1f, 0.2f};
+		float iFactors[] = {0.3f};
+		float otherFactors[] = {1.0f, 1.0f};
+
+		PIDBufferedNumber<float, 2, 1, 4> pid(0.0f, 0.7f, dFactors, iFactors);
+		PIDBufferedNumber<float, 2, 1, 4> restored(0.0f, 1.0f, otherFactors, otherFactors);
+
+		for(int i = 0; i < 6; i++)
+		{
+			pid.setValue((float) (i % 4), 0.5f);
+		}
+
+		CHECK(copyThroughSnapshot(pid, restored));
+		CHECK_EQUAL(pid.getValue(), restored.getValue());
+
+		checkSameUpdates(TEST_HELPER_ARGUMENTS, pid, restored, 0.25f);
+	}
+
+	TEST(TestBanks)
+	{
+		const unsigned int count = 37;
+		float weights[] = {1, 2, 4, 8};
+		float dFactors[] = {0.1f, 0.2f};
+		float iFactors[] = {0.3f};
+		float values[count];
+		BufferedBoolArray<>::Word inputs[2] = {0x5555AAAA, 0x1F};
+
+		FilteredNumberBank<float, 4, 2> filters(count, 0.0f, weights);
+		FilteredNumberBank<float, 4, 2> restoredFilters(count, 0.0f, weights);
+		PIDControllerBank<float, 2, 1, 4> controllers(count, 0.0f, 0.7f, dFactors, iFactors);
+		PIDControllerBank<float, 2, 1, 4> restoredControllers(count, 0.0f, 0.7f, dFactors, iFactors);
+		BufferedBoolArray<> flags(count, 0.3f, 0.6f, 0.1f);
+		BufferedBoolArray<> restoredFlags(count, 0.3f, 0.6f, 0.1f);
+
+		flags.setThresholds(3, 0.1f, 0.2f);
+
+		for(int step = 0; step < 9; step++)
+		{
+			for(unsigned int i = 0; i < count; i++)
+			{
+				values[i] = (float) ((i * 13 + step * 5) % 17);
+			}
+
+			filters.setValue(values, 0.5f);
+			controllers.setValue(values, 0.5f);
+			flags.setValues(inputs, 1.5f);
+		}
+
+		CHECK(copyThroughSnapshot(filters, restoredFilters));
+		CHECK(copyThroughSnapshot(controllers, restoredControllers));
+		CHECK(copyThroughSnapshot(flags, restoredFlags));
+
+		inputs[0] = ~inputs[0];
+
+		for(int step = 0; step < 9; step++)
+		{
+			for(unsigned int i = 0; i < count; i++)
+			{
+				values[i] = (float) ((i * 7 + step * 3) % 13);
+			}
+
+			filters.setValue(values, 0.75f);
+			restoredFilters.setValue(values, 0.75f);
+			controllers.setValue(values, 0.75f);
+			restoredControllers.setValue(values, 0.75f);
+			flags.setValues(inputs);
+			restoredFlags.setValues(inputs);
+
+			for(unsigned int i = 0; i < count; i++)
+			{
+				CHECK_EQUAL(filters.getValue(i, 2), restoredFilters.getValue(i, 2));
+				CHECK_EQUAL(controllers.getValue(i), restoredControllers.getValue(i));
+				CHECK_EQUAL(flags.getValue(i), restoredFlags.getValue(i));
+				CHECK_EQUAL(flags.getLevel(i), restoredFlags.getLevel(i));
+			}
+		}
+	}
+
+	TEST(TestTransitionBank)
+	{
+		TransitionBank<BufferedBool> bank(5, BufferedBool(0.3f, 0.6f, 0.1f));
+		TransitionBank<BufferedBool> restored(5, BufferedBool(0.3f, 0.6f, 0.1f));
+		TransitionQueue<bool> transitions(5);
+		bool values[] = {true, false, true, false, true};
+
+		for(int i = 0; i < 6; i++)
+		{
+			bank.setValues(values, TIME_UNIT, transitions);
+		}
+
+		CHECK(copyThroughSnapshot(bank, restored));
+
+		restored.setValues(values, TIME_UNIT, transitions);
+
+		CHECK_EQUAL(3u, transitions.getCount());
+		CHECK_EQUAL(4u, transitions[2].id);
+	}
+
+	TEST(TestMismatchedNumbersFail)
+	{
+		float weights4[] = {1, 2, 4, 8};
+		float weights5[] = {1, 2, 4, 8, 16};
+		float thresholds[4] = {0.6f, 0.6f, 0.6f, 0.6f};
+		float stateValues[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+
+		FilteredNumber<float, 4, 2> filtered(0.0f, weights4);
+		FilteredNumber<float, 5, 2> otherSampleCount(0.0f, weights5);
+		FilteredNumber<float, 4, 1> otherOrder(0.0f, weights4);
+		FilteredNumberBank<float, 4, 2> bank(10, 0.0f, weights4);
+		FilteredNumberBank<float, 4, 2> otherBank(11, 0.0f, weights4);
+		BufferedState<3> state(0, stateValues, thresholds, 0.1f);
+		BufferedState<4> otherState(0, stateValues, thresholds, 0.1f);
+
+		CHECK(!copyThroughSnapshot(filtered, otherSampleCount));
+		CHECK(!copyThroughSnapshot(filtered, otherOrder));
+		CHECK(!copyThroughSnapshot(bank, otherBank));
+		CHECK(!copyThroughSnapshot(state, otherState));
+	}
+
+	TEST(TestIndicesOutOfRangeFail)
+	{
+		float weights[] = {1, 2, 4, 8};
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		FilteredNumber<float, 4, 2> filtered(0.0f, weights);
+		FilteredNumber<float, 4, 2> restoredFiltered(0.0f, weights);
+		BufferedState<3> state(0, stateValues, thresholds, 0.1f);
+		BufferedState<3> restoredState(0, stateValues, thresholds, 0.1f);
+		LazyBufferedState<3> lazy(0, stateValues, thresholds, 0.1f);
+		LazyBufferedState<3> restoredLazy(0, stateValues, thresholds, 0.1f);
+		WindowMedianNumber<float, 5> median(0.0f);
+		WindowMedianNumber<float, 5> restoredMedian(0.0f);
+		WindowMinMaxNumber<float, 4> minMax(0.0f);
+		WindowMinMaxNumber<float, 4> restoredMinMax(0.0f);
+
+		//the current index follows the sizes, the samples, the
+		//weights, the time samples, and the initial and current values
+		size_t filteredIndex = 2 * sizeof(unsigned int) + 14 * sizeof(float);
+		CHECK(copyThroughDamagedSnapshot(filtered, restoredFiltered, filteredIndex, 3));
+		CHECK(!copyThroughDamagedSnapshot(filtered, restoredFiltered, filteredIndex, 4));
+		CHECK(!copyThroughDamagedSnapshot(filtered, restoredFiltered, filteredIndex, -1));
+
+		//the state follows the size, the increment, the state values
+		//and the thresholds
+		size_t stateIndex = sizeof(unsigned int) + 7 * sizeof(float);
+		CHECK(copyThroughDamagedSnapshot(state, restoredState, stateIndex, 2u));
+		CHECK(!copyThroughDamagedSnapshot(state, restoredState, stateIndex, 3u));
+		CHECK(copyThroughDamagedSnapshot(lazy, restoredLazy, stateIndex, 2u));
+		CHECK(!copyThroughDamagedSnapshot(lazy, restoredLazy, stateIndex, 3u));
+
+		//the heap and the positions follow the size and the samples;
+		//the heap must hold every slot once
+		size_t heap = sizeof(unsigned int) + 5 * sizeof(float);
+		size_t medianIndex = heap + 10 * sizeof(int);
+		CHECK(!copyThroughDamagedSnapshot(median, restoredMedian, heap, 1));
+		CHECK(!copyThroughDamagedSnapshot(median, restoredMedian, heap, 5));
+		CHECK(!copyThroughDamagedSnapshot(median, restoredMedian, heap, -1));
+		CHECK(copyThroughDamagedSnapshot(median, restoredMedian, medianIndex, 4));
+		CHECK(!copyThroughDamagedSnapshot(median, restoredMedian, medianIndex, 5));
+
+		//the front and the count of the minimum follow the size, the
+		//current value, the sequence, and the values and sequences
+		//of the minimum
+		size_t front = 2 * sizeof(unsigned int) + 5 * sizeof(float) + 4 * sizeof(unsigned int);
+		size_t count = front + sizeof(int);
+		CHECK(!copyThroughDamagedSnapshot(minMax, restoredMinMax, front, 4));
+		CHECK(!copyThroughDamagedSnapshot(minMax, restoredMinMax, front, -1));
+		CHECK(copyThroughDamagedSnapshot(minMax, restoredMinMax, count, 4u));
+		CHECK(!copyThroughDamagedSnapshot(minMax, restoredMinMax, count, 5u));
+	}
+
+	TEST(TestSeveralNumbers)
+	{
+		std::vector<unsigned char> snapshot;
+		SnapshotWriter writer(snapshot);
+		ClampedNumber<float> first(0.5f, 0.0f, 1.0f, 0.1f);
+		CyclicNumber<int> second(4, 0, 10, 1);
+
+		first.serialize(writer);
+		second.serialize(writer);
+
+		ClampedNumber<float> restoredFirst(0.0f, 0.0f, 1.0f, 0.1f);
+		CyclicNumber<int> restoredSecond(0, 0, 10, 1);
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+
+		CHECK(restoredFirst.deserialize(reader));
+		CHECK(restoredSecond.deserialize(reader));
+		CHECK_EQUAL(0.5f, restoredFirst.getValue());
+		CHECK_EQUAL(4, restoredSecond.getValue());
+		CHECK_EQUAL(snapshot.size(), reader.getPosition());
+
+		//reading past the end fails
+		CHECK(!restoredSecond.deserialize(reader));
+	}
+}
@@ -0,0 +1,123 @@
+#include "UnitTest++.h"
+#include "BufferedBool.h"
+#include "BufferedBoolArray.h"
+#include "BufferedState.h"
+#include "TransitionQueue.h"
+#include "TransitionBank.h"
+
+using namespace luma::numbers;
+
+SUITE(TestTransitionBank)
+{
+	TEST(TestQueueDropsWhenFull)
+	{
+		TransitionQueue<bool> queue(2);
+
+		CHECK_EQUAL(true, queue.push(3, false, true));
+		CHECK_EQUAL(true, queue.push(5, true, false));
+		CHECK_EQUAL(false, queue.push(7, false, true));
+
+		CHECK_EQUAL(2u, queue.getCount());
+		CHECK_EQUAL(1u, queue.getDroppedCount());
+		CHECK_EQUAL(5u, queue[1].id);
+		CHECK_EQUAL(true, queue[1].oldState);
+		CHECK_EQUAL(false, queue[1].newState);
+
+		queue.clear();
+
+		CHECK_EQUAL(0u, queue.getCount());
+		CHECK_EQUAL(0u, queue.getDroppedCount());
+		CHECK_EQUAL(2u, queue.getCapacity());
+	}
+
+	TEST(TestBufferedBoolTransitions)
+	{
+		const int count = 10;
+
+		TransitionBank<BufferedBool> bank(count, BufferedBool(0.3f, 0.6f, 0.1f));
+		std::vector<BufferedBool> expected(count, BufferedBool(0.3f, 0.6f, 0.1f));
+		TransitionQueue<bool> transitions(count);
+		bool values[count];
+
+		for(int step = 0; step < 40; step++)
+		{
+			for(int i = 0; i < count; i++)
+			{
+				//flag i is on for 10 + i steps, then off
+				values[i] = step < 10 + i;
+			}
+
+			transitions.clear();
+			bank.setValues(values, TIME_UNIT, transitions);
+
+			size_t next = 0;
+
+			for(int i = 0; i < count; i++)
+			{
+				bool oldValue = expected[i].getValue();
+
+				expected[i].setValue(values[i]);
+				CHECK_EQUAL(expected[i].getValue(), bank.getValue(i));
+
+				if(expected[i].getValue() != oldValue)
+				{
+					CHECK(next < transitions.getCount());
+					CHECK_EQUAL((unsigned int) i, transitions[next].id);
+					CHECK_EQUAL(oldValue, transitions[next].oldState);
+					CHECK_EQUAL(expected[i].getValue(), transitions[next].newState);
+					next++;
+				}
+			}
+
+			CHECK_EQUAL(next, transitions.getCount());
+		}
+	}
+
+	TEST(TestBufferedStateTransitions)
+	{
+		float thresholds[3] = {0.6f, 0.6f, 0.6f};
+		float stateValues[3] = {1.0f, 0.0f, 0.0f};
+
+		TransitionBank<BufferedState<3> > bank(3, BufferedState<3>(0, stateValues, thresholds, 0.1f));
+		TransitionQueue<unsigned int> transitions(3);
+		unsigned int values[3] = {0, 1, 2};
+
+		for(int step = 0; step < 6; step++)
+		{
+			bank.setValues(values, TIME_UNIT, transitions);
+		}
+
+		CHECK_EQUAL(0u, transitions.getCount());
+
+		bank.setValues(values, TIME_UNIT, transitions);
+
+		CHECK_EQUAL(2u, transitions.getCount());
+		CHECK_EQUAL(1u, transitions[0].id);
+		CHECK_EQUAL(0u, transitions[0].oldState);
+		CHECK_EQUAL(1u, transitions[0].newState);
+		CHECK_EQUAL(2u, transitions[1].id);
+		CHECK_EQUAL(2u, transitions[1].newState);
+	}
+
+	TEST(TestBufferedBoolArrayTransitions)
+	{
+		BufferedBoolArray<> flags(40, 0.3f, 0.5f, 0.25f);
+		BufferedBoolArray<>::Word inputs[2] = {0x80000001, 0x80};
+		TransitionQueue<bool> transitions(40);
+
+		flags.setValues(inputs);
+		flags.appendTransitions(transitions);
+		CHECK_EQUAL(0u, transitions.getCount());
+
+		flags.setValues(inputs);
+		flags.setValues(inputs);
+		flags.appendTransitions(transitions);
+
+		CHECK_EQUAL(3u, transitions.getCount());
+		CHECK_EQUAL(0u, transitions[0].id);
+		CHECK_EQUAL(31u, transitions[1].id);
+		CHECK_EQUAL(39u, transitions[2].id);
+		CHECK_EQUAL(false, transitions[2].oldState);
+		CHECK_EQUAL(true, transitions[2].newState);
+	}
+}
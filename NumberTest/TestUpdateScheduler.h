@@ -0,0 +1,158 @@
+#include <vector>
+
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "BufferedNumber.h"
+#include "BufferedBool.h"
+#include "FilteredNumber.h"
+#include "UpdateScheduler.h"
+
+using namespace luma::numbers;
+
+/**
+	Adds count numbers of three types to a scheduler, ticks it,
+	and checks that every number has the same value as a copy that
+	was updated on this thread, one number at a time.
+*/
+inline void checkSameAsSequential(TEST_HELPER_PARAMETERS, unsigned int threadCount, size_t taskSize, unsigned int count)
+{
+	float weights[] = {4, 3, 2, 1};
+
+	UpdateScheduler scheduler(threadCount, taskSize);
+	UpdateArena<BufferedNumber<float> >& buffered = scheduler.getArena<BufferedNumber<float> >();
+	UpdateArena<BufferedBool>& flags = scheduler.getArena<BufferedBool>();
+	UpdateArena<FilteredNumber<float, 4, 1> >& filtered = scheduler.getArena<FilteredNumber<float, 4, 1> >();
+
+	std::vector<BufferedNumber<float> > expectedBuffered;
+	std::vector<BufferedBool> expectedFlags;
+	std::vector<FilteredNumber<float, 4, 1> > expectedFiltered;
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		expectedBuffered.push_back(BufferedNumber<float>(0.0f, -10.0f, 10.0f, 0.1f * (i % 7 + 1)));
+		expectedFlags.push_back(BufferedBool(0.3f, 0.6f, 0.05f * (i % 5 + 1)));
+		expectedFiltered.push_back(FilteredNumber<float, 4, 1>((float) i, weights));
+
+		CHECK_EQUAL(i, buffered.add(expectedBuffered[i]));
+		CHECK_EQUAL(i, scheduler.add(expectedFlags[i]));
+		CHECK_EQUAL(i, filtered.add(expectedFiltered[i]));
+	}
+
+	CHECK_EQUAL(3u, scheduler.getArenaCount());
+	CHECK_EQUAL(3u * count, scheduler.getCount());
+
+	for(int tick = 0; tick < 10; tick++)
+	{
+		float elapsedTime = 0.5f + (tick % 3) * 0.25f;
+
+		for(unsigned int i = 0; i < count; i++)
+		{
+			float value = (float) ((i * 7 + tick * 3) % 11) - 5.0f;
+			bool flag = (i + tick / 3) % 2 == 0;
+
+			buffered.setInput(i, value);
+			flags.setInput(i, flag);
+			filtered.setInput(i, value);
+
+			expectedBuffered[i].setValue(value, elapsedTime);
+			expectedFlags[i].setValue(flag, elapsedTime);
+			expectedFiltered[i].setValue(value, elapsedTime);
+		}
+
+		scheduler.tick(elapsedTime);
+
+		for(unsigned int i = 0; i < count; i++)
+		{
+			CHECK_EQUAL(expectedBuffered[i].getValue(), buffered.getValue(i));
+			CHECK_EQUAL(expectedFlags[i].getValue(), flags.getValue(i));
+			CHECK_EQUAL(expectedFiltered[i].getValue(), filtered.getValue(i));
+			CHECK_EQUAL(expectedFiltered[i].getValue(1), filtered.getNumber(i).getValue(1));
+		}
+	}
+}
+
+SUITE(TestUpdateScheduler)
+{
+	TEST(TestOneThread)
+	{
+		UpdateScheduler scheduler(1);
+
+		CHECK_EQUAL(1u, scheduler.getThreadCount());
+		checkSameAsSequential(TEST_HELPER_ARGUMENTS, 1, 16, 100);
+	}
+
+	TEST(TestSeveralThreads)
+	{
+		checkSameAsSequential(TEST_HELPER_ARGUMENTS, 4, 16, 1000);
+		checkSameAsSequential(TEST_HELPER_ARGUMENTS, 3, 7, 50);
+	}
+
+	TEST(TestMoreThreadsThanTasks)
+	{
+		checkSameAsSequential(TEST_HELPER_ARGUMENTS, 8, 1024, 10);
+	}
+
+	TEST(TestDefaultThreadCount)
+	{
+		UpdateScheduler scheduler;
+
+		CHECK(scheduler.getThreadCount() >= 1);
+	}
+
+	TEST(TestEmptyTick)
+	{
+		UpdateScheduler scheduler(4);
+
+		scheduler.tick();
+		scheduler.tick();
+
+		CHECK_EQUAL(0u, scheduler.getArenaCount());
+		CHECK_EQUAL(0u, scheduler.getCount());
+	}
+
+	TEST(TestInputIsInitialValue)
+	{
+		UpdateScheduler scheduler(2);
+		UpdateArena<BufferedNumber<float> >& arena = scheduler.getArena<BufferedNumber<float> >();
+
+		arena.add(BufferedNumber<float>(0.5f, -1.0f, 1.0f, 0.1f));
+
+		CHECK_EQUAL(0.5f, arena.getInput(0));
+
+		scheduler.tick();
+		CHECK_CLOSE(0.5f, arena.getValue(0), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestSameArenaForSameType)
+	{
+		UpdateScheduler scheduler(1);
+
+		CHECK_EQUAL(&scheduler.getArena<BufferedBool>(), &scheduler.getArena<BufferedBool>());
+		CHECK_EQUAL(1u, scheduler.getArenaCount());
+	}
+
+	TEST(TestAddBetweenTicks)
+	{
+		UpdateScheduler scheduler(3, 2);
+		UpdateArena<BufferedNumber<float> >& arena = scheduler.getArena<BufferedNumber<float> >();
+
+		arena.add(BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.25f));
+		arena.setInput(0, 1.0f);
+		scheduler.tick();
+
+		for(int i = 0; i < 9; i++)
+		{
+			arena.add(BufferedNumber<float>(0.0f, -1.0f, 1.0f, 0.25f));
+			arena.setInput(i + 1, 1.0f);
+		}
+
+		scheduler.tick();
+
+		CHECK_CLOSE(0.5f, arena.getValue(0), FLOAT_THRESHOLD);
+
+		for(unsigned int i = 1; i < 10; i++)
+		{
+			CHECK_CLOSE(0.25f, arena.getValue(i), FLOAT_THRESHOLD);
+		}
+	}
+}
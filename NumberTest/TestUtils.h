@@ -4,7 +4,7 @@
 
 #include "NumberTest.h"
 
-#include "Utils.h"
+#include "utils.h"
 
 using namespace luma::numbers;
 
@@ -50,6 +50,66 @@ SUITE(TestUtils)
 		CHECK_CLOSE(1.0f, mod(4.0f, 1.0f, 4.0f), FLOAT_THRESHOLD);
 	}
 
+	TEST(TestModLargeRange)
+	{
+		long long big = 10000000000LL; //does not fit in an int
+
+		CHECK(mod(3 * big + 5, 0LL, big) == 5);
+		CHECK(mod(-big - 5, 0LL, big) == big - 5);
+		CHECK_CLOSE(2.5, mod(3e12 + 2.5, 0.0, 1e12), 0.001);
+		CHECK_CLOSE(-0.5, mod(-3e12 - 0.5, -1.0, 1e12 - 1.0), 0.001);
+	}
+
+	TEST(TestModFarOutside)
+	{
+		//several ranges away, where mod divides instead of wrapping
+		CHECK_EQUAL(2, mod(-7, 1, 4));
+		CHECK_EQUAL(2, mod(23, 1, 4));
+
+		CHECK_CLOSE(1.5f, mod(10.5f, 0.0f, 3.0f), FLOAT_THRESHOLD);
+		CHECK_CLOSE(1.75f, mod(-7.25f, 0.0f, 3.0f), FLOAT_THRESHOLD);
+
+		CHECK_CLOSE(1.5, mod(10.5, 0.0, 3.0), FLOAT_THRESHOLD);
+		CHECK_CLOSE(1.75, mod(-7.25, 0.0, 3.0), FLOAT_THRESHOLD);
+
+		CHECK_CLOSE(1.5L, mod(10.5L, 0.0L, 3.0L), FLOAT_THRESHOLD);
+		CHECK_CLOSE(1.75L, mod(-7.25L, 0.0L, 3.0L), FLOAT_THRESHOLD);
+		CHECK_CLOSE(3.5L, mod(-14.5L, 1.0L, 4.0L), FLOAT_THRESHOLD);
+		CHECK_CLOSE(4.1L, reflect(11.1L, 1.0L, 4.5L), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestWrap)
+	{
+		CHECK_EQUAL(1, wrap(-2, 1, 4));
+		CHECK_EQUAL(3, wrap(0, 1, 4));
+		CHECK_EQUAL(1, wrap(1, 1, 4));
+		CHECK_EQUAL(3, wrap(3, 1, 4));
+		CHECK_EQUAL(1, wrap(4, 1, 4));
+		CHECK_EQUAL(3, wrap(6, 1, 4));
+
+		CHECK_CLOSE(1.5f, wrap(-1.5f, 1.0f, 4.0f), FLOAT_THRESHOLD);
+		CHECK_CLOSE(3.25f, wrap(0.25f, 1.0f, 4.0f), FLOAT_THRESHOLD);
+		CHECK_CLOSE(2.5f, wrap(2.5f, 1.0f, 4.0f), FLOAT_THRESHOLD);
+		CHECK_CLOSE(2.5f, wrap(5.5f, 1.0f, 4.0f), FLOAT_THRESHOLD);
+		CHECK_CLOSE(3.9f, wrap(6.9f, 1.0f, 4.0f), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestWrapIndex)
+	{
+		for(int i = -8; i < 16; i++)
+		{
+			CHECK_EQUAL(mod(i, 0, 8), wrapIndex<8>(i));
+		}
+
+		for(int i = -5; i < 10; i++)
+		{
+			CHECK_EQUAL(mod(i, 0, 5), wrapIndex<5>(i));
+		}
+
+		CHECK_EQUAL(0, wrapIndex<1>(0));
+		CHECK_EQUAL(0, wrapIndex<1>(1));
+	}
+
 
 	TEST(TestReflectInt)
 	{
@@ -0,0 +1,140 @@
+#include <vector>
+#include <algorithm>
+
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "WindowMedianNumber.h"
+
+using namespace luma::numbers;
+
+/**
+	Feeds pseudo-random values with repeats to a WindowMedianNumber,
+	and checks the median against a sorted copy of the last
+	sampleCount values.
+*/
+template <unsigned int sampleCount>
+void checkSameAsSort(TEST_HELPER_PARAMETERS, float initialValue)
+{
+	WindowMedianNumber<float, sampleCount> n(initialValue);
+	std::vector<float> values(sampleCount, initialValue);
+	unsigned int random = 54321;
+
+	for(int step = 0; step < 500; step++)
+	{
+		random = random * 1103515245u + 12345u;
+
+		float value = step % 50 < 20 ? (float) (step % 50) : (float) ((random >> 16) % 9);
+
+		n.setValue(value);
+		values.push_back(value);
+
+		std::vector<float> window(values.end() - sampleCount, values.end());
+		std::sort(window.begin(), window.end());
+
+		float median = sampleCount % 2 ? window[sampleCount / 2] : (window[sampleCount / 2 - 1] + window[sampleCount / 2]) / 2;
+
+		CHECK_EQUAL(value, n.getValue(0));
+		CHECK_EQUAL(median, n.getValue(1));
+		CHECK_EQUAL(median, n.getMedian());
+	}
+}
+
+SUITE(TestWindowMedianNumber)
+{
+	TEST(TestInitialValue)
+	{
+		WindowMedianNumber<float, 5> n(1.0f);
+
+		CHECK_EQUAL(1.0f, n.getValue());
+
+		n.setValue(9.0f);
+		n.setValue(9.0f);
+		CHECK_EQUAL(1.0f, n.getValue());
+
+		n.setValue(9.0f);
+		CHECK_EQUAL(9.0f, n.getValue());
+		CHECK_EQUAL(1.0f, n.getValue(2));
+	}
+
+	TEST(TestIgnoresSpikes)
+	{
+		WindowMedianNumber<float, 5> n(1.0f);
+
+		for(int i = 0; i < 10; i++)
+		{
+			n.setValue(i == 6 ? 1000.0f : 1.0f);
+			CHECK_EQUAL(1.0f, n.getValue());
+		}
+	}
+
+	TEST(TestSameAsSort)
+	{
+		checkSameAsSort<1>(TEST_HELPER_ARGUMENTS, 0.0f);
+		checkSameAsSort<2>(TEST_HELPER_ARGUMENTS, 4.0f);
+		checkSameAsSort<3>(TEST_HELPER_ARGUMENTS, 0.0f);
+		checkSameAsSort<4>(TEST_HELPER_ARGUMENTS, 2.0f);
+		checkSameAsSort<8>(TEST_HELPER_ARGUMENTS, -1.0f);
+		checkSameAsSort<15>(TEST_HELPER_ARGUMENTS, 3.0f);
+		checkSameAsSort<64>(TEST_HELPER_ARGUMENTS, 0.0f);
+	}
+
+	TEST(TestForceValue)
+	{
+		WindowMedianNumber<float, 3> n(0.0f);
+
+		n.setValue(5.0f);
+		n.setValue(6.0f);
+		n.forceValue(2.0f);
+
+		CHECK_EQUAL(2.0f, n.getValue(0));
+		CHECK_EQUAL(2.0f, n.getValue(1));
+
+		n.setValue(8.0f);
+		CHECK_EQUAL(2.0f, n.getValue());
+
+		n.setValue(8.0f);
+		CHECK_EQUAL(8.0f, n.getValue());
+	}
+
+	TEST(TestProcess)
+	{
+		WindowMedianNumber<float, 4> expected(0.0f);
+		WindowMedianNumber<float, 4> actual(0.0f);
+		float values[] = {3, 1, 4, 1, 5, 9, 2, 6};
+		float outputs[8];
+
+		actual.process(values, 0, outputs, 8);
+
+		for(int i = 0; i < 8; i++)
+		{
+			expected.setValue(values[i]);
+			CHECK_EQUAL(expected.getValue(), outputs[i]);
+		}
+	}
+
+	TEST(TestSnapshot)
+	{
+		WindowMedianNumber<float, 7> n(0.0f);
+		WindowMedianNumber<float, 7> restored(3.0f);
+		std::vector<unsigned char> snapshot;
+
+		for(int i = 0; i < 10; i++)
+		{
+			n.setValue((float) ((i * 5) % 7));
+		}
+
+		SnapshotWriter writer(snapshot);
+		n.serialize(writer);
+
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+		CHECK(restored.deserialize(reader));
+
+		for(int i = 0; i < 10; i++)
+		{
+			n.setValue((float) (i % 4));
+			restored.setValue((float) (i % 4));
+
+			CHECK_EQUAL(n.getValue(), restored.getValue());
+		}
+	}
+}
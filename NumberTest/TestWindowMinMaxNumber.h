@@ -0,0 +1,159 @@
+#include <vector>
+
+#include "UnitTest++.h"
+#include "NumberTest.h"
+#include "WindowMinMaxNumber.h"
+
+using namespace luma::numbers;
+
+/**
+	Feeds pseudo-random values, and runs of rising and falling
+	values, to a WindowMinMaxNumber, and checks the minimum and
+	maximum against a scan of the last sampleCount values.
+*/
+template <unsigned int sampleCount>
+void checkSameAsScan(TEST_HELPER_PARAMETERS, int initialValue)
+{
+	WindowMinMaxNumber<int, sampleCount> n(initialValue);
+	std::vector<int> values(sampleCount, initialValue);
+	unsigned int random = 12345;
+
+	for(int step = 0; step < 500; step++)
+	{
+		random = random * 1103515245u + 12345u;
+
+		int value;
+
+		if(step % 100 < 30)
+		{
+			value = step % 100; //rising
+		}
+		else if(step % 100 < 60)
+		{
+			value = -(step % 100); //falling
+		}
+		else
+		{
+			value = (int) ((random >> 16) % 21) - 10;
+		}
+
+		n.setValue(value);
+		values.push_back(value);
+
+		int minimum = value;
+		int maximum = value;
+
+		for(size_t i = values.size() - sampleCount; i < values.size(); i++)
+		{
+			minimum = min(minimum, values[i]);
+			maximum = max(maximum, values[i]);
+		}
+
+		CHECK_EQUAL(value, n.getValue());
+		CHECK_EQUAL(minimum, n.getMinimum());
+		CHECK_EQUAL(maximum, n.getMaximum());
+	}
+}
+
+SUITE(TestWindowMinMaxNumber)
+{
+	TEST(TestInitialValue)
+	{
+		WindowMinMaxNumber<float, 4> n(2.0f);
+
+		CHECK_EQUAL(2.0f, n.getMinimum());
+		CHECK_EQUAL(2.0f, n.getMaximum());
+
+		//the initial value stays in the window for three more samples
+		for(int i = 0; i < 3; i++)
+		{
+			n.setValue(5.0f);
+			CHECK_EQUAL(2.0f, n.getMinimum());
+			CHECK_EQUAL(5.0f, n.getMaximum());
+		}
+
+		n.setValue(5.0f);
+		CHECK_EQUAL(5.0f, n.getMinimum());
+	}
+
+	TEST(TestSameAsScan)
+	{
+		checkSameAsScan<1>(TEST_HELPER_ARGUMENTS, 0);
+		checkSameAsScan<2>(TEST_HELPER_ARGUMENTS, 3);
+		checkSameAsScan<5>(TEST_HELPER_ARGUMENTS, -20);
+		checkSameAsScan<16>(TEST_HELPER_ARGUMENTS, 0);
+		checkSameAsScan<37>(TEST_HELPER_ARGUMENTS, 100);
+	}
+
+	TEST(TestForceValue)
+	{
+		WindowMinMaxNumber<float, 3> n(0.0f);
+
+		n.setValue(-4.0f);
+		n.setValue(4.0f);
+		n.forceValue(1.0f);
+
+		CHECK_EQUAL(1.0f, n.getValue());
+		CHECK_EQUAL(1.0f, n.getMinimum());
+		CHECK_EQUAL(1.0f, n.getMaximum());
+
+		n.setValue(2.0f);
+		n.setValue(2.0f);
+		CHECK_EQUAL(1.0f, n.getMinimum());
+
+		n.setValue(2.0f);
+		CHECK_EQUAL(2.0f, n.getMinimum());
+	}
+
+	TEST(TestProcess)
+	{
+		WindowMinMaxNumber<float, 3> expected(0.0f);
+		WindowMinMaxNumber<float, 3> actual(0.0f);
+		float values[] = {1, -2, 5, 3, 3, -1, 0, 4};
+		float minima[8];
+		float maxima[8];
+
+		actual.process(values, 0, minima, maxima, 8);
+
+		for(int i = 0; i < 8; i++)
+		{
+			expected.setValue(values[i]);
+			CHECK_EQUAL(expected.getMinimum(), minima[i]);
+			CHECK_EQUAL(expected.getMaximum(), maxima[i]);
+		}
+
+		actual.process(values, 0, 0, maxima, 8);
+		CHECK_EQUAL(4.0f, maxima[7]);
+	}
+
+	TEST(TestSnapshot)
+	{
+		WindowMinMaxNumber<int, 5> n(0);
+		WindowMinMaxNumber<int, 5> restored(7);
+		WindowMinMaxNumber<int, 6> otherSampleCount(7);
+		std::vector<unsigned char> snapshot;
+
+		for(int i = 0; i < 8; i++)
+		{
+			n.setValue((i * 5) % 7);
+		}
+
+		SnapshotWriter writer(snapshot);
+		n.serialize(writer);
+
+		SnapshotReader reader(&snapshot[0], snapshot.size());
+		CHECK(restored.deserialize(reader));
+
+		SnapshotReader otherReader(&snapshot[0], snapshot.size());
+		CHECK(!otherSampleCount.deserialize(otherReader));
+
+		for(int i = 0; i < 10; i++)
+		{
+			n.setValue(i % 4);
+			restored.setValue(i % 4);
+
+			CHECK_EQUAL(n.getMinimum(), restored.getMinimum());
+			CHECK_EQUAL(n.getMaximum(), restored.getMaximum());
+		}
+	}
+}
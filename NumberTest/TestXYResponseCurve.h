@@ -34,5 +34,88 @@ SUITE(TestXYResponseCurve)
 		CHECK_CLOSE(1.5f, f(2.0f), FLOAT_THRESHOLD);
 	}
 
+	TEST(TestBucketsSameAsBinarySearch)
+	{
+		const unsigned int n = 512;
+		float input[n];
+		float output[n];
+
+		//clustered around 0
+		for(unsigned int i = 0; i < n; i++)
+		{
+			float x = (float) i / (n - 1);
+			input[i] = 2.0f * x * x * x - 1.0f;
+			output[i] = x;
+		}
+
+		XYResponseCurve<float, n> f(input, output);
+		XYResponseCurve<float, n, 0> g(input, output);
+		XYResponseCurve<float, n, 7> h(input, output);
+
+		for(unsigned int i = 0; i < n; i++)
+		{
+			CHECK_EQUAL(g.findInputIndex(input[i]), f.findInputIndex(input[i]));
+			CHECK_EQUAL(g.findInputIndex(input[i]), h.findInputIndex(input[i]));
+		}
+
+		for(int i = 0; i < 1000; i++)
+		{
+			float value = (rand() % 2400) / 1000.0f - 1.2f;
+
+			CHECK_EQUAL(g.findInputIndex(value), f.findInputIndex(value));
+			CHECK_EQUAL(g.findInputIndex(value), h.findInputIndex(value));
+			CHECK_EQUAL(g(value), f(value));
+		}
+	}
+
+	TEST(TestBucketsAfterInverse)
+	{
+		float input[] = {0.0f, 1.0f, 3.0f, 3.5f};
+		float output[] = {0.0f, 10.0f, 11.0f, 20.0f};
+
+		XYResponseCurve<float, 4> f(input, output);
+
+		f.makeInverse();
+
+		CHECK_EQUAL(0u, f.findInputIndex(5.0f));
+		CHECK_EQUAL(1u, f.findInputIndex(10.0f));
+		CHECK_EQUAL(1u, f.findInputIndex(10.5f));
+		CHECK_EQUAL(2u, f.findInputIndex(15.0f));
+		CHECK_EQUAL(3u, f.findInputIndex(20.0f));
+		CHECK_CLOSE(2.0f, f(10.5f), FLOAT_THRESHOLD);
+	}
+
+	TEST(TestIntegers)
+	{
+		int input[] = {0, 3, 10, 12};
+		int output[] = {0, 30, 100, 200};
+
+		//a range of 12 over 4 buckets: the scale must not be truncated to 0
+		XYResponseCurve<int, 4> f(input, output);
+		XYResponseCurve<int, 4, 0> g(input, output);
+
+		for(int i = -1; i <= 13; i++)
+		{
+			CHECK_EQUAL(g.findInputIndex(i), f.findInputIndex(i));
+		}
+
+		CHECK_EQUAL(2u, f.findInputIndex(11));
+		CHECK_EQUAL(10, f(1));
+		CHECK_EQUAL(50, f(5));
+		CHECK_EQUAL(150, f(11));
+	}
+
+	TEST(TestSingleSample)
+	{
+		int input[] = {2};
+		int output[] = {5};
+
+		//the input range is 0
+		XYResponseCurve<int, 1> f(input, output);
+
+		CHECK_EQUAL(0u, f.findInputIndex(2));
+		CHECK_EQUAL(5, f(1));
+		CHECK_EQUAL(5, f(3));
+	}
 	
 }
\ No newline at end of file